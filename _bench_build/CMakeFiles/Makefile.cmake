@@ -0,0 +1,89 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/.git/HEAD"
+  "/root/repo/.git/refs/heads/master"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "CMakeFiles/git-data/grabRef.cmake"
+  "/root/repo/benchmarks/CMakeLists.txt"
+  "/root/repo/cliloader/CMakeLists.txt"
+  "/root/repo/cliloader/git_version.h.in"
+  "/root/repo/clitrace/CMakeLists.txt"
+  "/root/repo/cmake_modules/GetGitRevisionDescription.cmake"
+  "/root/repo/cmake_modules/GetGitRevisionDescription.cmake.in"
+  "/root/repo/cmake_modules/package.cmake"
+  "/root/repo/intercept/CMakeLists.txt"
+  "/root/repo/intercept/src/git_version.cpp.in"
+  "/root/repo/intercept/src/git_version.rc.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CPack.cmake"
+  "/usr/share/cmake-3.25/Modules/CPackComponent.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGit.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Templates/CPackConfig.cmake.in"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/git-data/HEAD"
+  "CMakeFiles/git-data/grabRef.cmake"
+  "CMakeFiles/git-data/head-ref"
+  "CMakeFiles/git-data/HEAD"
+  "CMakeFiles/git-data/grabRef.cmake"
+  "CMakeFiles/git-data/head-ref"
+  "CPackConfig.cmake"
+  "CPackSourceConfig.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "intercept/git_version.cpp"
+  "intercept/git_version.rc2"
+  "intercept/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "clitrace/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "cliloader/git_version.h"
+  "cliloader/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmarks/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "intercept/CMakeFiles/OpenCL.dir/DependInfo.cmake"
+  "clitrace/CMakeFiles/clitrace.dir/DependInfo.cmake"
+  "cliloader/CMakeFiles/cliloader.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/pointermap_bench.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/stub_opencl.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/overhead_bench.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/scalability_bench.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/overhead_bench.dir/overhead_bench.cpp.o"
+  "CMakeFiles/overhead_bench.dir/overhead_bench.cpp.o.d"
+  "overhead_bench"
+  "overhead_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/overhead_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
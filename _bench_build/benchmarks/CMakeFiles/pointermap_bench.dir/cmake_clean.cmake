@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pointermap_bench.dir/pointermap_bench.cpp.o"
+  "CMakeFiles/pointermap_bench.dir/pointermap_bench.cpp.o.d"
+  "pointermap_bench"
+  "pointermap_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pointermap_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/stub_opencl.dir/stub_opencl.cpp.o"
+  "CMakeFiles/stub_opencl.dir/stub_opencl.cpp.o.d"
+  "libstub_opencl.pdb"
+  "libstub_opencl.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/stub_opencl.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cliloader.dir/cliloader.cpp.o"
+  "CMakeFiles/cliloader.dir/cliloader.cpp.o.d"
+  "cliloader"
+  "cliloader.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cliloader.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+/*
+// Copyright (c) 2018-2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+static const char* g_scGitDescribe = "-128-NOTFOUND";
+static const char* g_scGitRefSpec = "refs/heads/master";
+static const char* g_scGitHash = "0a96a4c5d1a209657f79134d318081d223e0843f";
+
+static const char* g_scURL = "https://github.com/intel/opencl-intercept-layer";
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/intercept/src/chrometracer.cpp" "clitrace/CMakeFiles/clitrace.dir/__/intercept/src/chrometracer.cpp.o" "gcc" "clitrace/CMakeFiles/clitrace.dir/__/intercept/src/chrometracer.cpp.o.d"
+  "/root/repo/intercept/src/perfettowriter.cpp" "clitrace/CMakeFiles/clitrace.dir/__/intercept/src/perfettowriter.cpp.o" "gcc" "clitrace/CMakeFiles/clitrace.dir/__/intercept/src/perfettowriter.cpp.o.d"
+  "/root/repo/intercept/src/stringinterner.cpp" "clitrace/CMakeFiles/clitrace.dir/__/intercept/src/stringinterner.cpp.o" "gcc" "clitrace/CMakeFiles/clitrace.dir/__/intercept/src/stringinterner.cpp.o.d"
+  "/root/repo/clitrace/clitrace.cpp" "clitrace/CMakeFiles/clitrace.dir/clitrace.cpp.o" "gcc" "clitrace/CMakeFiles/clitrace.dir/clitrace.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/clitrace.dir/__/intercept/src/chrometracer.cpp.o"
+  "CMakeFiles/clitrace.dir/__/intercept/src/chrometracer.cpp.o.d"
+  "CMakeFiles/clitrace.dir/__/intercept/src/perfettowriter.cpp.o"
+  "CMakeFiles/clitrace.dir/__/intercept/src/perfettowriter.cpp.o.d"
+  "CMakeFiles/clitrace.dir/__/intercept/src/stringinterner.cpp.o"
+  "CMakeFiles/clitrace.dir/__/intercept/src/stringinterner.cpp.o.d"
+  "CMakeFiles/clitrace.dir/clitrace.cpp.o"
+  "CMakeFiles/clitrace.dir/clitrace.cpp.o.d"
+  "clitrace"
+  "clitrace.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/clitrace.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,44 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/intercept/OS/OS_linux.cpp" "intercept/CMakeFiles/OpenCL.dir/OS/OS_linux.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/OS/OS_linux.cpp.o.d"
+  "/root/repo/_bench_build/intercept/git_version.cpp" "intercept/CMakeFiles/OpenCL.dir/git_version.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/git_version.cpp.o.d"
+  "/root/repo/intercept/mdapi/MetricsDiscoveryHelper.cpp" "intercept/CMakeFiles/OpenCL.dir/mdapi/MetricsDiscoveryHelper.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/mdapi/MetricsDiscoveryHelper.cpp.o.d"
+  "/root/repo/intercept/mdapi/intercept_mdapi.cpp" "intercept/CMakeFiles/OpenCL.dir/mdapi/intercept_mdapi.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/mdapi/intercept_mdapi.cpp.o.d"
+  "/root/repo/intercept/src/chrometracer.cpp" "intercept/CMakeFiles/OpenCL.dir/src/chrometracer.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/chrometracer.cpp.o.d"
+  "/root/repo/intercept/src/cliprof_init.cpp" "intercept/CMakeFiles/OpenCL.dir/src/cliprof_init.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/cliprof_init.cpp.o.d"
+  "/root/repo/intercept/src/clockmodel.cpp" "intercept/CMakeFiles/OpenCL.dir/src/clockmodel.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/clockmodel.cpp.o.d"
+  "/root/repo/intercept/src/criticalpath.cpp" "intercept/CMakeFiles/OpenCL.dir/src/criticalpath.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/criticalpath.cpp.o.d"
+  "/root/repo/intercept/src/dispatch.cpp" "intercept/CMakeFiles/OpenCL.dir/src/dispatch.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/dispatch.cpp.o.d"
+  "/root/repo/intercept/src/emulate.cpp" "intercept/CMakeFiles/OpenCL.dir/src/emulate.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/emulate.cpp.o.d"
+  "/root/repo/intercept/src/enummap.cpp" "intercept/CMakeFiles/OpenCL.dir/src/enummap.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/enummap.cpp.o.d"
+  "/root/repo/intercept/src/intercept.cpp" "intercept/CMakeFiles/OpenCL.dir/src/intercept.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/intercept.cpp.o.d"
+  "/root/repo/intercept/src/main.cpp" "intercept/CMakeFiles/OpenCL.dir/src/main.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/main.cpp.o.d"
+  "/root/repo/intercept/src/objtracker.cpp" "intercept/CMakeFiles/OpenCL.dir/src/objtracker.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/objtracker.cpp.o.d"
+  "/root/repo/intercept/src/occupancy.cpp" "intercept/CMakeFiles/OpenCL.dir/src/occupancy.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/occupancy.cpp.o.d"
+  "/root/repo/intercept/src/perfettowriter.cpp" "intercept/CMakeFiles/OpenCL.dir/src/perfettowriter.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/perfettowriter.cpp.o.d"
+  "/root/repo/intercept/src/selfoverhead.cpp" "intercept/CMakeFiles/OpenCL.dir/src/selfoverhead.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/selfoverhead.cpp.o.d"
+  "/root/repo/intercept/src/stringinterner.cpp" "intercept/CMakeFiles/OpenCL.dir/src/stringinterner.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/stringinterner.cpp.o.d"
+  "/root/repo/intercept/src/utils.cpp" "intercept/CMakeFiles/OpenCL.dir/src/utils.cpp.o" "gcc" "intercept/CMakeFiles/OpenCL.dir/src/utils.cpp.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_bench_build/intercept/libOpenCL.so" "/root/repo/_bench_build/intercept/libOpenCL.so.1.2"
+  "/root/repo/_bench_build/intercept/libOpenCL.so.1" "/root/repo/_bench_build/intercept/libOpenCL.so.1.2"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,52 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/OpenCL.dir/OS/OS_linux.cpp.o"
+  "CMakeFiles/OpenCL.dir/OS/OS_linux.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/git_version.cpp.o"
+  "CMakeFiles/OpenCL.dir/git_version.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/mdapi/MetricsDiscoveryHelper.cpp.o"
+  "CMakeFiles/OpenCL.dir/mdapi/MetricsDiscoveryHelper.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/mdapi/intercept_mdapi.cpp.o"
+  "CMakeFiles/OpenCL.dir/mdapi/intercept_mdapi.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/chrometracer.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/chrometracer.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/cliprof_init.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/cliprof_init.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/clockmodel.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/clockmodel.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/criticalpath.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/criticalpath.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/dispatch.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/dispatch.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/emulate.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/emulate.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/enummap.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/enummap.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/intercept.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/intercept.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/main.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/main.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/objtracker.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/objtracker.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/occupancy.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/occupancy.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/perfettowriter.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/perfettowriter.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/selfoverhead.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/selfoverhead.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/stringinterner.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/stringinterner.cpp.o.d"
+  "CMakeFiles/OpenCL.dir/src/utils.cpp.o"
+  "CMakeFiles/OpenCL.dir/src/utils.cpp.o.d"
+  "CMakeFiles/kernels/builtin_kernels.o"
+  "CMakeFiles/kernels/precompiled_kernels.o"
+  "CMakeFiles/scripts/run_py.o"
+  "libOpenCL.pdb"
+  "libOpenCL.so"
+  "libOpenCL.so.1"
+  "libOpenCL.so.1.2"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/OpenCL.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
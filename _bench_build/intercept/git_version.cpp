@@ -0,0 +1,11 @@
+/*
+// Copyright (c) 2018-2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#include "intercept.h"
+
+const char* CLIntercept::sc_GitDescribe = "-128-NOTFOUND";
+const char* CLIntercept::sc_GitRefSpec = "refs/heads/master";
+const char* CLIntercept::sc_GitHash = "0a96a4c5d1a209657f79134d318081d223e0843f";
@@ -0,0 +1,204 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+// These are the utilities shared by the benchmarks that load the Intercept
+// Layer and point it at the stub OpenCL implementation.  Each control
+// configuration runs in a separate child process, since the Intercept Layer
+// reads its controls once, when it is loaded.  The "Stub" configuration
+// calls the stub OpenCL implementation directly and shows the cost of the
+// calls without the Intercept Layer.
+//
+// The Intercept Layer log, reports, and traces are written to CLI_DumpDir,
+// which is set to a new temporary directory unless it is already set.
+
+#define CL_USE_DEPRECATED_OPENCL_1_2_APIS
+#define CL_TARGET_OPENCL_VERSION 300
+
+#include "CL/cl.h"
+
+#include <functional>
+
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define BENCH_API_LIST( X )          \
+    X( clGetPlatformIDs )            \
+    X( clGetDeviceIDs )              \
+    X( clCreateContext )             \
+    X( clReleaseContext )            \
+    X( clCreateCommandQueue )        \
+    X( clReleaseCommandQueue )       \
+    X( clCreateBuffer )              \
+    X( clReleaseMemObject )          \
+    X( clCreateProgramWithSource )   \
+    X( clBuildProgram )              \
+    X( clReleaseProgram )            \
+    X( clCreateKernel )              \
+    X( clReleaseKernel )             \
+    X( clSetKernelArg )              \
+    X( clEnqueueNDRangeKernel )      \
+    X( clEnqueueReadBuffer )         \
+    X( clEnqueueWriteBuffer )        \
+    X( clEnqueueMarkerWithWaitList ) \
+    X( clGetEventProfilingInfo )     \
+    X( clWaitForEvents )             \
+    X( clReleaseEvent )              \
+    X( clFlush )                     \
+    X( clFinish )
+
+struct SDispatch
+{
+#define BENCH_API_POINTER( _name )  decltype(&::_name) _name;
+    BENCH_API_LIST( BENCH_API_POINTER )
+#undef BENCH_API_POINTER
+
+    // Returns the number of calls into the stub OpenCL implementation,
+    // including calls made by the Intercept Layer.
+    uint64_t (*stubGetCallCount)();
+};
+
+struct SConfiguration
+{
+    const char* Name;
+    bool        UseIntercept;
+    const char* Controls[4];
+};
+
+static const SConfiguration cConfigurations[] =
+{
+    { "Stub",                       false,  { NULL } },
+    { "Default",                    true,   { NULL } },
+    { "CallLogging",                true,   { "CLI_CallLogging", NULL } },
+    { "HostPerformanceTiming",      true,   { "CLI_HostPerformanceTiming", NULL } },
+    { "DevicePerformanceTiming",    true,   { "CLI_DevicePerformanceTiming", NULL } },
+    { "ChromeCallLogging",          true,   { "CLI_ChromeCallLogging", NULL } },
+    { "ChromePerformanceTiming",    true,   { "CLI_ChromePerformanceTiming", NULL } },
+};
+
+typedef std::function< int( const SConfiguration&, const SDispatch& ) >
+    CRunFunction;
+
+static bool loadDispatch( const char* libName, SDispatch& dispatch )
+{
+    void*   lib = dlopen( libName, RTLD_NOW | RTLD_LOCAL );
+    if( lib == NULL )
+    {
+        fprintf( stderr, "Couldn't load %s: %s\n", libName, dlerror() );
+        return false;
+    }
+
+#define BENCH_API_LOAD( _name )                                             \
+    dispatch._name = (decltype(&::_name))dlsym( lib, #_name );              \
+    if( dispatch._name == NULL )                                            \
+    {                                                                       \
+        fprintf( stderr, "Couldn't get function pointer to %s\n", #_name ); \
+        return false;                                                       \
+    }
+    BENCH_API_LIST( BENCH_API_LOAD )
+#undef BENCH_API_LOAD
+
+    // The Intercept Layer loads the stub OpenCL implementation from the same
+    // path, so this returns the same instance of the stub.
+    void*   stub = dlopen( CLI_BENCH_STUB_LIB, RTLD_NOW | RTLD_LOCAL );
+    dispatch.stubGetCallCount = stub ?
+        (uint64_t (*)())dlsym( stub, "stubGetCallCount" ) :
+        NULL;
+    if( dispatch.stubGetCallCount == NULL )
+    {
+        fprintf( stderr, "Couldn't get function pointer to stubGetCallCount\n" );
+        return false;
+    }
+
+    return true;
+}
+
+// Runs the given function for each configuration, or only for the named
+// configuration if configName is not NULL.  Returns zero if all
+// configurations ran successfully.
+static int runConfigurations(
+    const char* configName,
+    const CRunFunction& run )
+{
+    // The controls that apply to every configuration.
+    setenv( "CLI_OpenCLFileName", CLI_BENCH_STUB_LIB, 1 );
+    setenv( "CLI_LogToFile", "1", 1 );
+    if( getenv( "CLI_DumpDir" ) == NULL )
+    {
+        char    dumpDir[] = "/tmp/cli_bench_XXXXXX";
+        if( mkdtemp( dumpDir ) == NULL )
+        {
+            fprintf( stderr, "Couldn't create a temporary directory!\n" );
+            return -1;
+        }
+        setenv( "CLI_DumpDir", dumpDir, 1 );
+    }
+    printf( "Writing output files to %s\n\n", getenv( "CLI_DumpDir" ) );
+
+    int     result = 0;
+    bool    found = false;
+    for( const auto& config : cConfigurations )
+    {
+        if( configName && strcmp( configName, config.Name ) != 0 )
+        {
+            continue;
+        }
+        found = true;
+
+        fflush( stdout );
+        pid_t   pid = fork();
+        if( pid == 0 )
+        {
+            for( size_t c = 0; config.Controls[c]; c++ )
+            {
+                setenv( config.Controls[c], "1", 1 );
+            }
+
+            SDispatch   dispatch;
+            int childResult = -1;
+            if( loadDispatch(
+                    config.UseIntercept ? CLI_BENCH_INTERCEPT_LIB : CLI_BENCH_STUB_LIB,
+                    dispatch ) )
+            {
+                childResult = run( config, dispatch );
+            }
+            fflush( stdout );
+
+            // Use exit() rather than _exit(), so the Intercept Layer is
+            // unloaded normally and writes its reports and traces.
+            exit( childResult == 0 ? 0 : 1 );
+        }
+
+        int status = 0;
+        if( pid < 0 ||
+            waitpid( pid, &status, 0 ) != pid ||
+            !WIFEXITED( status ) ||
+            WEXITSTATUS( status ) != 0 )
+        {
+            fprintf( stderr, "Configuration %s failed!\n", config.Name );
+            result = -1;
+        }
+        printf( "\n" );
+    }
+
+    if( !found )
+    {
+        fprintf( stderr, "Unknown configuration: %s\n", configName );
+        fprintf( stderr, "Valid configurations are:\n" );
+        for( const auto& config : cConfigurations )
+        {
+            fprintf( stderr, "    %s\n", config.Name );
+        }
+        result = -1;
+    }
+
+    return result;
+}
@@ -0,0 +1,239 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+// This microbenchmark measures the per-call overhead of the Intercept Layer
+// for the most frequently called OpenCL APIs, using the stub OpenCL
+// implementation so no OpenCL device is required.  See benchutils.h.
+//
+// Usage: overhead_bench [iterations] [configuration]
+
+#include <algorithm>
+#include <chrono>
+
+#include "benchutils.h"
+
+typedef std::chrono::steady_clock   clock_type;
+
+// The number of enqueues between each call to clFinish.  The Intercept Layer
+// processes device timing events when the queue is finished, so the cost of
+// clFinish is included in the per-call cost of the enqueues.
+static const size_t cFinishInterval = 64;
+
+// Measures the time and the number of calls into the stub OpenCL
+// implementation for a test, including the calls made by the Intercept Layer.
+struct SMeasurement
+{
+    SMeasurement( const SDispatch& cl ) :
+        Dispatch( cl )
+    {
+        start();
+    }
+
+    void start()
+    {
+        StartCalls = Dispatch.stubGetCallCount();
+        StartTime = clock_type::now();
+    }
+
+    void report(
+        const char* configName,
+        const char* testName,
+        size_t calls )
+    {
+        clock_type::time_point  endTime = clock_type::now();
+        uint64_t                endCalls = Dispatch.stubGetCallCount();
+
+        using ns = std::chrono::nanoseconds;
+        const double    nsPerCall =
+            (double)std::chrono::duration_cast<ns>(endTime - StartTime).count() / calls;
+        const double    stubCallsPerCall =
+            (double)( endCalls - StartCalls ) / calls;
+        printf( "%-24s %-36s %10.1f ns/call %8.2f stub calls/call\n",
+            configName, testName, nsPerCall, stubCallsPerCall );
+    }
+
+    const SDispatch&        Dispatch;
+    uint64_t                StartCalls;
+    clock_type::time_point  StartTime;
+};
+
+static int run(
+    const SConfiguration& config,
+    const SDispatch& cl,
+    size_t iterations )
+{
+    cl_int  errorCode = CL_SUCCESS;
+
+    cl_platform_id  platform = NULL;
+    cl_device_id    device = NULL;
+    cl.clGetPlatformIDs( 1, &platform, NULL );
+    cl.clGetDeviceIDs( platform, CL_DEVICE_TYPE_GPU, 1, &device, NULL );
+
+    cl_context  context = cl.clCreateContext(
+        NULL, 1, &device, NULL, NULL, &errorCode );
+    cl_command_queue    queue = cl.clCreateCommandQueue(
+        context, device, CL_QUEUE_PROFILING_ENABLE, &errorCode );
+
+    const size_t    bufferSize = 4096;
+    char            hostData[ bufferSize ];
+    cl_mem  src = cl.clCreateBuffer(
+        context, CL_MEM_READ_WRITE, bufferSize, NULL, &errorCode );
+    cl_mem  dst = cl.clCreateBuffer(
+        context, CL_MEM_READ_WRITE, bufferSize, NULL, &errorCode );
+
+    const char* source =
+        "kernel void Copy( global uint* dst, global uint* src ) {\n"
+        "    uint id = get_global_id(0);\n"
+        "    dst[id] = src[id];\n"
+        "}\n";
+    cl_program  program = cl.clCreateProgramWithSource(
+        context, 1, &source, NULL, &errorCode );
+    cl.clBuildProgram( program, 1, &device, NULL, NULL, NULL );
+    cl_kernel   kernel = cl.clCreateKernel( program, "Copy", &errorCode );
+
+    if( errorCode != CL_SUCCESS )
+    {
+        fprintf( stderr, "Setup failed: %d\n", errorCode );
+        return -1;
+    }
+
+    const size_t    globalWorkSize = bufferSize / sizeof(cl_uint);
+
+    // Warm up, so first-call initialization is not measured.
+    for( size_t i = 0; i < cFinishInterval; i++ )
+    {
+        cl.clSetKernelArg( kernel, 0, sizeof(dst), &dst );
+        cl.clSetKernelArg( kernel, 1, sizeof(src), &src );
+        cl.clEnqueueNDRangeKernel( queue, kernel, 1, NULL, &globalWorkSize, NULL, 0, NULL, NULL );
+    }
+    cl.clFinish( queue );
+
+    SMeasurement    m( cl );
+    for( size_t i = 0; i < iterations; i++ )
+    {
+        cl.clSetKernelArg( kernel, 0, sizeof(dst), &dst );
+    }
+    m.report( config.Name, "clSetKernelArg", iterations );
+
+    m.start();
+    for( size_t i = 0; i < iterations; i++ )
+    {
+        cl.clEnqueueNDRangeKernel( queue, kernel, 1, NULL, &globalWorkSize, NULL, 0, NULL, NULL );
+        if( i % cFinishInterval == cFinishInterval - 1 )
+        {
+            cl.clFinish( queue );
+        }
+    }
+    cl.clFinish( queue );
+    m.report( config.Name, "clEnqueueNDRangeKernel", iterations );
+
+    m.start();
+    for( size_t i = 0; i < iterations; i++ )
+    {
+        cl_event    event = NULL;
+        cl.clEnqueueNDRangeKernel( queue, kernel, 1, NULL, &globalWorkSize, NULL, 0, NULL, &event );
+        cl.clReleaseEvent( event );
+        if( i % cFinishInterval == cFinishInterval - 1 )
+        {
+            cl.clFinish( queue );
+        }
+    }
+    cl.clFinish( queue );
+    m.report( config.Name, "clEnqueueNDRangeKernel + event", iterations );
+
+    m.start();
+    for( size_t i = 0; i < iterations; i++ )
+    {
+        cl.clEnqueueWriteBuffer( queue, src, CL_FALSE, 0, bufferSize, hostData, 0, NULL, NULL );
+        if( i % cFinishInterval == cFinishInterval - 1 )
+        {
+            cl.clFinish( queue );
+        }
+    }
+    cl.clFinish( queue );
+    m.report( config.Name, "clEnqueueWriteBuffer", iterations );
+
+    m.start();
+    for( size_t i = 0; i < iterations; i++ )
+    {
+        cl.clEnqueueReadBuffer( queue, dst, CL_FALSE, 0, bufferSize, hostData, 0, NULL, NULL );
+        if( i % cFinishInterval == cFinishInterval - 1 )
+        {
+            cl.clFinish( queue );
+        }
+    }
+    cl.clFinish( queue );
+    m.report( config.Name, "clEnqueueReadBuffer", iterations );
+
+    m.start();
+    for( size_t i = 0; i < iterations; i++ )
+    {
+        cl.clEnqueueMarkerWithWaitList( queue, 0, NULL, NULL );
+        if( i % cFinishInterval == cFinishInterval - 1 )
+        {
+            cl.clFinish( queue );
+        }
+    }
+    cl.clFinish( queue );
+    m.report( config.Name, "clEnqueueMarkerWithWaitList", iterations );
+
+    {
+        cl_event    event = NULL;
+        cl.clEnqueueMarkerWithWaitList( queue, 0, NULL, &event );
+        cl.clFinish( queue );
+
+        m.start();
+        for( size_t i = 0; i < iterations; i++ )
+        {
+            cl_ulong    timestamp = 0;
+            cl.clGetEventProfilingInfo( event, CL_PROFILING_COMMAND_END, sizeof(timestamp), &timestamp, NULL );
+        }
+        m.report( config.Name, "clGetEventProfilingInfo", iterations );
+
+        cl.clReleaseEvent( event );
+    }
+
+    m.start();
+    for( size_t i = 0; i < iterations; i++ )
+    {
+        cl.clFinish( queue );
+    }
+    m.report( config.Name, "clFinish", iterations );
+
+    cl.clReleaseKernel( kernel );
+    cl.clReleaseProgram( program );
+    cl.clReleaseMemObject( dst );
+    cl.clReleaseMemObject( src );
+    cl.clReleaseCommandQueue( queue );
+    cl.clReleaseContext( context );
+
+    return 0;
+}
+
+int main( int argc, char** argv )
+{
+    size_t  iterations = 100000;
+    if( argc > 1 )
+    {
+        iterations = strtoul( argv[1], NULL, 0 );
+        iterations = std::max< size_t >( iterations, 1 );
+    }
+
+    const char* configName = NULL;
+    if( argc > 2 )
+    {
+        configName = argv[2];
+    }
+
+    printf( "Running %zu iterations.\n", iterations );
+
+    return runConfigurations(
+        configName,
+        [iterations]( const SConfiguration& config, const SDispatch& cl )
+        {
+            return run( config, cl, iterations );
+        } );
+}
@@ -0,0 +1,133 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+// This microbenchmark compares the cost of inserting, finding, and erasing
+// pointer keys in a CPointerMap versus a std::map, which is what the
+// Intercept Layer used previously for its handle tracking tables.
+//
+// Usage: pointermap_bench [iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pointermap.h"
+
+typedef std::chrono::steady_clock   clock_type;
+
+static double nsPerOp(
+    clock_type::time_point start,
+    clock_type::time_point end,
+    size_t ops )
+{
+    using ns = std::chrono::nanoseconds;
+    return (double)std::chrono::duration_cast<ns>(end - start).count() / ops;
+}
+
+template< class Map >
+static void bench(
+    const char* name,
+    const std::vector<const void*>& keys,
+    const std::vector<const void*>& lookups,
+    size_t iterations )
+{
+    double  insertNS = 0;
+    double  findNS = 0;
+    double  eraseNS = 0;
+    size_t  found = 0;
+
+    for( size_t it = 0; it < iterations; it++ )
+    {
+        Map map;
+
+        clock_type::time_point  start = clock_type::now();
+        for( size_t i = 0; i < keys.size(); i++ )
+        {
+            map[ keys[i] ] = (unsigned int)i;
+        }
+        clock_type::time_point  end = clock_type::now();
+        insertNS += nsPerOp( start, end, keys.size() );
+
+        start = clock_type::now();
+        for( auto key : lookups )
+        {
+            if( map.find( key ) != map.end() )
+            {
+                found++;
+            }
+        }
+        end = clock_type::now();
+        findNS += nsPerOp( start, end, lookups.size() );
+
+        start = clock_type::now();
+        for( auto key : keys )
+        {
+            map.erase( key );
+        }
+        end = clock_type::now();
+        eraseNS += nsPerOp( start, end, keys.size() );
+    }
+
+    printf( "%-12s %8zu entries: insert %8.2f ns, find %8.2f ns, erase %8.2f ns (found %zu)\n",
+        name,
+        keys.size(),
+        insertNS / iterations,
+        findNS / iterations,
+        eraseNS / iterations,
+        found / iterations );
+}
+
+int main( int argc, char** argv )
+{
+    size_t  iterations = 10;
+    if( argc > 1 )
+    {
+        iterations = strtoul( argv[1], NULL, 0 );
+        iterations = std::max< size_t >( iterations, 1 );
+    }
+
+    const size_t    sizes[] = { 1000, 100000 };
+    for( auto size : sizes )
+    {
+        // Use heap allocations as keys, so the keys have realistic alignment
+        // and spacing.  Half of the lookups are for keys that are not in the
+        // map.
+        std::vector<char*>  allocations;
+        std::vector<const void*>    keys;
+        std::vector<const void*>    lookups;
+        for( size_t i = 0; i < size * 2; i++ )
+        {
+            char*   p = new char[64];
+            allocations.push_back( p );
+            if( i % 2 == 0 )
+            {
+                keys.push_back( p );
+            }
+            lookups.push_back( p );
+        }
+
+        std::mt19937    rng( 1234 );
+        std::shuffle( keys.begin(), keys.end(), rng );
+        std::shuffle( lookups.begin(), lookups.end(), rng );
+
+        bench< std::map< const void*, unsigned int > >(
+            "std::map", keys, lookups, iterations );
+        bench< CPointerMap< const void*, unsigned int > >(
+            "CPointerMap", keys, lookups, iterations );
+
+        for( auto p : allocations )
+        {
+            delete [] p;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,267 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+// This benchmark measures how the Intercept Layer scales as the number of
+// host threads submitting work increases, using the stub OpenCL
+// implementation so no OpenCL device is required.  See benchutils.h.
+//
+// Each thread creates its own kernel and command queues, then repeatedly
+// sets kernel arguments and enqueues the kernel with an event, cycling
+// through its queues.  Every few enqueues the thread blocks on the most
+// recent event.  For each number of threads this reports the aggregate
+// enqueue throughput and the distribution of the time to set the kernel
+// arguments and enqueue the kernel.  Lock contention within the Intercept
+// Layer shows up as lower throughput and higher tail latency as threads are
+// added.
+//
+// Usage: scalability_bench [enqueues per thread] [max threads] [queues per thread] [configuration]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "benchutils.h"
+
+typedef std::chrono::steady_clock   clock_type;
+
+// The number of enqueues between each blocking wait.
+static const size_t cWaitInterval = 32;
+
+struct SParams
+{
+    size_t  EnqueuesPerThread;
+    size_t  MaxThreads;
+    size_t  QueuesPerThread;
+};
+
+struct SThreadState
+{
+    std::vector<uint32_t>   LatenciesNS;
+    clock_type::time_point  EndTime;
+    cl_int                  ErrorCode;
+};
+
+static void threadFunc(
+    const SDispatch& cl,
+    const SParams& params,
+    cl_context context,
+    cl_device_id device,
+    cl_program program,
+    cl_mem buffer,
+    std::atomic<size_t>& ready,
+    std::atomic<bool>& go,
+    SThreadState& state )
+{
+    cl_int  errorCode = CL_SUCCESS;
+
+    std::vector<cl_command_queue>   queues;
+    for( size_t q = 0; q < params.QueuesPerThread; q++ )
+    {
+        queues.push_back( cl.clCreateCommandQueue(
+            context, device, CL_QUEUE_PROFILING_ENABLE, &errorCode ) );
+    }
+    cl_kernel   kernel = cl.clCreateKernel( program, "Copy", &errorCode );
+    state.ErrorCode = errorCode;
+
+    const size_t    globalWorkSize = 1024;
+    const cl_uint   value = 0;
+
+    state.LatenciesNS.resize( params.EnqueuesPerThread );
+
+    ready++;
+    while( !go )
+    {
+        std::this_thread::yield();
+    }
+
+    for( size_t i = 0; i < params.EnqueuesPerThread; i++ )
+    {
+        cl_command_queue    queue = queues[ i % queues.size() ];
+        cl_event            event = NULL;
+
+        clock_type::time_point  start = clock_type::now();
+        cl.clSetKernelArg( kernel, 0, sizeof(buffer), &buffer );
+        cl.clSetKernelArg( kernel, 1, sizeof(value), &value );
+        cl.clEnqueueNDRangeKernel( queue, kernel, 1, NULL, &globalWorkSize, NULL, 0, NULL, &event );
+        clock_type::time_point  end = clock_type::now();
+
+        using ns = std::chrono::nanoseconds;
+        state.LatenciesNS[i] = (uint32_t)std::min< int64_t >(
+            std::chrono::duration_cast<ns>(end - start).count(),
+            UINT32_MAX );
+
+        if( i % cWaitInterval == cWaitInterval - 1 )
+        {
+            cl.clWaitForEvents( 1, &event );
+        }
+        cl.clReleaseEvent( event );
+    }
+
+    for( auto queue : queues )
+    {
+        cl.clFinish( queue );
+    }
+    state.EndTime = clock_type::now();
+
+    cl.clReleaseKernel( kernel );
+    for( auto queue : queues )
+    {
+        cl.clReleaseCommandQueue( queue );
+    }
+}
+
+static uint32_t percentile( std::vector<uint32_t>& v, double p )
+{
+    size_t  index = (size_t)( p * ( v.size() - 1 ) );
+    std::nth_element( v.begin(), v.begin() + index, v.end() );
+    return v[index];
+}
+
+static int run(
+    const SConfiguration& config,
+    const SDispatch& cl,
+    const SParams& params )
+{
+    cl_int  errorCode = CL_SUCCESS;
+
+    cl_platform_id  platform = NULL;
+    cl_device_id    device = NULL;
+    cl.clGetPlatformIDs( 1, &platform, NULL );
+    cl.clGetDeviceIDs( platform, CL_DEVICE_TYPE_GPU, 1, &device, NULL );
+
+    cl_context  context = cl.clCreateContext(
+        NULL, 1, &device, NULL, NULL, &errorCode );
+    cl_mem      buffer = cl.clCreateBuffer(
+        context, CL_MEM_READ_WRITE, 4096, NULL, &errorCode );
+
+    const char* source =
+        "kernel void Copy( global uint* dst, uint value ) {\n"
+        "    dst[get_global_id(0)] = value;\n"
+        "}\n";
+    cl_program  program = cl.clCreateProgramWithSource(
+        context, 1, &source, NULL, &errorCode );
+    cl.clBuildProgram( program, 1, &device, NULL, NULL, NULL );
+
+    if( errorCode != CL_SUCCESS )
+    {
+        fprintf( stderr, "Setup failed: %d\n", errorCode );
+        return -1;
+    }
+
+    printf( "%-24s %7s %14s %10s %10s %10s %10s\n",
+        "Configuration", "Threads", "Enqueues/s", "p50 (ns)", "p99 (ns)", "p99.9 (ns)", "Max (ns)" );
+
+    for( size_t numThreads = 1; numThreads <= params.MaxThreads; numThreads *= 2 )
+    {
+        std::vector<SThreadState>   states( numThreads );
+        std::vector<std::thread>    threads;
+        std::atomic<size_t>         ready( 0 );
+        std::atomic<bool>           go( false );
+
+        for( size_t t = 0; t < numThreads; t++ )
+        {
+            threads.push_back( std::thread(
+                threadFunc,
+                std::cref( cl ),
+                std::cref( params ),
+                context,
+                device,
+                program,
+                buffer,
+                std::ref( ready ),
+                std::ref( go ),
+                std::ref( states[t] ) ) );
+        }
+
+        while( ready != numThreads )
+        {
+            std::this_thread::yield();
+        }
+
+        clock_type::time_point  start = clock_type::now();
+        go = true;
+
+        for( auto& thread : threads )
+        {
+            thread.join();
+        }
+
+        clock_type::time_point  end = start;
+        std::vector<uint32_t>   latencies;
+        latencies.reserve( numThreads * params.EnqueuesPerThread );
+        for( const auto& state : states )
+        {
+            if( state.ErrorCode != CL_SUCCESS )
+            {
+                fprintf( stderr, "Thread setup failed: %d\n", state.ErrorCode );
+                return -1;
+            }
+            end = std::max( end, state.EndTime );
+            latencies.insert( latencies.end(), state.LatenciesNS.begin(), state.LatenciesNS.end() );
+        }
+
+        using us = std::chrono::microseconds;
+        const double    seconds =
+            std::chrono::duration_cast<us>(end - start).count() / 1e6;
+        const double    throughput = latencies.size() / std::max( seconds, 1e-6 );
+
+        const uint32_t  p50 = percentile( latencies, 0.50 );
+        const uint32_t  p99 = percentile( latencies, 0.99 );
+        const uint32_t  p999 = percentile( latencies, 0.999 );
+        const uint32_t  max = *std::max_element( latencies.begin(), latencies.end() );
+
+        printf( "%-24s %7zu %14.0f %10u %10u %10u %10u\n",
+            config.Name, numThreads, throughput, p50, p99, p999, max );
+        fflush( stdout );
+    }
+
+    cl.clReleaseProgram( program );
+    cl.clReleaseMemObject( buffer );
+    cl.clReleaseContext( context );
+
+    return 0;
+}
+
+int main( int argc, char** argv )
+{
+    SParams params;
+    params.EnqueuesPerThread = 20000;
+    params.MaxThreads = std::max< size_t >( std::thread::hardware_concurrency(), 4 );
+    params.QueuesPerThread = 2;
+
+    if( argc > 1 )
+    {
+        params.EnqueuesPerThread = std::max< size_t >( strtoul( argv[1], NULL, 0 ), 1 );
+    }
+    if( argc > 2 )
+    {
+        params.MaxThreads = std::max< size_t >( strtoul( argv[2], NULL, 0 ), 1 );
+    }
+    if( argc > 3 )
+    {
+        params.QueuesPerThread = std::max< size_t >( strtoul( argv[3], NULL, 0 ), 1 );
+    }
+
+    const char* configName = NULL;
+    if( argc > 4 )
+    {
+        configName = argv[4];
+    }
+
+    printf( "Running %zu enqueues per thread, up to %zu threads, %zu queues per thread.\n",
+        params.EnqueuesPerThread,
+        params.MaxThreads,
+        params.QueuesPerThread );
+
+    return runConfigurations(
+        configName,
+        [&params]( const SConfiguration& config, const SDispatch& cl )
+        {
+            return run( config, cl, params );
+        } );
+}
@@ -0,0 +1,1645 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+// This is a stub OpenCL implementation that is used to measure the overhead
+// of the Intercept Layer without a real OpenCL device.  It exports the
+// OpenCL 1.0 entry points required by the Intercept Layer plus the most
+// common newer entry points.  It supports a single platform with a single
+// device, and contexts, command queues, buffers, programs, kernels, and
+// events with synthetic profiling timestamps.
+//
+// Nothing is actually executed: enqueues only create an event, if one is
+// requested, and do not read or write any memory.  Every event is complete
+// as soon as it is created.  Entry points for images, samplers, and other
+// objects that are not needed for benchmarking return an error.
+
+#define CL_USE_DEPRECATED_OPENCL_1_0_APIS
+#define CL_USE_DEPRECATED_OPENCL_1_1_APIS
+#define CL_USE_DEPRECATED_OPENCL_1_2_APIS
+#define CL_USE_DEPRECATED_OPENCL_2_0_APIS
+#define CL_TARGET_OPENCL_VERSION 300
+
+#include "CL/cl.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <stdlib.h>
+#include <string.h>
+
+struct _cl_platform_id
+{
+};
+
+struct _cl_device_id
+{
+};
+
+static _cl_platform_id  s_Platform;
+static _cl_device_id    s_Device;
+
+// Objects are freed when their reference count reaches zero.  Objects that
+// reference other objects release them in their destructor.  This avoids
+// calling exported entry points from within the stub, which could resolve to
+// the Intercept Layer's entry points instead.
+template< class T >
+static cl_int retain( T obj, cl_int invalid )
+{
+    if( obj == NULL )
+    {
+        return invalid;
+    }
+    obj->RefCount++;
+    return CL_SUCCESS;
+}
+
+template< class T >
+static cl_int release( T obj, cl_int invalid )
+{
+    if( obj == NULL )
+    {
+        return invalid;
+    }
+    if( --obj->RefCount == 0 )
+    {
+        delete obj;
+    }
+    return CL_SUCCESS;
+}
+
+// The number of calls to entry points in the stub, so the benchmarks can
+// measure how many calls the Intercept Layer makes for each application
+// call.
+static std::atomic<uint64_t>    s_CallCount( 0 );
+
+static inline void countCall()
+{
+    s_CallCount.fetch_add( 1, std::memory_order_relaxed );
+}
+
+extern "C" uint64_t stubGetCallCount()
+{
+    return s_CallCount.load( std::memory_order_relaxed );
+}
+
+struct SObject
+{
+    SObject() : RefCount(1) {}
+    virtual ~SObject() {}
+    std::atomic<cl_uint>    RefCount;
+};
+
+struct _cl_context : SObject
+{
+};
+
+struct _cl_command_queue : SObject
+{
+    ~_cl_command_queue()
+    {
+        release( Context, CL_INVALID_CONTEXT );
+    }
+
+    cl_context                  Context;
+    cl_command_queue_properties Properties;
+};
+
+struct _cl_mem : SObject
+{
+    ~_cl_mem()
+    {
+        release( Context, CL_INVALID_CONTEXT );
+        delete [] Storage;
+    }
+
+    cl_context      Context;
+    cl_mem_flags    Flags;
+    size_t          Size;
+    void*           HostPtr;
+    char*           Storage;
+};
+
+struct _cl_program : SObject
+{
+    ~_cl_program()
+    {
+        release( Context, CL_INVALID_CONTEXT );
+    }
+
+    cl_context      Context;
+    std::string     Source;
+    std::string     Options;
+};
+
+struct _cl_kernel : SObject
+{
+    ~_cl_kernel()
+    {
+        release( Program, CL_INVALID_PROGRAM );
+    }
+
+    cl_program      Program;
+    std::string     Name;
+};
+
+struct _cl_event : SObject
+{
+    cl_context          Context;
+    cl_command_queue    Queue;
+    cl_command_type     Type;
+    cl_ulong            Queued;
+    cl_ulong            Submit;
+    cl_ulong            Start;
+    cl_ulong            End;
+};
+
+static void setError( cl_int* errcode_ret, cl_int errorCode )
+{
+    if( errcode_ret )
+    {
+        *errcode_ret = errorCode;
+    }
+}
+
+static cl_int getInfo(
+    const void* src,
+    size_t srcSize,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    if( param_value )
+    {
+        if( param_value_size < srcSize )
+        {
+            return CL_INVALID_VALUE;
+        }
+        memcpy( param_value, src, srcSize );
+    }
+    if( param_value_size_ret )
+    {
+        *param_value_size_ret = srcSize;
+    }
+    return CL_SUCCESS;
+}
+
+template< class T >
+static cl_int getInfoValue(
+    T value,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    return getInfo(
+        &value,
+        sizeof(value),
+        param_value_size,
+        param_value,
+        param_value_size_ret );
+}
+
+static cl_int getInfoString(
+    const char* str,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    return getInfo(
+        str,
+        strlen(str) + 1,
+        param_value_size,
+        param_value,
+        param_value_size_ret );
+}
+
+static cl_ulong getTimestampNS()
+{
+    using ns = std::chrono::nanoseconds;
+    return std::chrono::duration_cast<ns>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+// All enqueues go through this function.  The synthetic profiling
+// timestamps have a fixed submission latency, a fixed delay before the
+// command starts, and a fixed execution time that is longer for kernels.
+static cl_int enqueue(
+    cl_command_queue queue,
+    cl_command_type type,
+    cl_event* event )
+{
+    if( queue == NULL )
+    {
+        return CL_INVALID_COMMAND_QUEUE;
+    }
+
+    if( event )
+    {
+        const bool  isKernel =
+            type == CL_COMMAND_NDRANGE_KERNEL ||
+            type == CL_COMMAND_TASK;
+
+        _cl_event*  pEvent = new _cl_event;
+        pEvent->Context = queue->Context;
+        pEvent->Queue = queue;
+        pEvent->Type = type;
+        pEvent->Queued = getTimestampNS();
+        pEvent->Submit = pEvent->Queued + 500;
+        pEvent->Start = pEvent->Submit + 1000;
+        pEvent->End = pEvent->Start + ( isKernel ? 10000 : 2000 );
+
+        *event = pEvent;
+    }
+
+    return CL_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Platforms and Devices
+
+CL_API_ENTRY cl_int CL_API_CALL clGetPlatformIDs(
+    cl_uint num_entries,
+    cl_platform_id* platforms,
+    cl_uint* num_platforms )
+{
+    countCall();
+    if( platforms && num_entries > 0 )
+    {
+        platforms[0] = &s_Platform;
+    }
+    if( num_platforms )
+    {
+        num_platforms[0] = 1;
+    }
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetPlatformInfo(
+    cl_platform_id platform,
+    cl_platform_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    switch( param_name )
+    {
+    case CL_PLATFORM_PROFILE:
+        return getInfoString( "FULL_PROFILE", param_value_size, param_value, param_value_size_ret );
+    case CL_PLATFORM_VERSION:
+        return getInfoString( "OpenCL 3.0 Stub", param_value_size, param_value, param_value_size_ret );
+    case CL_PLATFORM_NAME:
+        return getInfoString( "Stub OpenCL Platform", param_value_size, param_value, param_value_size_ret );
+    case CL_PLATFORM_VENDOR:
+        return getInfoString( "Stub Vendor", param_value_size, param_value, param_value_size_ret );
+    case CL_PLATFORM_EXTENSIONS:
+        return getInfoString( "", param_value_size, param_value, param_value_size_ret );
+    case CL_PLATFORM_HOST_TIMER_RESOLUTION:
+        return getInfoValue< cl_ulong >( 1, param_value_size, param_value, param_value_size_ret );
+    default:
+        return CL_INVALID_VALUE;
+    }
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetDeviceIDs(
+    cl_platform_id platform,
+    cl_device_type device_type,
+    cl_uint num_entries,
+    cl_device_id* devices,
+    cl_uint* num_devices )
+{
+    countCall();
+    if( !( device_type & ( CL_DEVICE_TYPE_GPU | CL_DEVICE_TYPE_DEFAULT ) ) )
+    {
+        return CL_DEVICE_NOT_FOUND;
+    }
+    if( devices && num_entries > 0 )
+    {
+        devices[0] = &s_Device;
+    }
+    if( num_devices )
+    {
+        num_devices[0] = 1;
+    }
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetDeviceInfo(
+    cl_device_id device,
+    cl_device_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    switch( param_name )
+    {
+    case CL_DEVICE_TYPE:
+        return getInfoValue< cl_device_type >( CL_DEVICE_TYPE_GPU, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_VENDOR_ID:
+        return getInfoValue< cl_uint >( 0xFFFF, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_MAX_COMPUTE_UNITS:
+        return getInfoValue< cl_uint >( 8, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_MAX_WORK_ITEM_DIMENSIONS:
+        return getInfoValue< cl_uint >( 3, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_MAX_WORK_ITEM_SIZES:
+        {
+            const size_t    sizes[3] = { 256, 256, 256 };
+            return getInfo( sizes, sizeof(sizes), param_value_size, param_value, param_value_size_ret );
+        }
+    case CL_DEVICE_MAX_WORK_GROUP_SIZE:
+        return getInfoValue< size_t >( 256, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_MAX_CLOCK_FREQUENCY:
+        return getInfoValue< cl_uint >( 1000, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_ADDRESS_BITS:
+        return getInfoValue< cl_uint >( 64, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_GLOBAL_MEM_SIZE:
+        return getInfoValue< cl_ulong >( 1ULL << 32, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_MAX_MEM_ALLOC_SIZE:
+        return getInfoValue< cl_ulong >( 1ULL << 30, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_LOCAL_MEM_SIZE:
+        return getInfoValue< cl_ulong >( 64 * 1024, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_IMAGE_SUPPORT:
+        return getInfoValue< cl_bool >( CL_FALSE, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_PROFILING_TIMER_RESOLUTION:
+        return getInfoValue< size_t >( 1, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_AVAILABLE:
+    case CL_DEVICE_COMPILER_AVAILABLE:
+    case CL_DEVICE_LINKER_AVAILABLE:
+        return getInfoValue< cl_bool >( CL_TRUE, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_QUEUE_ON_HOST_PROPERTIES:
+        return getInfoValue< cl_command_queue_properties >(
+            CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE | CL_QUEUE_PROFILING_ENABLE,
+            param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_PLATFORM:
+        return getInfoValue< cl_platform_id >( &s_Platform, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_NAME:
+        return getInfoString( "Stub Device", param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_VENDOR:
+        return getInfoString( "Stub Vendor", param_value_size, param_value, param_value_size_ret );
+    case CL_DRIVER_VERSION:
+        return getInfoString( "1.0", param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_PROFILE:
+        return getInfoString( "FULL_PROFILE", param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_VERSION:
+        return getInfoString( "OpenCL 3.0 Stub", param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_OPENCL_C_VERSION:
+        return getInfoString( "OpenCL C 1.2 Stub", param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_EXTENSIONS:
+    case CL_DEVICE_BUILT_IN_KERNELS:
+    case CL_DEVICE_IL_VERSION:
+        return getInfoString( "", param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_PARENT_DEVICE:
+        return getInfoValue< cl_device_id >( NULL, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_PARTITION_MAX_SUB_DEVICES:
+        return getInfoValue< cl_uint >( 0, param_value_size, param_value, param_value_size_ret );
+    case CL_DEVICE_REFERENCE_COUNT:
+        return getInfoValue< cl_uint >( 1, param_value_size, param_value, param_value_size_ret );
+    default:
+        return CL_INVALID_VALUE;
+    }
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainDevice(
+    cl_device_id device )
+{
+    countCall();
+    return device ? CL_SUCCESS : CL_INVALID_DEVICE;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseDevice(
+    cl_device_id device )
+{
+    countCall();
+    return device ? CL_SUCCESS : CL_INVALID_DEVICE;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetDeviceAndHostTimer(
+    cl_device_id device,
+    cl_ulong* device_timestamp,
+    cl_ulong* host_timestamp )
+{
+    countCall();
+    if( device_timestamp == NULL || host_timestamp == NULL )
+    {
+        return CL_INVALID_VALUE;
+    }
+    *device_timestamp = *host_timestamp = getTimestampNS();
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetHostTimer(
+    cl_device_id device,
+    cl_ulong* host_timestamp )
+{
+    countCall();
+    if( host_timestamp == NULL )
+    {
+        return CL_INVALID_VALUE;
+    }
+    *host_timestamp = getTimestampNS();
+    return CL_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Contexts
+
+CL_API_ENTRY cl_context CL_API_CALL clCreateContext(
+    const cl_context_properties* properties,
+    cl_uint num_devices,
+    const cl_device_id* devices,
+    void (CL_CALLBACK* pfn_notify)(const char* errinfo, const void* private_info, size_t cb, void* user_data),
+    void* user_data,
+    cl_int* errcode_ret )
+{
+    countCall();
+    if( num_devices == 0 || devices == NULL )
+    {
+        setError( errcode_ret, CL_INVALID_VALUE );
+        return NULL;
+    }
+    setError( errcode_ret, CL_SUCCESS );
+    return new _cl_context;
+}
+
+CL_API_ENTRY cl_context CL_API_CALL clCreateContextFromType(
+    const cl_context_properties* properties,
+    cl_device_type device_type,
+    void (CL_CALLBACK* pfn_notify)(const char* errinfo, const void* private_info, size_t cb, void* user_data),
+    void* user_data,
+    cl_int* errcode_ret )
+{
+    countCall();
+    if( !( device_type & ( CL_DEVICE_TYPE_GPU | CL_DEVICE_TYPE_DEFAULT ) ) )
+    {
+        setError( errcode_ret, CL_DEVICE_NOT_FOUND );
+        return NULL;
+    }
+    setError( errcode_ret, CL_SUCCESS );
+    return new _cl_context;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainContext(
+    cl_context context )
+{
+    countCall();
+    return retain( context, CL_INVALID_CONTEXT );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseContext(
+    cl_context context )
+{
+    countCall();
+    return release( context, CL_INVALID_CONTEXT );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetContextInfo(
+    cl_context context,
+    cl_context_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    if( context == NULL )
+    {
+        return CL_INVALID_CONTEXT;
+    }
+    switch( param_name )
+    {
+    case CL_CONTEXT_REFERENCE_COUNT:
+        return getInfoValue< cl_uint >( context->RefCount, param_value_size, param_value, param_value_size_ret );
+    case CL_CONTEXT_NUM_DEVICES:
+        return getInfoValue< cl_uint >( 1, param_value_size, param_value, param_value_size_ret );
+    case CL_CONTEXT_DEVICES:
+        return getInfoValue< cl_device_id >( &s_Device, param_value_size, param_value, param_value_size_ret );
+    case CL_CONTEXT_PROPERTIES:
+        return getInfo( NULL, 0, param_value_size, param_value, param_value_size_ret );
+    default:
+        return CL_INVALID_VALUE;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Command Queues
+
+static cl_command_queue createCommandQueue(
+    cl_context context,
+    cl_device_id device,
+    cl_command_queue_properties properties,
+    cl_int* errcode_ret )
+{
+    if( context == NULL )
+    {
+        setError( errcode_ret, CL_INVALID_CONTEXT );
+        return NULL;
+    }
+    if( device != &s_Device )
+    {
+        setError( errcode_ret, CL_INVALID_DEVICE );
+        return NULL;
+    }
+
+    _cl_command_queue*  queue = new _cl_command_queue;
+    queue->Context = context;
+    queue->Properties = properties;
+    context->RefCount++;
+
+    setError( errcode_ret, CL_SUCCESS );
+    return queue;
+}
+
+CL_API_ENTRY cl_command_queue CL_API_CALL clCreateCommandQueue(
+    cl_context context,
+    cl_device_id device,
+    cl_command_queue_properties properties,
+    cl_int* errcode_ret )
+{
+    countCall();
+    return createCommandQueue(
+        context,
+        device,
+        properties,
+        errcode_ret );
+}
+
+CL_API_ENTRY cl_command_queue CL_API_CALL clCreateCommandQueueWithProperties(
+    cl_context context,
+    cl_device_id device,
+    const cl_queue_properties* properties,
+    cl_int* errcode_ret )
+{
+    countCall();
+    cl_command_queue_properties queueProperties = 0;
+    if( properties )
+    {
+        for( size_t i = 0; properties[i] != 0; i += 2 )
+        {
+            if( properties[i] == CL_QUEUE_PROPERTIES )
+            {
+                queueProperties = properties[i + 1];
+            }
+        }
+    }
+    return createCommandQueue(
+        context,
+        device,
+        queueProperties,
+        errcode_ret );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainCommandQueue(
+    cl_command_queue command_queue )
+{
+    countCall();
+    return retain( command_queue, CL_INVALID_COMMAND_QUEUE );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseCommandQueue(
+    cl_command_queue command_queue )
+{
+    countCall();
+    return release( command_queue, CL_INVALID_COMMAND_QUEUE );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetCommandQueueInfo(
+    cl_command_queue command_queue,
+    cl_command_queue_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    if( command_queue == NULL )
+    {
+        return CL_INVALID_COMMAND_QUEUE;
+    }
+    switch( param_name )
+    {
+    case CL_QUEUE_CONTEXT:
+        return getInfoValue< cl_context >( command_queue->Context, param_value_size, param_value, param_value_size_ret );
+    case CL_QUEUE_DEVICE:
+        return getInfoValue< cl_device_id >( &s_Device, param_value_size, param_value, param_value_size_ret );
+    case CL_QUEUE_REFERENCE_COUNT:
+        return getInfoValue< cl_uint >( command_queue->RefCount, param_value_size, param_value, param_value_size_ret );
+    case CL_QUEUE_PROPERTIES:
+        return getInfoValue< cl_command_queue_properties >( command_queue->Properties, param_value_size, param_value, param_value_size_ret );
+    default:
+        return CL_INVALID_VALUE;
+    }
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clSetCommandQueueProperty(
+    cl_command_queue command_queue,
+    cl_command_queue_properties properties,
+    cl_bool enable,
+    cl_command_queue_properties* old_properties )
+{
+    countCall();
+    return CL_INVALID_OPERATION;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clFlush(
+    cl_command_queue command_queue )
+{
+    countCall();
+    return command_queue ? CL_SUCCESS : CL_INVALID_COMMAND_QUEUE;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clFinish(
+    cl_command_queue command_queue )
+{
+    countCall();
+    return command_queue ? CL_SUCCESS : CL_INVALID_COMMAND_QUEUE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Memory Objects
+
+CL_API_ENTRY cl_mem CL_API_CALL clCreateBuffer(
+    cl_context context,
+    cl_mem_flags flags,
+    size_t size,
+    void* host_ptr,
+    cl_int* errcode_ret )
+{
+    countCall();
+    if( context == NULL )
+    {
+        setError( errcode_ret, CL_INVALID_CONTEXT );
+        return NULL;
+    }
+    if( size == 0 )
+    {
+        setError( errcode_ret, CL_INVALID_BUFFER_SIZE );
+        return NULL;
+    }
+
+    _cl_mem*    mem = new _cl_mem;
+    mem->Context = context;
+    mem->Flags = flags;
+    mem->Size = size;
+    mem->HostPtr = ( flags & CL_MEM_USE_HOST_PTR ) ? host_ptr : NULL;
+    mem->Storage = ( flags & CL_MEM_USE_HOST_PTR ) ? NULL : new char[size];
+    context->RefCount++;
+
+    setError( errcode_ret, CL_SUCCESS );
+    return mem;
+}
+
+CL_API_ENTRY cl_mem CL_API_CALL clCreateImage2D(
+    cl_context context,
+    cl_mem_flags flags,
+    const cl_image_format* image_format,
+    size_t image_width,
+    size_t image_height,
+    size_t image_row_pitch,
+    void* host_ptr,
+    cl_int* errcode_ret )
+{
+    countCall();
+    setError( errcode_ret, CL_INVALID_OPERATION );
+    return NULL;
+}
+
+CL_API_ENTRY cl_mem CL_API_CALL clCreateImage3D(
+    cl_context context,
+    cl_mem_flags flags,
+    const cl_image_format* image_format,
+    size_t image_width,
+    size_t image_height,
+    size_t image_depth,
+    size_t image_row_pitch,
+    size_t image_slice_pitch,
+    void* host_ptr,
+    cl_int* errcode_ret )
+{
+    countCall();
+    setError( errcode_ret, CL_INVALID_OPERATION );
+    return NULL;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainMemObject(
+    cl_mem memobj )
+{
+    countCall();
+    return retain( memobj, CL_INVALID_MEM_OBJECT );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseMemObject(
+    cl_mem memobj )
+{
+    countCall();
+    return release( memobj, CL_INVALID_MEM_OBJECT );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetSupportedImageFormats(
+    cl_context context,
+    cl_mem_flags flags,
+    cl_mem_object_type image_type,
+    cl_uint num_entries,
+    cl_image_format* image_formats,
+    cl_uint* num_image_formats )
+{
+    countCall();
+    if( num_image_formats )
+    {
+        num_image_formats[0] = 0;
+    }
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetMemObjectInfo(
+    cl_mem memobj,
+    cl_mem_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    if( memobj == NULL )
+    {
+        return CL_INVALID_MEM_OBJECT;
+    }
+    switch( param_name )
+    {
+    case CL_MEM_TYPE:
+        return getInfoValue< cl_mem_object_type >( CL_MEM_OBJECT_BUFFER, param_value_size, param_value, param_value_size_ret );
+    case CL_MEM_FLAGS:
+        return getInfoValue< cl_mem_flags >( memobj->Flags, param_value_size, param_value, param_value_size_ret );
+    case CL_MEM_SIZE:
+        return getInfoValue< size_t >( memobj->Size, param_value_size, param_value, param_value_size_ret );
+    case CL_MEM_HOST_PTR:
+        return getInfoValue< void* >( memobj->HostPtr, param_value_size, param_value, param_value_size_ret );
+    case CL_MEM_MAP_COUNT:
+        return getInfoValue< cl_uint >( 0, param_value_size, param_value, param_value_size_ret );
+    case CL_MEM_REFERENCE_COUNT:
+        return getInfoValue< cl_uint >( memobj->RefCount, param_value_size, param_value, param_value_size_ret );
+    case CL_MEM_CONTEXT:
+        return getInfoValue< cl_context >( memobj->Context, param_value_size, param_value, param_value_size_ret );
+    case CL_MEM_ASSOCIATED_MEMOBJECT:
+        return getInfoValue< cl_mem >( NULL, param_value_size, param_value, param_value_size_ret );
+    case CL_MEM_OFFSET:
+        return getInfoValue< size_t >( 0, param_value_size, param_value, param_value_size_ret );
+    default:
+        return CL_INVALID_VALUE;
+    }
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetImageInfo(
+    cl_mem image,
+    cl_image_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    return CL_INVALID_MEM_OBJECT;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Samplers
+
+CL_API_ENTRY cl_sampler CL_API_CALL clCreateSampler(
+    cl_context context,
+    cl_bool normalized_coords,
+    cl_addressing_mode addressing_mode,
+    cl_filter_mode filter_mode,
+    cl_int* errcode_ret )
+{
+    countCall();
+    setError( errcode_ret, CL_INVALID_OPERATION );
+    return NULL;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainSampler(
+    cl_sampler sampler )
+{
+    countCall();
+    return CL_INVALID_SAMPLER;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseSampler(
+    cl_sampler sampler )
+{
+    countCall();
+    return CL_INVALID_SAMPLER;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetSamplerInfo(
+    cl_sampler sampler,
+    cl_sampler_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    return CL_INVALID_SAMPLER;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Programs
+
+CL_API_ENTRY cl_program CL_API_CALL clCreateProgramWithSource(
+    cl_context context,
+    cl_uint count,
+    const char** strings,
+    const size_t* lengths,
+    cl_int* errcode_ret )
+{
+    countCall();
+    if( context == NULL )
+    {
+        setError( errcode_ret, CL_INVALID_CONTEXT );
+        return NULL;
+    }
+    if( count == 0 || strings == NULL )
+    {
+        setError( errcode_ret, CL_INVALID_VALUE );
+        return NULL;
+    }
+
+    _cl_program*    program = new _cl_program;
+    program->Context = context;
+    for( cl_uint i = 0; i < count; i++ )
+    {
+        if( lengths && lengths[i] )
+        {
+            program->Source.append( strings[i], lengths[i] );
+        }
+        else
+        {
+            program->Source.append( strings[i] );
+        }
+    }
+    context->RefCount++;
+
+    setError( errcode_ret, CL_SUCCESS );
+    return program;
+}
+
+CL_API_ENTRY cl_program CL_API_CALL clCreateProgramWithBinary(
+    cl_context context,
+    cl_uint num_devices,
+    const cl_device_id* device_list,
+    const size_t* lengths,
+    const unsigned char** binaries,
+    cl_int* binary_status,
+    cl_int* errcode_ret )
+{
+    countCall();
+    setError( errcode_ret, CL_INVALID_OPERATION );
+    return NULL;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainProgram(
+    cl_program program )
+{
+    countCall();
+    return retain( program, CL_INVALID_PROGRAM );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseProgram(
+    cl_program program )
+{
+    countCall();
+    return release( program, CL_INVALID_PROGRAM );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clBuildProgram(
+    cl_program program,
+    cl_uint num_devices,
+    const cl_device_id* device_list,
+    const char* options,
+    void (CL_CALLBACK* pfn_notify)(cl_program program, void* user_data),
+    void* user_data )
+{
+    countCall();
+    if( program == NULL )
+    {
+        return CL_INVALID_PROGRAM;
+    }
+    program->Options = options ? options : "";
+    if( pfn_notify )
+    {
+        pfn_notify( program, user_data );
+    }
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clUnloadCompiler( void )
+{
+    countCall();
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetProgramInfo(
+    cl_program program,
+    cl_program_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    if( program == NULL )
+    {
+        return CL_INVALID_PROGRAM;
+    }
+    switch( param_name )
+    {
+    case CL_PROGRAM_REFERENCE_COUNT:
+        return getInfoValue< cl_uint >( program->RefCount, param_value_size, param_value, param_value_size_ret );
+    case CL_PROGRAM_CONTEXT:
+        return getInfoValue< cl_context >( program->Context, param_value_size, param_value, param_value_size_ret );
+    case CL_PROGRAM_NUM_DEVICES:
+        return getInfoValue< cl_uint >( 1, param_value_size, param_value, param_value_size_ret );
+    case CL_PROGRAM_DEVICES:
+        return getInfoValue< cl_device_id >( &s_Device, param_value_size, param_value, param_value_size_ret );
+    case CL_PROGRAM_SOURCE:
+        return getInfoString( program->Source.c_str(), param_value_size, param_value, param_value_size_ret );
+    case CL_PROGRAM_BINARY_SIZES:
+        return getInfoValue< size_t >( 0, param_value_size, param_value, param_value_size_ret );
+    case CL_PROGRAM_BINARIES:
+        return getInfoValue< unsigned char* >( NULL, param_value_size, param_value, param_value_size_ret );
+    default:
+        return CL_INVALID_VALUE;
+    }
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetProgramBuildInfo(
+    cl_program program,
+    cl_device_id device,
+    cl_program_build_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    if( program == NULL )
+    {
+        return CL_INVALID_PROGRAM;
+    }
+    switch( param_name )
+    {
+    case CL_PROGRAM_BUILD_STATUS:
+        return getInfoValue< cl_build_status >( CL_BUILD_SUCCESS, param_value_size, param_value, param_value_size_ret );
+    case CL_PROGRAM_BUILD_OPTIONS:
+        return getInfoString( program->Options.c_str(), param_value_size, param_value, param_value_size_ret );
+    case CL_PROGRAM_BUILD_LOG:
+        return getInfoString( "", param_value_size, param_value, param_value_size_ret );
+    case CL_PROGRAM_BINARY_TYPE:
+        return getInfoValue< cl_program_binary_type >( CL_PROGRAM_BINARY_TYPE_EXECUTABLE, param_value_size, param_value, param_value_size_ret );
+    default:
+        return CL_INVALID_VALUE;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Kernels
+
+// Any kernel name is accepted, since program source is not parsed.
+CL_API_ENTRY cl_kernel CL_API_CALL clCreateKernel(
+    cl_program program,
+    const char* kernel_name,
+    cl_int* errcode_ret )
+{
+    countCall();
+    if( program == NULL )
+    {
+        setError( errcode_ret, CL_INVALID_PROGRAM );
+        return NULL;
+    }
+    if( kernel_name == NULL )
+    {
+        setError( errcode_ret, CL_INVALID_VALUE );
+        return NULL;
+    }
+
+    _cl_kernel* kernel = new _cl_kernel;
+    kernel->Program = program;
+    kernel->Name = kernel_name;
+    program->RefCount++;
+
+    setError( errcode_ret, CL_SUCCESS );
+    return kernel;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clCreateKernelsInProgram(
+    cl_program program,
+    cl_uint num_kernels,
+    cl_kernel* kernels,
+    cl_uint* num_kernels_ret )
+{
+    countCall();
+    if( program == NULL )
+    {
+        return CL_INVALID_PROGRAM;
+    }
+    if( num_kernels_ret )
+    {
+        num_kernels_ret[0] = 0;
+    }
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainKernel(
+    cl_kernel kernel )
+{
+    countCall();
+    return retain( kernel, CL_INVALID_KERNEL );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseKernel(
+    cl_kernel kernel )
+{
+    countCall();
+    return release( kernel, CL_INVALID_KERNEL );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clSetKernelArg(
+    cl_kernel kernel,
+    cl_uint arg_index,
+    size_t arg_size,
+    const void* arg_value )
+{
+    countCall();
+    return kernel ? CL_SUCCESS : CL_INVALID_KERNEL;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetKernelInfo(
+    cl_kernel kernel,
+    cl_kernel_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    if( kernel == NULL )
+    {
+        return CL_INVALID_KERNEL;
+    }
+    switch( param_name )
+    {
+    case CL_KERNEL_FUNCTION_NAME:
+        return getInfoString( kernel->Name.c_str(), param_value_size, param_value, param_value_size_ret );
+    case CL_KERNEL_NUM_ARGS:
+        return getInfoValue< cl_uint >( 0, param_value_size, param_value, param_value_size_ret );
+    case CL_KERNEL_REFERENCE_COUNT:
+        return getInfoValue< cl_uint >( kernel->RefCount, param_value_size, param_value, param_value_size_ret );
+    case CL_KERNEL_CONTEXT:
+        return getInfoValue< cl_context >( kernel->Program->Context, param_value_size, param_value, param_value_size_ret );
+    case CL_KERNEL_PROGRAM:
+        return getInfoValue< cl_program >( kernel->Program, param_value_size, param_value, param_value_size_ret );
+    case CL_KERNEL_ATTRIBUTES:
+        return getInfoString( "", param_value_size, param_value, param_value_size_ret );
+    default:
+        return CL_INVALID_VALUE;
+    }
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetKernelArgInfo(
+    cl_kernel kernel,
+    cl_uint arg_index,
+    cl_kernel_arg_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    return CL_KERNEL_ARG_INFO_NOT_AVAILABLE;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetKernelWorkGroupInfo(
+    cl_kernel kernel,
+    cl_device_id device,
+    cl_kernel_work_group_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    if( kernel == NULL )
+    {
+        return CL_INVALID_KERNEL;
+    }
+    switch( param_name )
+    {
+    case CL_KERNEL_WORK_GROUP_SIZE:
+        return getInfoValue< size_t >( 256, param_value_size, param_value, param_value_size_ret );
+    case CL_KERNEL_COMPILE_WORK_GROUP_SIZE:
+        {
+            const size_t    sizes[3] = { 0, 0, 0 };
+            return getInfo( sizes, sizeof(sizes), param_value_size, param_value, param_value_size_ret );
+        }
+    case CL_KERNEL_LOCAL_MEM_SIZE:
+    case CL_KERNEL_PRIVATE_MEM_SIZE:
+        return getInfoValue< cl_ulong >( 0, param_value_size, param_value, param_value_size_ret );
+    case CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE:
+        return getInfoValue< size_t >( 16, param_value_size, param_value, param_value_size_ret );
+    default:
+        return CL_INVALID_VALUE;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Events
+
+CL_API_ENTRY cl_int CL_API_CALL clWaitForEvents(
+    cl_uint num_events,
+    const cl_event* event_list )
+{
+    countCall();
+    return ( num_events == 0 || event_list == NULL ) ? CL_INVALID_VALUE : CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetEventInfo(
+    cl_event event,
+    cl_event_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    if( event == NULL )
+    {
+        return CL_INVALID_EVENT;
+    }
+    switch( param_name )
+    {
+    case CL_EVENT_COMMAND_QUEUE:
+        return getInfoValue< cl_command_queue >( event->Queue, param_value_size, param_value, param_value_size_ret );
+    case CL_EVENT_CONTEXT:
+        return getInfoValue< cl_context >( event->Context, param_value_size, param_value, param_value_size_ret );
+    case CL_EVENT_COMMAND_TYPE:
+        return getInfoValue< cl_command_type >( event->Type, param_value_size, param_value, param_value_size_ret );
+    case CL_EVENT_COMMAND_EXECUTION_STATUS:
+        return getInfoValue< cl_int >( CL_COMPLETE, param_value_size, param_value, param_value_size_ret );
+    case CL_EVENT_REFERENCE_COUNT:
+        return getInfoValue< cl_uint >( event->RefCount, param_value_size, param_value, param_value_size_ret );
+    default:
+        return CL_INVALID_VALUE;
+    }
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clRetainEvent(
+    cl_event event )
+{
+    countCall();
+    return retain( event, CL_INVALID_EVENT );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clReleaseEvent(
+    cl_event event )
+{
+    countCall();
+    return release( event, CL_INVALID_EVENT );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clSetEventCallback(
+    cl_event event,
+    cl_int command_exec_callback_type,
+    void (CL_CALLBACK* pfn_notify)(cl_event event, cl_int event_command_status, void* user_data),
+    void* user_data )
+{
+    countCall();
+    if( event == NULL )
+    {
+        return CL_INVALID_EVENT;
+    }
+    if( pfn_notify == NULL )
+    {
+        return CL_INVALID_VALUE;
+    }
+
+    // Events are always complete, so call the callback immediately.
+    pfn_notify( event, CL_COMPLETE, user_data );
+    return CL_SUCCESS;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clGetEventProfilingInfo(
+    cl_event event,
+    cl_profiling_info param_name,
+    size_t param_value_size,
+    void* param_value,
+    size_t* param_value_size_ret )
+{
+    countCall();
+    if( event == NULL )
+    {
+        return CL_INVALID_EVENT;
+    }
+    switch( param_name )
+    {
+    case CL_PROFILING_COMMAND_QUEUED:
+        return getInfoValue< cl_ulong >( event->Queued, param_value_size, param_value, param_value_size_ret );
+    case CL_PROFILING_COMMAND_SUBMIT:
+        return getInfoValue< cl_ulong >( event->Submit, param_value_size, param_value, param_value_size_ret );
+    case CL_PROFILING_COMMAND_START:
+        return getInfoValue< cl_ulong >( event->Start, param_value_size, param_value, param_value_size_ret );
+    case CL_PROFILING_COMMAND_END:
+    case CL_PROFILING_COMMAND_COMPLETE:
+        return getInfoValue< cl_ulong >( event->End, param_value_size, param_value, param_value_size_ret );
+    default:
+        return CL_INVALID_VALUE;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Enqueues
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueReadBuffer(
+    cl_command_queue command_queue,
+    cl_mem buffer,
+    cl_bool blocking_read,
+    size_t offset,
+    size_t size,
+    void* ptr,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return enqueue( command_queue, CL_COMMAND_READ_BUFFER, event );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueReadBufferRect(
+    cl_command_queue command_queue,
+    cl_mem buffer,
+    cl_bool blocking_read,
+    const size_t* buffer_offset,
+    const size_t* host_offset,
+    const size_t* region,
+    size_t buffer_row_pitch,
+    size_t buffer_slice_pitch,
+    size_t host_row_pitch,
+    size_t host_slice_pitch,
+    void* ptr,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return enqueue( command_queue, CL_COMMAND_READ_BUFFER_RECT, event );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueWriteBuffer(
+    cl_command_queue command_queue,
+    cl_mem buffer,
+    cl_bool blocking_write,
+    size_t offset,
+    size_t size,
+    const void* ptr,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return enqueue( command_queue, CL_COMMAND_WRITE_BUFFER, event );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueWriteBufferRect(
+    cl_command_queue command_queue,
+    cl_mem buffer,
+    cl_bool blocking_write,
+    const size_t* buffer_offset,
+    const size_t* host_offset,
+    const size_t* region,
+    size_t buffer_row_pitch,
+    size_t buffer_slice_pitch,
+    size_t host_row_pitch,
+    size_t host_slice_pitch,
+    const void* ptr,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return enqueue( command_queue, CL_COMMAND_WRITE_BUFFER_RECT, event );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueFillBuffer(
+    cl_command_queue command_queue,
+    cl_mem buffer,
+    const void* pattern,
+    size_t pattern_size,
+    size_t offset,
+    size_t size,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return enqueue( command_queue, CL_COMMAND_FILL_BUFFER, event );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueCopyBuffer(
+    cl_command_queue command_queue,
+    cl_mem src_buffer,
+    cl_mem dst_buffer,
+    size_t src_offset,
+    size_t dst_offset,
+    size_t size,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return enqueue( command_queue, CL_COMMAND_COPY_BUFFER, event );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueCopyBufferRect(
+    cl_command_queue command_queue,
+    cl_mem src_buffer,
+    cl_mem dst_buffer,
+    const size_t* src_origin,
+    const size_t* dst_origin,
+    const size_t* region,
+    size_t src_row_pitch,
+    size_t src_slice_pitch,
+    size_t dst_row_pitch,
+    size_t dst_slice_pitch,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return enqueue( command_queue, CL_COMMAND_COPY_BUFFER_RECT, event );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueReadImage(
+    cl_command_queue command_queue,
+    cl_mem image,
+    cl_bool blocking_read,
+    const size_t* origin,
+    const size_t* region,
+    size_t row_pitch,
+    size_t slice_pitch,
+    void* ptr,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return CL_INVALID_MEM_OBJECT;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueWriteImage(
+    cl_command_queue command_queue,
+    cl_mem image,
+    cl_bool blocking_write,
+    const size_t* origin,
+    const size_t* region,
+    size_t input_row_pitch,
+    size_t input_slice_pitch,
+    const void* ptr,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return CL_INVALID_MEM_OBJECT;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueCopyImage(
+    cl_command_queue command_queue,
+    cl_mem src_image,
+    cl_mem dst_image,
+    const size_t* src_origin,
+    const size_t* dst_origin,
+    const size_t* region,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return CL_INVALID_MEM_OBJECT;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueCopyImageToBuffer(
+    cl_command_queue command_queue,
+    cl_mem src_image,
+    cl_mem dst_buffer,
+    const size_t* src_origin,
+    const size_t* region,
+    size_t dst_offset,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return CL_INVALID_MEM_OBJECT;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueCopyBufferToImage(
+    cl_command_queue command_queue,
+    cl_mem src_buffer,
+    cl_mem dst_image,
+    size_t src_offset,
+    const size_t* dst_origin,
+    const size_t* region,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return CL_INVALID_MEM_OBJECT;
+}
+
+CL_API_ENTRY void* CL_API_CALL clEnqueueMapBuffer(
+    cl_command_queue command_queue,
+    cl_mem buffer,
+    cl_bool blocking_map,
+    cl_map_flags map_flags,
+    size_t offset,
+    size_t size,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event,
+    cl_int* errcode_ret )
+{
+    countCall();
+    if( buffer == NULL )
+    {
+        setError( errcode_ret, CL_INVALID_MEM_OBJECT );
+        return NULL;
+    }
+    if( offset + size > buffer->Size )
+    {
+        setError( errcode_ret, CL_INVALID_VALUE );
+        return NULL;
+    }
+
+    cl_int  errorCode = enqueue( command_queue, CL_COMMAND_MAP_BUFFER, event );
+    setError( errcode_ret, errorCode );
+    if( errorCode != CL_SUCCESS )
+    {
+        return NULL;
+    }
+
+    char*   base = buffer->Storage ? buffer->Storage : (char*)buffer->HostPtr;
+    return base + offset;
+}
+
+CL_API_ENTRY void* CL_API_CALL clEnqueueMapImage(
+    cl_command_queue command_queue,
+    cl_mem image,
+    cl_bool blocking_map,
+    cl_map_flags map_flags,
+    const size_t* origin,
+    const size_t* region,
+    size_t* image_row_pitch,
+    size_t* image_slice_pitch,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event,
+    cl_int* errcode_ret )
+{
+    countCall();
+    setError( errcode_ret, CL_INVALID_MEM_OBJECT );
+    return NULL;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueUnmapMemObject(
+    cl_command_queue command_queue,
+    cl_mem memobj,
+    void* mapped_ptr,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    if( memobj == NULL )
+    {
+        return CL_INVALID_MEM_OBJECT;
+    }
+    return enqueue( command_queue, CL_COMMAND_UNMAP_MEM_OBJECT, event );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueNDRangeKernel(
+    cl_command_queue command_queue,
+    cl_kernel kernel,
+    cl_uint work_dim,
+    const size_t* global_work_offset,
+    const size_t* global_work_size,
+    const size_t* local_work_size,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    if( kernel == NULL )
+    {
+        return CL_INVALID_KERNEL;
+    }
+    if( work_dim < 1 || work_dim > 3 )
+    {
+        return CL_INVALID_WORK_DIMENSION;
+    }
+    return enqueue( command_queue, CL_COMMAND_NDRANGE_KERNEL, event );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueTask(
+    cl_command_queue command_queue,
+    cl_kernel kernel,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    if( kernel == NULL )
+    {
+        return CL_INVALID_KERNEL;
+    }
+    return enqueue( command_queue, CL_COMMAND_TASK, event );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueNativeKernel(
+    cl_command_queue command_queue,
+    void (CL_CALLBACK* user_func)(void*),
+    void* args,
+    size_t cb_args,
+    cl_uint num_mem_objects,
+    const cl_mem* mem_list,
+    const void** args_mem_loc,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return CL_INVALID_OPERATION;
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueMarker(
+    cl_command_queue command_queue,
+    cl_event* event )
+{
+    countCall();
+    return enqueue( command_queue, CL_COMMAND_MARKER, event );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueWaitForEvents(
+    cl_command_queue command_queue,
+    cl_uint num_events,
+    const cl_event* event_list )
+{
+    countCall();
+    return enqueue( command_queue, CL_COMMAND_MARKER, NULL );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueBarrier(
+    cl_command_queue command_queue )
+{
+    countCall();
+    return enqueue( command_queue, CL_COMMAND_BARRIER, NULL );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueMarkerWithWaitList(
+    cl_command_queue command_queue,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return enqueue( command_queue, CL_COMMAND_MARKER, event );
+}
+
+CL_API_ENTRY cl_int CL_API_CALL clEnqueueBarrierWithWaitList(
+    cl_command_queue command_queue,
+    cl_uint num_events_in_wait_list,
+    const cl_event* event_wait_list,
+    cl_event* event )
+{
+    countCall();
+    return enqueue( command_queue, CL_COMMAND_BARRIER, event );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Extensions
+
+CL_API_ENTRY void* CL_API_CALL clGetExtensionFunctionAddress(
+    const char* func_name )
+{
+    countCall();
+    return NULL;
+}
+
+CL_API_ENTRY void* CL_API_CALL clGetExtensionFunctionAddressForPlatform(
+    cl_platform_id platform,
+    const char* func_name )
+{
+    countCall();
+    return NULL;
+}
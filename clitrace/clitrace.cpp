@@ -0,0 +1,85 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#include <fstream>
+#include <string>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "chrometracer.h"
+
+static void usage()
+{
+    fprintf(stderr,
+        "Usage: clitrace [--perfetto] <input.bin> [output]\n"
+        "\n"
+        "Converts a binary Chrome Tracing file written with ChromeTraceBinary\n"
+        "to a JSON file, or to a Perfetto trace file if --perfetto is specified.\n"
+        "If the output file is not specified, the output file name is the input\n"
+        "file name with a .json or .pftrace extension.\n");
+}
+
+int main(int argc, char *argv[])
+{
+    CChromeTracer::Format   format = CChromeTracer::Format::JSON;
+
+    int argi = 1;
+    if( argi < argc &&
+        ( !strcmp(argv[argi], "--perfetto") || !strcmp(argv[argi], "-p") ) )
+    {
+        format = CChromeTracer::Format::Perfetto;
+        argi++;
+    }
+
+    const int   numFiles = argc - argi;
+    if( numFiles < 1 || numFiles > 2 )
+    {
+        usage();
+        return 1;
+    }
+
+    std::string inputFileName = argv[argi];
+    std::string outputFileName;
+    if( numFiles == 2 )
+    {
+        outputFileName = argv[argi + 1];
+    }
+    else
+    {
+        outputFileName = inputFileName;
+        size_t  dot = outputFileName.find_last_of('.');
+        size_t  slash = outputFileName.find_last_of("/\\");
+        if( dot != std::string::npos &&
+            ( slash == std::string::npos || dot > slash ) )
+        {
+            outputFileName.erase(dot);
+        }
+        outputFileName += format == CChromeTracer::Format::Perfetto ?
+            ".pftrace" :
+            ".json";
+    }
+
+    std::ifstream is(
+        inputFileName.c_str(),
+        std::ios::in | std::ios::binary );
+    if( !is.good() )
+    {
+        fprintf(stderr, "clitrace Error: couldn't open %s\n",
+            inputFileName.c_str() );
+        return 1;
+    }
+
+    if( !CChromeTracer::convertBinaryTrace( is, outputFileName, format ) )
+    {
+        fprintf(stderr, "clitrace Error: %s is not a complete binary trace, or couldn't write %s\n",
+            inputFileName.c_str(),
+            outputFileName.c_str() );
+        return 1;
+    }
+
+    return 0;
+}
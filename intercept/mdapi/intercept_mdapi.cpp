@@ -235,6 +235,7 @@ cl_command_queue CLIntercept::createMDAPICommandQueue(
     cl_int* errcode_ret )
 {
     std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> timingLock(m_TimingMutex);
 
     cl_command_queue    retVal = NULL;
 
@@ -321,6 +322,7 @@ cl_command_queue CLIntercept::createMDAPICommandQueue(
     if( retVal == NULL )
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> timingLock(m_TimingMutex);
 
         if( m_pMDHelper == NULL )
         {
@@ -4,27 +4,54 @@
 // SPDX-License-Identifier: MIT
 */
 
+#include <algorithm>
+
+#include <string.h>
+
 #include "chrometracer.h"
 
 void CChromeTracer::init(
     const std::string& fileName,
     uint64_t processId,
     uint32_t bufferSize,
-    bool addFlowEvents )
+    bool addFlowEvents,
+    Format format,
+    CStringInterner* pStringInterner )
 {
     m_ProcessId = processId;
     m_BufferSize = bufferSize;
     m_AddFlowEvents = addFlowEvents;
+    m_Format = format;
+    m_pStringInterner = pStringInterner;
 
-    if( m_BufferSize != 0 )
-    {
-        m_RecordBuffer.reserve( m_BufferSize );
-    }
+    static std::atomic<uint64_t>    s_NextTracerNumber( 1 );
+    m_TracerNumber = s_NextTracerNumber.fetch_add( 1, std::memory_order_relaxed );
 
     m_TraceFile.open(
         fileName.c_str(),
         std::ios::out | std::ios::binary );
-    m_TraceFile << "[\n";
+    if( m_Format == Format::Binary )
+    {
+        m_BinaryBuffer.reserve( cBinaryBufferSize + CLI_STRING_BUFFER_SIZE );
+        m_BinaryBuffer.append( sc_BinaryMagic, sizeof(sc_BinaryMagic) );
+        putVarint( cBinaryVersion );
+        putVarint( m_ProcessId );
+        putVarint( m_AddFlowEvents ? 1 : 0 );
+    }
+    else if( m_Format == Format::Perfetto )
+    {
+        m_BinaryBuffer.reserve( cBinaryBufferSize + CLI_STRING_BUFFER_SIZE );
+        m_Perfetto.init( &m_BinaryBuffer, m_ProcessId, m_AddFlowEvents, m_pStringInterner );
+    }
+    else
+    {
+        m_TraceFile << "[\n";
+    }
+
+    if( m_BufferSize != 0 )
+    {
+        startWriterThread();
+    }
 }
 
 // Notes for the future:
@@ -34,6 +61,64 @@ void CChromeTracer::init(
 // Handling each of these four cases separately eliminates the need
 // to concatenate strings and reduces overhead.
 
+void CChromeTracer::addCounters(
+    const char* name,
+    uint64_t time,
+    size_t numCounters,
+    const char* const* counterNames,
+    const uint64_t* counterValues )
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if( m_Format == Format::Binary )
+    {
+        const CStringInterner::Id   nameId = m_pStringInterner->intern( name );
+        std::vector<CStringInterner::Id>    counterIds( numCounters );
+        defineBinaryString( nameId );
+        for( size_t i = 0; i < numCounters; i++ )
+        {
+            counterIds[i] = m_pStringInterner->intern( counterNames[i] );
+            defineBinaryString( counterIds[i] );
+        }
+
+        putBinaryOp( BinaryOp::Counters );
+        putVarint( nameId );
+        putBinaryTime( time );
+        putVarint( numCounters );
+        for( size_t i = 0; i < numCounters; i++ )
+        {
+            putVarint( counterIds[i] );
+            putVarint( counterValues[i] );
+        }
+        return;
+    }
+    if( m_Format == Format::Perfetto )
+    {
+        m_Perfetto.addCounters( name, time, numCounters, counterNames, counterValues );
+        return;
+    }
+
+    int size = CLI_SPRINTF(m_StringBuffer, CLI_STRING_BUFFER_SIZE,
+        "{\"ph\":\"C\",\"pid\":%" PRIu64 ",\"tid\":0,\"name\":\"%s\""
+        ",\"ts\":%.3f,\"args\":{",
+        m_ProcessId,
+        name,
+        time / 1000.0 );
+    m_TraceFile.write(m_StringBuffer, size);
+
+    for( size_t i = 0; i < numCounters; i++ )
+    {
+        size = CLI_SPRINTF(m_StringBuffer, CLI_STRING_BUFFER_SIZE,
+            "%s\"%s\":%" PRIu64,
+            i == 0 ? "" : ",",
+            counterNames[i],
+            counterValues[i] );
+        m_TraceFile.write(m_StringBuffer, size);
+    }
+
+    m_TraceFile << "}},\n";
+}
+
 // Call Logging
 void CChromeTracer::writeCallLogging(
     const char* name,
@@ -291,84 +376,895 @@ void CChromeTracer::writeDeviceTiming(
     }
 }
 
-void CChromeTracer::flushRecords()
+void CChromeTracer::writeRecord( const Record& rec )
+{
+    if( m_Format == Format::Binary )
+    {
+        writeBinaryRecord( rec );
+        return;
+    }
+    if( m_Format == Format::Perfetto )
+    {
+        writePerfettoRecord( rec );
+        return;
+    }
+
+    switch( rec.Type )
+    {
+    case RecordType::CallLogging:
+        writeCallLogging(
+            m_pStringInterner->name(rec.Name).c_str(),
+            rec.CallLogging.ThreadId,
+            rec.CallLogging.StartTime,
+            rec.CallLogging.Delta );
+        break;
+    case RecordType::CallLoggingTag:
+        writeCallLogging(
+            m_pStringInterner->name(rec.Name).c_str(),
+            m_pStringInterner->name(rec.Tag).c_str(),
+            rec.CallLogging.ThreadId,
+            rec.CallLogging.StartTime,
+            rec.CallLogging.Delta );
+        break;
+    case RecordType::CallLoggingId:
+        writeCallLogging(
+            m_pStringInterner->name(rec.Name).c_str(),
+            rec.CallLogging.ThreadId,
+            rec.CallLogging.StartTime,
+            rec.CallLogging.Delta,
+            rec.CallLogging.Id );
+        break;
+    case RecordType::CallLoggingTagId:
+        writeCallLogging(
+            m_pStringInterner->name(rec.Name).c_str(),
+            m_pStringInterner->name(rec.Tag).c_str(),
+            rec.CallLogging.ThreadId,
+            rec.CallLogging.StartTime,
+            rec.CallLogging.Delta,
+            rec.CallLogging.Id );
+        break;
+
+    case RecordType::DeviceTiming:
+        writeDeviceTiming(
+            m_pStringInterner->name(rec.Name).c_str(),
+            rec.DeviceTiming.QueueNumber,
+            rec.DeviceTiming.StartTime,
+            rec.DeviceTiming.EndTime,
+            rec.DeviceTiming.Id );
+        break;
+    case RecordType::DeviceTimingPerKernel:
+        writeDeviceTiming(
+            m_pStringInterner->name(rec.Name).c_str(),
+            rec.DeviceTiming.StartTime,
+            rec.DeviceTiming.EndTime,
+            rec.DeviceTiming.Id );
+        break;
+    case RecordType::DeviceTimingInStages:
+        writeDeviceTiming(
+            m_pStringInterner->name(rec.Name).c_str(),
+            rec.DeviceTiming.Count,
+            rec.DeviceTiming.QueueNumber,
+            rec.DeviceTiming.QueuedTime,
+            rec.DeviceTiming.SubmitTime,
+            rec.DeviceTiming.StartTime,
+            rec.DeviceTiming.EndTime,
+            rec.DeviceTiming.Id );
+        break;
+    case RecordType::DeviceTimingInStagesPerKernel:
+        writeDeviceTiming(
+            m_pStringInterner->name(rec.Name).c_str(),
+            rec.DeviceTiming.QueuedTime,
+            rec.DeviceTiming.SubmitTime,
+            rec.DeviceTiming.StartTime,
+            rec.DeviceTiming.EndTime,
+            rec.DeviceTiming.Id );
+        break;
+
+    default: CLI_ASSERT(0); break;
+    }
+}
+
+size_t CChromeTracer::writeThreadBuffer(
+    SThreadBuffer& threadBuffer,
+    size_t maxRecords )
 {
-    for( const auto& rec : m_RecordBuffer )
+    std::lock_guard<std::mutex> lock(threadBuffer.Mutex);
+    return threadBuffer.Records.consume( [this]( const Record& rec ) {
+        writeRecord( rec );
+    }, maxRecords );
+}
+
+void CChromeTracer::removeRetiredThreadBuffers()
+{
+    size_t  numThreadBuffers = 0;
+    for( auto pThreadBuffer : m_ThreadBuffers )
     {
-        switch( rec.Type )
+        // Check whether the ring is retired before writing its remaining
+        // records, so no records can be added to a retired ring after they
+        // are written.
+        if( pThreadBuffer->State.load( std::memory_order_acquire ) ==
+            cThreadBufferState_Retired )
+        {
+            writeThreadBuffer( *pThreadBuffer );
+            delete pThreadBuffer;
+        }
+        else
         {
-        case RecordType::CallLogging:
-            writeCallLogging(
-                rec.Name.c_str(),
-                rec.CallLogging.ThreadId,
-                rec.CallLogging.StartTime,
-                rec.CallLogging.Delta );
+            m_ThreadBuffers[ numThreadBuffers++ ] = pThreadBuffer;
+        }
+    }
+    m_ThreadBuffers.resize( numThreadBuffers );
+}
+
+void CChromeTracer::writeRecords()
+{
+    for( auto pThreadBuffer : m_ThreadBuffers )
+    {
+        writeThreadBuffer( *pThreadBuffer );
+    }
+    removeRetiredThreadBuffers();
+
+    if( m_Format != Format::JSON &&
+        m_BinaryBuffer.size() >= cBinaryBufferSize )
+    {
+        writeBinaryBuffer();
+    }
+}
+
+std::ostream& CChromeTracer::writeRecordsAndFlush()
+{
+    writeRecords();
+    if( m_Format != Format::JSON )
+    {
+        writeBinaryBuffer();
+    }
+    return m_TraceFile.flush();
+}
+
+void CChromeTracer::writeEof()
+{
+    if( m_Format == Format::Binary )
+    {
+        putBinaryOp( BinaryOp::Eof );
+        writeBinaryBuffer();
+    }
+    else if( m_Format == Format::JSON )
+    {
+        // Add an eof metadata event without a trailing comma to properly
+        // end the json file.
+        m_TraceFile
+            << "{\"ph\":\"M\",\"name\":\"clintercept_eof\",\"pid\":" << m_ProcessId
+            << ",\"tid\":0"
+            << "}\n"
+            << "]\n";
+    }
+}
+
+// The writer thread writes the buffered records at this interval, or sooner
+// if a ring is half full.  Records are written in batches of at most this
+// many records while holding m_Mutex, so other threads that need m_Mutex do
+// not wait for long.
+static const uint32_t   cWriterIntervalMs = 100;
+static const size_t     cWriterBatchSize = 256;
+
+// Rings start small and grow up to the buffer size as they fill, so threads
+// that add few records do not use much memory.
+static const uint32_t   cInitialThreadBufferSize = 256;
+
+// This is set when the thread's ring owner is destroyed as the thread exits.
+// Records may still be added after this, for example by the main thread as
+// the process exits, so they are written without a ring.  This is trivially
+// destructible, so it may be checked after the owner is destroyed.
+static thread_local bool    tlsOwnerDestroyed = false;
+
+struct CChromeTracer::SThreadBufferOwner
+{
+    uint64_t        TracerNumber = 0;
+    SThreadBuffer*  pThreadBuffer = NULL;
+
+    ~SThreadBufferOwner()
+    {
+        release();
+        tlsOwnerDestroyed = true;
+    }
+
+    void release()
+    {
+        if( pThreadBuffer &&
+            pThreadBuffer->State.exchange(
+                cThreadBufferState_Retired,
+                std::memory_order_acq_rel ) == cThreadBufferState_Orphaned )
+        {
+            delete pThreadBuffer;
+        }
+        TracerNumber = 0;
+        pThreadBuffer = NULL;
+    }
+};
+
+CChromeTracer::SThreadBuffer* CChromeTracer::getThreadBuffer()
+{
+    if( tlsOwnerDestroyed )
+    {
+        return NULL;
+    }
+
+    // The thread's ring is cached in thread local storage.  Tracers are
+    // numbered rather than identified by address, since a tracer may be
+    // created at the address of a tracer that has been destroyed.
+    static thread_local SThreadBufferOwner  tlsOwner;
+
+    if( tlsOwner.TracerNumber != m_TracerNumber )
+    {
+        tlsOwner.release();
+
+        SThreadBuffer*  pThreadBuffer = new SThreadBuffer(
+            std::min<uint32_t>( m_BufferSize, cInitialThreadBufferSize ) );
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_ThreadBuffers.push_back( pThreadBuffer );
+        }
+
+        tlsOwner.TracerNumber = m_TracerNumber;
+        tlsOwner.pThreadBuffer = pThreadBuffer;
+    }
+
+    return tlsOwner.pThreadBuffer;
+}
+
+void CChromeTracer::addRecord( const Record& rec )
+{
+    // If records are not buffered, or if this thread no longer has a ring,
+    // write the record synchronously.
+    SThreadBuffer*  pThreadBuffer = m_BufferSize != 0 ? getThreadBuffer() : NULL;
+    if( pThreadBuffer == NULL )
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        writeRecord( rec );
+        if( m_BinaryBuffer.size() >= cBinaryBufferSize )
+        {
+            writeBinaryBuffer();
+        }
+        return;
+    }
+
+    SThreadBuffer&  threadBuffer = *pThreadBuffer;
+    CRecordBuffer&  records = threadBuffer.Records;
+    if( !records.push_back( rec ) )
+    {
+        // If the ring is smaller than the buffer size, grow it.  Otherwise,
+        // the writer thread has not kept up with this thread, so write a
+        // batch of this thread's buffered records on this thread instead.
+        // Either way there is room in the ring afterwards, since this
+        // thread is the only thread that adds records to it.
+        if( records.capacity() < m_BufferSize )
+        {
+            std::lock_guard<std::mutex> lock(threadBuffer.Mutex);
+            records.grow( records.capacity() * 2 );
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            writeThreadBuffer( threadBuffer, cWriterBatchSize );
+        }
+        records.push_back( rec );
+    }
+    else if( records.size() == records.capacity() / 2 )
+    {
+        // Wake the writer thread early when a ring is half full.  The
+        // notification is not synchronized with the writer thread, so it
+        // may be missed, in which case the ring is written at the next
+        // interval.
+        m_WriterCondition.notify_one();
+    }
+}
+
+void CChromeTracer::requestFlush()
+{
+    if( m_WriterThread.joinable() )
+    {
+        // Like the notification when a ring is half full, this may be
+        // missed, in which case the file is flushed at the next interval.
+        m_FlushRequested.store( true, std::memory_order_relaxed );
+        m_WriterCondition.notify_one();
+    }
+    else
+    {
+        flush();
+    }
+}
+
+void CChromeTracer::startWriterThread()
+{
+    m_WriterExit = false;
+    m_WriterThread = std::thread( &CChromeTracer::writerThread, this );
+}
+
+void CChromeTracer::stopWriterThread()
+{
+    if( m_WriterThread.joinable() )
+    {
+        {
+            std::lock_guard<std::mutex> writerLock(m_WriterMutex);
+            m_WriterExit = true;
+        }
+        m_WriterCondition.notify_one();
+
+        m_WriterThread.join();
+    }
+}
+
+void CChromeTracer::writerThread()
+{
+    const std::chrono::milliseconds interval( cWriterIntervalMs );
+
+    std::unique_lock<std::mutex> writerLock(m_WriterMutex);
+    while( !m_WriterExit )
+    {
+        m_WriterCondition.wait_for( writerLock, interval );
+
+        if( m_WriterExit )
+        {
+            break;
+        }
+
+        writerLock.unlock();
+
+        // Write the rings in batches, releasing m_Mutex between batches.
+        // Each ring is written up to the number of records it held when the
+        // writer thread got to it, so a thread that adds records quickly
+        // does not hold up the other rings.  Rings are only removed by the
+        // writer thread or while flushing, in which case a ring may be
+        // skipped until the next interval, which is harmless.
+        size_t          i = 0;
+        SThreadBuffer*  pThreadBuffer = NULL;
+        size_t          remaining = 0;
+        while( true )
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if( i < m_ThreadBuffers.size() )
+            {
+                if( pThreadBuffer != m_ThreadBuffers[i] )
+                {
+                    pThreadBuffer = m_ThreadBuffers[i];
+                    remaining = pThreadBuffer->Records.size();
+                }
+
+                const size_t    written = writeThreadBuffer(
+                    *pThreadBuffer,
+                    std::min( remaining, cWriterBatchSize ) );
+                remaining -= written;
+                if( remaining == 0 || written == 0 )
+                {
+                    i++;
+                }
+                continue;
+            }
+
+            removeRetiredThreadBuffers();
+            if( m_Format != Format::JSON &&
+                ( m_BinaryBuffer.size() >= cBinaryBufferSize ||
+                  m_FlushRequested.load( std::memory_order_relaxed ) ) )
+            {
+                writeBinaryBuffer();
+            }
+            if( m_FlushRequested.exchange( false, std::memory_order_relaxed ) )
+            {
+                m_TraceFile.flush();
+            }
+            break;
+        }
+
+        writerLock.lock();
+    }
+}
+
+const char CChromeTracer::sc_BinaryMagic[8] = {
+    'C', 'L', 'I', 'T', 'R', 'A', 'C', 'E' };
+
+void CChromeTracer::defineBinaryString( CStringInterner::Id id )
+{
+    if( id >= m_BinaryStrings.size() )
+    {
+        m_BinaryStrings.resize( id + 1, false );
+    }
+    if( !m_BinaryStrings[id] )
+    {
+        const std::string& str = m_pStringInterner->name( id );
+        putBinaryOp( BinaryOp::String );
+        putVarint( id );
+        putVarint( str.size() );
+        m_BinaryBuffer.append( str );
+        m_BinaryStrings[id] = true;
+    }
+}
+
+void CChromeTracer::writeBinaryRecord( const Record& rec )
+{
+    defineBinaryString( rec.Name );
+    if( rec.Type == RecordType::CallLoggingTag ||
+        rec.Type == RecordType::CallLoggingTagId )
+    {
+        defineBinaryString( rec.Tag );
+    }
+
+    switch( rec.Type )
+    {
+    case RecordType::CallLogging:
+    case RecordType::CallLoggingTag:
+    case RecordType::CallLoggingId:
+    case RecordType::CallLoggingTagId:
+        {
+            const bool  hasTag =
+                rec.Type == RecordType::CallLoggingTag ||
+                rec.Type == RecordType::CallLoggingTagId;
+            const bool  hasId =
+                rec.Type == RecordType::CallLoggingId ||
+                rec.Type == RecordType::CallLoggingTagId;
+
+            putBinaryOp( (BinaryOp)( (int)BinaryOp::CallLogging +
+                ( (int)rec.Type - (int)RecordType::CallLogging ) ) );
+            putVarint( rec.Name );
+            if( hasTag )
+            {
+                putVarint( rec.Tag );
+            }
+            putVarint( rec.CallLogging.ThreadId );
+            putBinaryTime( rec.CallLogging.StartTime );
+            putVarint( rec.CallLogging.Delta );
+            if( hasId )
+            {
+                putBinaryId( rec.CallLogging.Id );
+            }
+        }
+        break;
+
+    case RecordType::DeviceTiming:
+    case RecordType::DeviceTimingPerKernel:
+        putBinaryOp( rec.Type == RecordType::DeviceTiming ?
+            BinaryOp::DeviceTiming :
+            BinaryOp::DeviceTimingPerKernel );
+        putVarint( rec.Name );
+        if( rec.Type == RecordType::DeviceTiming )
+        {
+            putVarint( rec.DeviceTiming.QueueNumber );
+        }
+        putBinaryTime( rec.DeviceTiming.StartTime );
+        putSignedVarint( (int64_t)( rec.DeviceTiming.EndTime - rec.DeviceTiming.StartTime ) );
+        putBinaryId( rec.DeviceTiming.Id );
+        break;
+
+    case RecordType::DeviceTimingInStages:
+    case RecordType::DeviceTimingInStagesPerKernel:
+        putBinaryOp( rec.Type == RecordType::DeviceTimingInStages ?
+            BinaryOp::DeviceTimingInStages :
+            BinaryOp::DeviceTimingInStagesPerKernel );
+        putVarint( rec.Name );
+        if( rec.Type == RecordType::DeviceTimingInStages )
+        {
+            putVarint( rec.DeviceTiming.Count );
+            putVarint( rec.DeviceTiming.QueueNumber );
+        }
+        putBinaryTime( rec.DeviceTiming.QueuedTime );
+        putSignedVarint( (int64_t)( rec.DeviceTiming.SubmitTime - rec.DeviceTiming.QueuedTime ) );
+        putSignedVarint( (int64_t)( rec.DeviceTiming.StartTime - rec.DeviceTiming.SubmitTime ) );
+        putSignedVarint( (int64_t)( rec.DeviceTiming.EndTime - rec.DeviceTiming.StartTime ) );
+        putBinaryId( rec.DeviceTiming.Id );
+        break;
+
+    default: CLI_ASSERT(0); break;
+    }
+}
+
+void CChromeTracer::writePerfettoRecord( const Record& rec )
+{
+    switch( rec.Type )
+    {
+    case RecordType::CallLogging:
+    case RecordType::CallLoggingTag:
+    case RecordType::CallLoggingId:
+    case RecordType::CallLoggingTagId:
+        m_Perfetto.addCallLogging(
+            rec.Name,
+            rec.Tag,
+            rec.Type == RecordType::CallLoggingTag ||
+                rec.Type == RecordType::CallLoggingTagId,
+            rec.CallLogging.ThreadId,
+            rec.CallLogging.StartTime,
+            rec.CallLogging.Delta,
+            rec.Type == RecordType::CallLoggingId ||
+                rec.Type == RecordType::CallLoggingTagId,
+            rec.CallLogging.Id );
+        break;
+
+    case RecordType::DeviceTiming:
+        m_Perfetto.addDeviceTiming(
+            rec.Name,
+            false,
+            rec.DeviceTiming.QueueNumber,
+            rec.DeviceTiming.StartTime,
+            rec.DeviceTiming.EndTime,
+            rec.DeviceTiming.Id );
+        break;
+    // Per kernel records do not set the queue number.
+    case RecordType::DeviceTimingPerKernel:
+        m_Perfetto.addDeviceTiming(
+            rec.Name,
+            true,
+            0,
+            rec.DeviceTiming.StartTime,
+            rec.DeviceTiming.EndTime,
+            rec.DeviceTiming.Id );
+        break;
+
+    case RecordType::DeviceTimingInStages:
+        m_Perfetto.addDeviceTimingInStages(
+            rec.Name,
+            false,
+            rec.DeviceTiming.QueueNumber,
+            rec.DeviceTiming.QueuedTime,
+            rec.DeviceTiming.SubmitTime,
+            rec.DeviceTiming.StartTime,
+            rec.DeviceTiming.EndTime,
+            rec.DeviceTiming.Id );
+        break;
+    case RecordType::DeviceTimingInStagesPerKernel:
+        m_Perfetto.addDeviceTimingInStages(
+            rec.Name,
+            true,
+            0,
+            rec.DeviceTiming.QueuedTime,
+            rec.DeviceTiming.SubmitTime,
+            rec.DeviceTiming.StartTime,
+            rec.DeviceTiming.EndTime,
+            rec.DeviceTiming.Id );
+        break;
+
+    default: CLI_ASSERT(0); break;
+    }
+}
+
+namespace {
+
+class CBinaryTraceReader
+{
+public:
+    CBinaryTraceReader( std::istream& is ) :
+        m_Stream( is ),
+        m_Ok( true ),
+        m_LastTime( 0 ),
+        m_LastId( 0 ) {}
+
+    bool ok() const
+    {
+        return m_Ok;
+    }
+
+    uint8_t getByte()
+    {
+        const int c = m_Stream.get();
+        if( c == std::char_traits<char>::eof() )
+        {
+            m_Ok = false;
+            return 0;
+        }
+        return (uint8_t)c;
+    }
+
+    uint64_t getVarint()
+    {
+        uint64_t    value = 0;
+        for( unsigned int shift = 0; m_Ok && shift < 64; shift += 7 )
+        {
+            const uint8_t   byte = getByte();
+            value |= (uint64_t)( byte & 0x7F ) << shift;
+            if( ( byte & 0x80 ) == 0 )
+            {
+                return value;
+            }
+        }
+        m_Ok = false;
+        return 0;
+    }
+
+    int64_t getSignedVarint()
+    {
+        const uint64_t  value = getVarint();
+        return (int64_t)( value >> 1 ) ^ -(int64_t)( value & 1 );
+    }
+
+    uint64_t getTime()
+    {
+        m_LastTime += (uint64_t)getSignedVarint();
+        return m_LastTime;
+    }
+
+    uint64_t getId()
+    {
+        m_LastId += (uint64_t)getSignedVarint();
+        return m_LastId;
+    }
+
+    // Binary string numbers are the interner IDs from the traced process,
+    // and they are translated to IDs in the converter's interner.
+    CStringInterner::Id getString()
+    {
+        const uint64_t  index = getVarint();
+        if( index >= m_Strings.size() )
+        {
+            m_Ok = false;
+            return CStringInterner::cEmptyId;
+        }
+        return m_Strings[index];
+    }
+
+    void defineString( CStringInterner& interner )
+    {
+        const uint64_t  index = getVarint();
+        const uint64_t  length = getVarint();
+        if( !m_Ok || index > UINT32_MAX || length > UINT32_MAX )
+        {
+            m_Ok = false;
+            return;
+        }
+
+        std::string str( (size_t)length, '\0' );
+        m_Stream.read( &str[0], (std::streamsize)length );
+        if( (uint64_t)m_Stream.gcount() != length )
+        {
+            m_Ok = false;
+            return;
+        }
+
+        if( index >= m_Strings.size() )
+        {
+            m_Strings.resize( index + 1, (CStringInterner::Id)CStringInterner::cEmptyId );
+        }
+        m_Strings[index] = interner.intern( str );
+    }
+
+private:
+    std::istream&   m_Stream;
+    bool        m_Ok;
+    uint64_t    m_LastTime;
+    uint64_t    m_LastId;
+
+    std::vector<CStringInterner::Id>    m_Strings;
+};
+
+}
+
+bool CChromeTracer::convertBinaryTrace(
+    std::istream& is,
+    const std::string& fileName,
+    Format format )
+{
+    char    magic[sizeof(sc_BinaryMagic)] = {};
+    is.read( magic, sizeof(magic) );
+    if( !is || memcmp( magic, sc_BinaryMagic, sizeof(magic) ) != 0 )
+    {
+        return false;
+    }
+
+    CBinaryTraceReader  reader( is );
+    const uint64_t  version = reader.getVarint();
+    const uint64_t  processId = reader.getVarint();
+    const bool      addFlowEvents = reader.getVarint() != 0;
+    if( !reader.ok() || version != cBinaryVersion )
+    {
+        return false;
+    }
+
+    // The converted events are written immediately, in the same order that
+    // they were written to the binary trace, using the same functions that
+    // write a JSON or Perfetto trace from the intercept layer.
+    CStringInterner interner;
+    CChromeTracer   tracer;
+    tracer.init( fileName, processId, 0, addFlowEvents, format, &interner );
+    if( !tracer.m_TraceFile.good() )
+    {
+        return false;
+    }
+
+    std::vector<const char*>    counterNames;
+    std::vector<uint64_t>       counterValues;
+
+    bool    eof = false;
+    while( !eof && reader.ok() )
+    {
+        const BinaryOp  op = (BinaryOp)reader.getByte();
+        if( !reader.ok() )
+        {
+            break;
+        }
+
+        switch( op )
+        {
+        case BinaryOp::Eof:
+            eof = true;
+            break;
+        case BinaryOp::String:
+            reader.defineString( interner );
+            break;
+
+        case BinaryOp::ProcessMetadata:
+            {
+                const CStringInterner::Id   name = reader.getString();
+                if( reader.ok() )
+                {
+                    tracer.addProcessMetadata( interner.name( name ) );
+                }
+            }
             break;
-        case RecordType::CallLoggingTag:
-            writeCallLogging(
-                rec.Name.c_str(),
-                rec.Tag.c_str(),
-                rec.CallLogging.ThreadId,
-                rec.CallLogging.StartTime,
-                rec.CallLogging.Delta );
+        case BinaryOp::ThreadMetadata:
+            {
+                const uint64_t  threadId = reader.getVarint();
+                const uint64_t  threadNumber = reader.getVarint();
+                if( reader.ok() )
+                {
+                    tracer.addThreadMetadata( threadId, (uint32_t)threadNumber );
+                }
+            }
             break;
-        case RecordType::CallLoggingId:
-            writeCallLogging(
-                rec.Name.c_str(),
-                rec.CallLogging.ThreadId,
-                rec.CallLogging.StartTime,
-                rec.CallLogging.Delta,
-                rec.CallLogging.Id );
+        case BinaryOp::StartTimeMetadata:
+            {
+                const uint64_t  startTime = reader.getVarint();
+                if( reader.ok() )
+                {
+                    tracer.addStartTimeMetadata( startTime );
+                }
+            }
             break;
-        case RecordType::CallLoggingTagId:
-            writeCallLogging(
-                rec.Name.c_str(),
-                rec.Tag.c_str(),
-                rec.CallLogging.ThreadId,
-                rec.CallLogging.StartTime,
-                rec.CallLogging.Delta,
-                rec.CallLogging.Id );
+        case BinaryOp::QueueMetadata:
+            {
+                const uint64_t  queueNumber = reader.getVarint();
+                const CStringInterner::Id   name = reader.getString();
+                if( reader.ok() )
+                {
+                    tracer.addQueueMetadata( (uint32_t)queueNumber, interner.name( name ) );
+                }
+            }
             break;
+        case BinaryOp::Counters:
+            {
+                const CStringInterner::Id   name = reader.getString();
+                const uint64_t  time = reader.getTime();
+                const uint64_t  numCounters = reader.getVarint();
 
-        case RecordType::DeviceTiming:
-            writeDeviceTiming(
-                rec.Name.c_str(),
-                rec.DeviceTiming.QueueNumber,
-                rec.DeviceTiming.StartTime,
-                rec.DeviceTiming.EndTime,
-                rec.DeviceTiming.Id );
+                counterNames.clear();
+                counterValues.clear();
+                for( uint64_t i = 0; i < numCounters && reader.ok(); i++ )
+                {
+                    counterNames.push_back( interner.name( reader.getString() ).c_str() );
+                    counterValues.push_back( reader.getVarint() );
+                }
+                if( reader.ok() )
+                {
+                    tracer.addCounters(
+                        interner.name( name ).c_str(),
+                        time,
+                        counterNames.size(),
+                        counterNames.data(),
+                        counterValues.data() );
+                }
+            }
             break;
-        case RecordType::DeviceTimingPerKernel:
-            writeDeviceTiming(
-                rec.Name.c_str(),
-                rec.DeviceTiming.StartTime,
-                rec.DeviceTiming.EndTime,
-                rec.DeviceTiming.Id );
+
+        case BinaryOp::CallLogging:
+        case BinaryOp::CallLoggingTag:
+        case BinaryOp::CallLoggingId:
+        case BinaryOp::CallLoggingTagId:
+            {
+                const bool  hasTag =
+                    op == BinaryOp::CallLoggingTag ||
+                    op == BinaryOp::CallLoggingTagId;
+                const bool  hasId =
+                    op == BinaryOp::CallLoggingId ||
+                    op == BinaryOp::CallLoggingTagId;
+
+                const CStringInterner::Id   name = reader.getString();
+                CStringInterner::Id tag = CStringInterner::cEmptyId;
+                if( hasTag )
+                {
+                    tag = reader.getString();
+                }
+                const uint64_t  threadId = reader.getVarint();
+                const uint64_t  startTime = reader.getTime();
+                const uint64_t  delta = reader.getVarint();
+                const uint64_t  id = hasId ? reader.getId() : 0;
+                if( !reader.ok() )
+                {
+                    break;
+                }
+
+                const char* nameStr = interner.name( name ).c_str();
+                const std::string&  tagStr = interner.name( tag );
+                switch( op )
+                {
+                case BinaryOp::CallLogging:
+                    tracer.addCallLogging( nameStr, threadId, startTime, delta );
+                    break;
+                case BinaryOp::CallLoggingTag:
+                    tracer.addCallLogging( nameStr, tagStr, threadId, startTime, delta );
+                    break;
+                case BinaryOp::CallLoggingId:
+                    tracer.addCallLogging( nameStr, threadId, startTime, delta, id );
+                    break;
+                default:
+                    tracer.addCallLogging( nameStr, tagStr, threadId, startTime, delta, id );
+                    break;
+                }
+            }
             break;
-        case RecordType::DeviceTimingInStages:
-            writeDeviceTiming(
-                rec.Name.c_str(),
-                rec.DeviceTiming.Count,
-                rec.DeviceTiming.QueueNumber,
-                rec.DeviceTiming.QueuedTime,
-                rec.DeviceTiming.SubmitTime,
-                rec.DeviceTiming.StartTime,
-                rec.DeviceTiming.EndTime,
-                rec.DeviceTiming.Id );
+
+        case BinaryOp::DeviceTiming:
+        case BinaryOp::DeviceTimingPerKernel:
+            {
+                const CStringInterner::Id   name = reader.getString();
+                const uint64_t  queueNumber =
+                    op == BinaryOp::DeviceTiming ? reader.getVarint() : 0;
+                const uint64_t  startTime = reader.getTime();
+                const uint64_t  endTime = startTime + (uint64_t)reader.getSignedVarint();
+                const uint64_t  id = reader.getId();
+                if( !reader.ok() )
+                {
+                    break;
+                }
+
+                if( op == BinaryOp::DeviceTiming )
+                {
+                    tracer.addDeviceTiming(
+                        name, (uint32_t)queueNumber, startTime, endTime, id );
+                }
+                else
+                {
+                    tracer.addDeviceTiming(
+                        name, startTime, endTime, id );
+                }
+            }
             break;
-        case RecordType::DeviceTimingInStagesPerKernel:
-            writeDeviceTiming(
-                rec.Name.c_str(),
-                rec.DeviceTiming.QueuedTime,
-                rec.DeviceTiming.SubmitTime,
-                rec.DeviceTiming.StartTime,
-                rec.DeviceTiming.EndTime,
-                rec.DeviceTiming.Id );
+
+        case BinaryOp::DeviceTimingInStages:
+        case BinaryOp::DeviceTimingInStagesPerKernel:
+            {
+                const bool  perQueue = op == BinaryOp::DeviceTimingInStages;
+
+                const CStringInterner::Id   name = reader.getString();
+                const uint64_t  count = perQueue ? reader.getVarint() : 0;
+                const uint64_t  queueNumber = perQueue ? reader.getVarint() : 0;
+                const uint64_t  queuedTime = reader.getTime();
+                const uint64_t  submitTime = queuedTime + (uint64_t)reader.getSignedVarint();
+                const uint64_t  startTime = submitTime + (uint64_t)reader.getSignedVarint();
+                const uint64_t  endTime = startTime + (uint64_t)reader.getSignedVarint();
+                const uint64_t  id = reader.getId();
+                if( !reader.ok() )
+                {
+                    break;
+                }
+
+                if( perQueue )
+                {
+                    tracer.addDeviceTiming(
+                        name, (uint32_t)count, (uint32_t)queueNumber,
+                        queuedTime, submitTime, startTime, endTime, id );
+                }
+                else
+                {
+                    tracer.addDeviceTiming(
+                        name, queuedTime, submitTime, startTime, endTime, id );
+                }
+            }
             break;
 
-        default: CLI_ASSERT(0); break;
+        default:
+            // An unknown op means the trace is corrupt, or is from a newer
+            // version, so there is no way to find the next record.
+            return false;
         }
     }
 
-    m_RecordBuffer.clear();
+    // A trace from a process that did not exit cleanly may not have an eof
+    // record.  The events that were read are still converted, and the
+    // converted trace is still terminated properly.
+    return eof;
 }
@@ -6,48 +6,93 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <cinttypes>
+#include <condition_variable>
 #include <fstream>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <stdint.h>
 
 #include "common.h"
+#include "perfettowriter.h"
+#include "ringbuffer.h"
+#include "stringinterner.h"
 
 class CChromeTracer
 {
 public:
+    enum class Format
+    {
+        JSON,
+        Binary,
+        Perfetto,
+    };
+
     CChromeTracer() = default;
     CChromeTracer( const CChromeTracer& ) = delete;
     CChromeTracer& operator=( const CChromeTracer& ) = delete;
 
     ~CChromeTracer()
     {
-        flush();
+        stopWriterThread();
 
-        // Add an eof metadata event without a trailing comma to properly end
-        // the json file.
-        m_TraceFile
-            << "{\"ph\":\"M\",\"name\":\"clintercept_eof\",\"pid\":" << m_ProcessId
-            << ",\"tid\":0"
-            << "}\n"
-            << "]\n";
-        m_TraceFile.close();
+        if( m_TraceFile.is_open() )
+        {
+            flush();
+            writeEof();
+            m_TraceFile.close();
+        }
+
+        // The rings for threads that are still running are deleted when the
+        // threads exit.
+        for( auto pThreadBuffer : m_ThreadBuffers )
+        {
+            if( pThreadBuffer->State.exchange(
+                    cThreadBufferState_Orphaned,
+                    std::memory_order_acq_rel ) == cThreadBufferState_Retired )
+            {
+                delete pThreadBuffer;
+            }
+        }
     }
 
     void init(
             const std::string& fileName,
             uint64_t processId,
             uint32_t bufferSize,
-            bool addFlowEvents );
+            bool addFlowEvents,
+            Format format,
+            CStringInterner* pStringInterner );
+
+    // Converts a binary trace to the JSON or Perfetto trace that would have
+    // been written if the binary trace had not been enabled.
+    static bool convertBinaryTrace(
+            std::istream& is,
+            const std::string& fileName,
+            Format format );
 
     void addProcessMetadata(
             const std::string& processName )
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
+        if( m_Format == Format::Binary )
+        {
+            const CStringInterner::Id   id = m_pStringInterner->intern( processName );
+            defineBinaryString( id );
+            putBinaryOp( BinaryOp::ProcessMetadata );
+            putVarint( id );
+            return;
+        }
+        if( m_Format == Format::Perfetto )
+        {
+            m_Perfetto.addProcess( processName );
+            return;
+        }
         m_TraceFile
             << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << m_ProcessId
             << ",\"tid\":0"
@@ -60,6 +105,18 @@ public:
             uint32_t threadNumber )
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
+        if( m_Format == Format::Binary )
+        {
+            putBinaryOp( BinaryOp::ThreadMetadata );
+            putVarint( threadId );
+            putVarint( threadNumber );
+            return;
+        }
+        if( m_Format == Format::Perfetto )
+        {
+            m_Perfetto.addThread( threadId, threadNumber );
+            return;
+        }
         m_TraceFile
             << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << m_ProcessId
             << ",\"tid\":" << threadId
@@ -76,6 +133,17 @@ public:
             uint64_t startTime )
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
+        if( m_Format == Format::Binary )
+        {
+            putBinaryOp( BinaryOp::StartTimeMetadata );
+            putVarint( startTime );
+            return;
+        }
+        if( m_Format == Format::Perfetto )
+        {
+            m_Perfetto.setStartTime( startTime );
+            return;
+        }
         m_TraceFile
             << "{\"ph\":\"M\",\"name\":\"clintercept_start_time\",\"pid\":" << m_ProcessId
             << ",\"tid\":0"
@@ -88,6 +156,20 @@ public:
             const std::string& queueName )
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
+        if( m_Format == Format::Binary )
+        {
+            const CStringInterner::Id   id = m_pStringInterner->intern( queueName );
+            defineBinaryString( id );
+            putBinaryOp( BinaryOp::QueueMetadata );
+            putVarint( queueNumber );
+            putVarint( id );
+            return;
+        }
+        if( m_Format == Format::Perfetto )
+        {
+            m_Perfetto.addQueue( queueNumber, queueName );
+            return;
+        }
         m_TraceFile
             << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << m_ProcessId
             << ",\"tid\":" << queueNumber
@@ -100,6 +182,14 @@ public:
             << "\"}},\n";
     }
 
+    // Counters are infrequent, so they are not buffered.
+    void addCounters(
+            const char* name,
+            uint64_t time,
+            size_t numCounters,
+            const char* const* counterNames,
+            const uint64_t* counterValues );
+
     // Call Logging
     void addCallLogging(
             const char* name,
@@ -107,9 +197,9 @@ public:
             uint64_t startTime,
             uint64_t delta )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        if( m_BufferSize == 0 )
+        if( m_BufferSize == 0 && m_Format == Format::JSON )
         {
+            std::lock_guard<std::mutex> lock(m_Mutex);
             writeCallLogging(
                 name,
                 threadId,
@@ -118,14 +208,12 @@ public:
         }
         else
         {
-            m_RecordBuffer.emplace_back(RecordType::CallLogging, name);
-
-            Record& rec = m_RecordBuffer.back();
+            Record rec(RecordType::CallLogging, m_pStringInterner->intern(name));
             rec.CallLogging.ThreadId = threadId;
             rec.CallLogging.StartTime = startTime;
             rec.CallLogging.Delta = delta;
 
-            checkFlushRecords();
+            addRecord( rec );
         }
     }
 
@@ -137,9 +225,9 @@ public:
             uint64_t startTime,
             uint64_t delta )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        if( m_BufferSize == 0 )
+        if( m_BufferSize == 0 && m_Format == Format::JSON )
         {
+            std::lock_guard<std::mutex> lock(m_Mutex);
             writeCallLogging(
                 name,
                 tag.c_str(),
@@ -149,14 +237,12 @@ public:
         }
         else
         {
-            m_RecordBuffer.emplace_back(RecordType::CallLoggingTag, name, tag);
-
-            Record& rec = m_RecordBuffer.back();
+            Record rec(RecordType::CallLoggingTag, m_pStringInterner->intern(name), m_pStringInterner->intern(tag));
             rec.CallLogging.ThreadId = threadId;
             rec.CallLogging.StartTime = startTime;
             rec.CallLogging.Delta = delta;
 
-            checkFlushRecords();
+            addRecord( rec );
         }
     }
 
@@ -168,9 +254,9 @@ public:
             uint64_t delta,
             uint64_t id )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        if( m_BufferSize == 0 )
+        if( m_BufferSize == 0 && m_Format == Format::JSON )
         {
+            std::lock_guard<std::mutex> lock(m_Mutex);
             writeCallLogging(
                 name,
                 threadId,
@@ -180,15 +266,13 @@ public:
         }
         else
         {
-            m_RecordBuffer.emplace_back(RecordType::CallLoggingId, name);
-
-            Record& rec = m_RecordBuffer.back();
+            Record rec(RecordType::CallLoggingId, m_pStringInterner->intern(name));
             rec.CallLogging.ThreadId = threadId;
             rec.CallLogging.StartTime = startTime;
             rec.CallLogging.Delta = delta;
             rec.CallLogging.Id = id;
 
-            checkFlushRecords();
+            addRecord( rec );
         }
     }
 
@@ -201,9 +285,9 @@ public:
             uint64_t delta,
             uint64_t id )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        if( m_BufferSize == 0 )
+        if( m_BufferSize == 0 && m_Format == Format::JSON )
         {
+            std::lock_guard<std::mutex> lock(m_Mutex);
             writeCallLogging(
                 name,
                 tag.c_str(),
@@ -214,31 +298,29 @@ public:
         }
         else
         {
-            m_RecordBuffer.emplace_back(RecordType::CallLoggingTagId, name, tag);
-
-            Record& rec = m_RecordBuffer.back();
+            Record rec(RecordType::CallLoggingTagId, m_pStringInterner->intern(name), m_pStringInterner->intern(tag));
             rec.CallLogging.ThreadId = threadId;
             rec.CallLogging.StartTime = startTime;
             rec.CallLogging.Delta = delta;
             rec.CallLogging.Id = id;
 
-            checkFlushRecords();
+            addRecord( rec );
         }
     }
 
     // Device Timing
     void addDeviceTiming(
-            const std::string& name,
+            CStringInterner::Id nameId,
             uint32_t queueNumber,
             uint64_t startTime,
             uint64_t endTime,
             uint64_t id )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        if( m_BufferSize == 0 )
+        if( m_BufferSize == 0 && m_Format == Format::JSON )
         {
+            std::lock_guard<std::mutex> lock(m_Mutex);
             writeDeviceTiming(
-                name.c_str(),
+                m_pStringInterner->name(nameId).c_str(),
                 queueNumber,
                 startTime,
                 endTime,
@@ -246,50 +328,46 @@ public:
         }
         else
         {
-            m_RecordBuffer.emplace_back(RecordType::DeviceTiming, name);
-
-            Record& rec = m_RecordBuffer.back();
+            Record rec(RecordType::DeviceTiming, nameId);
             rec.DeviceTiming.QueueNumber = queueNumber;
             rec.DeviceTiming.StartTime = startTime;
             rec.DeviceTiming.EndTime = endTime;
             rec.DeviceTiming.Id = id;
 
-            checkFlushRecords();
+            addRecord( rec );
         }
     }
 
     // Device Timing Per Kernel
     void addDeviceTiming(
-            const std::string& name,
+            CStringInterner::Id nameId,
             uint64_t startTime,
             uint64_t endTime,
             uint64_t id )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        if( m_BufferSize == 0 )
+        if( m_BufferSize == 0 && m_Format == Format::JSON )
         {
+            std::lock_guard<std::mutex> lock(m_Mutex);
             writeDeviceTiming(
-                name.c_str(),
+                m_pStringInterner->name(nameId).c_str(),
                 startTime,
                 endTime,
                 id );
         }
         else
         {
-            m_RecordBuffer.emplace_back(RecordType::DeviceTimingPerKernel, name);
-
-            Record& rec = m_RecordBuffer.back();
+            Record rec(RecordType::DeviceTimingPerKernel, nameId);
             rec.DeviceTiming.StartTime = startTime;
             rec.DeviceTiming.EndTime = endTime;
             rec.DeviceTiming.Id = id;
 
-            checkFlushRecords();
+            addRecord( rec );
         }
     }
 
     // Device Timing In Stages
     void addDeviceTiming(
-            const std::string& name,
+            CStringInterner::Id nameId,
             uint32_t count,
             uint32_t queueNumber,
             uint64_t queuedTime,
@@ -298,11 +376,11 @@ public:
             uint64_t endTime,
             uint64_t id )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        if( m_BufferSize == 0 )
+        if( m_BufferSize == 0 && m_Format == Format::JSON )
         {
+            std::lock_guard<std::mutex> lock(m_Mutex);
             writeDeviceTiming(
-                name.c_str(),
+                m_pStringInterner->name(nameId).c_str(),
                 count,
                 queueNumber,
                 queuedTime,
@@ -313,9 +391,7 @@ public:
         }
         else
         {
-            m_RecordBuffer.emplace_back(RecordType::DeviceTimingInStages, name);
-
-            Record& rec = m_RecordBuffer.back();
+            Record rec(RecordType::DeviceTimingInStages, nameId);
             rec.DeviceTiming.Count = count;
             rec.DeviceTiming.QueueNumber = queueNumber;
             rec.DeviceTiming.QueuedTime = queuedTime;
@@ -324,24 +400,24 @@ public:
             rec.DeviceTiming.EndTime = endTime;
             rec.DeviceTiming.Id = id;
 
-            checkFlushRecords();
+            addRecord( rec );
         }
     }
 
     // Device Timing In Stages Per Kernel
     void addDeviceTiming(
-            const std::string& name,
+            CStringInterner::Id nameId,
             uint64_t queuedTime,
             uint64_t submitTime,
             uint64_t startTime,
             uint64_t endTime,
             uint64_t id )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        if( m_BufferSize == 0 )
+        if( m_BufferSize == 0 && m_Format == Format::JSON )
         {
+            std::lock_guard<std::mutex> lock(m_Mutex);
             writeDeviceTiming(
-                name.c_str(),
+                m_pStringInterner->name(nameId).c_str(),
                 queuedTime,
                 submitTime,
                 startTime,
@@ -350,29 +426,29 @@ public:
         }
         else
         {
-            m_RecordBuffer.emplace_back(RecordType::DeviceTimingInStagesPerKernel, name);
-
-            Record& rec = m_RecordBuffer.back();
+            Record rec(RecordType::DeviceTimingInStagesPerKernel, nameId);
             rec.DeviceTiming.QueuedTime = queuedTime;
             rec.DeviceTiming.SubmitTime = submitTime;
             rec.DeviceTiming.StartTime = startTime;
             rec.DeviceTiming.EndTime = endTime;
             rec.DeviceTiming.Id = id;
 
-            checkFlushRecords();
+            addRecord( rec );
         }
     }
 
     std::ostream& flush()
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
-        if( m_RecordBuffer.size() > 0 )
-        {
-            flushRecords();
-        }
-        return m_TraceFile.flush();
+        return writeRecordsAndFlush();
     }
 
+    // Asks the writer thread to write the buffered records and flush the
+    // file, without waiting for it, so the calling thread does not contend
+    // with other threads or write to the file.  If there is no writer
+    // thread, this is the same as flush().
+    void requestFlush();
+
 private:
     std::mutex  m_Mutex;
 
@@ -381,6 +457,8 @@ private:
     uint64_t    m_ProcessId = 0;
     uint32_t    m_BufferSize = 0;
 
+    CStringInterner*    m_pStringInterner = NULL;
+
     std::ofstream   m_TraceFile;
     mutable char    m_StringBuffer[CLI_STRING_BUFFER_SIZE] = "";
 
@@ -397,19 +475,20 @@ private:
         DeviceTimingInStagesPerKernel,
     };
 
+    // Names and tags are stored as interned string IDs so buffering a
+    // record does not copy any strings.
     struct Record
     {
-        Record( RecordType rt, const char* name ) :
-            Type(rt), Name(name) {}
-        Record( RecordType rt, const std::string& name ) :
-            Type(rt), Name(name) {}
-        Record( RecordType rt, const char* name, const std::string& tag ) :
+        Record() = default;
+        Record( RecordType rt, CStringInterner::Id name ) :
+            Type(rt), Name(name), Tag(CStringInterner::cEmptyId) {}
+        Record( RecordType rt, CStringInterner::Id name, CStringInterner::Id tag ) :
             Type(rt), Name(name), Tag(tag) {}
 
         RecordType  Type;
 
-        std::string Name;
-        std::string Tag;
+        CStringInterner::Id Name;
+        CStringInterner::Id Tag;
 
         union
         {
@@ -434,7 +513,56 @@ private:
         };
     };
 
-    std::vector< Record >   m_RecordBuffer;
+    // When records are buffered, each thread that adds records has its own
+    // ring, so threads do not contend with each other or with the writer
+    // thread.  Each ring has one producer, its thread.  A ring is consumed
+    // by whichever thread holds m_Mutex and the ring's mutex: usually the
+    // writer thread, or a thread whose ring is full, or a thread that
+    // flushes the trace.  The producer only takes the ring's mutex to grow
+    // the ring, so it does not wait for other rings to be written.
+    typedef CSPSCRingBuffer< Record >   CRecordBuffer;
+
+    // A ring is retired when its thread exits, and the consumer deletes it
+    // after writing its remaining records, so threads that come and go do
+    // not accumulate rings.  If the tracer is destroyed first, the ring is
+    // orphaned instead, and is deleted when its thread exits.
+    enum EThreadBufferState
+    {
+        cThreadBufferState_Active,
+        cThreadBufferState_Retired,
+        cThreadBufferState_Orphaned,
+    };
+
+    struct SThreadBuffer
+    {
+        explicit SThreadBuffer( size_t capacity ) :
+            Records( capacity ),
+            State( cThreadBufferState_Active ) {}
+
+        std::mutex              Mutex;
+        CRecordBuffer           Records;
+        std::atomic<uint32_t>   State;
+    };
+
+    // This is the thread local owner of a thread's ring.
+    struct SThreadBufferOwner;
+
+    uint64_t    m_TracerNumber = 0;
+    std::vector< SThreadBuffer* >   m_ThreadBuffers;
+
+    // Returns NULL if the thread's ring owner has already been destroyed.
+    SThreadBuffer*  getThreadBuffer();
+    void addRecord( const Record& rec );
+
+    std::thread m_WriterThread;
+    std::mutex  m_WriterMutex;
+    std::condition_variable m_WriterCondition;
+    bool        m_WriterExit = false;
+    std::atomic<bool>   m_FlushRequested { false };
+
+    void startWriterThread();
+    void stopWriterThread();
+    void writerThread();
 
     // Call Logging
     void writeCallLogging(
@@ -503,13 +631,103 @@ private:
             uint64_t endTime,
             uint64_t id );
 
-    void checkFlushRecords()
+    void writeRecord( const Record& rec );
+    size_t writeThreadBuffer(
+            SThreadBuffer& threadBuffer,
+            size_t maxRecords = SIZE_MAX );
+    void removeRetiredThreadBuffers();
+    void writeRecords();
+    std::ostream& writeRecordsAndFlush();
+    void writeEof();
+
+    // The binary trace is a header followed by a stream of records.  Each
+    // record starts with an op.  Integers are stored as LEB128 varints, and
+    // signed integers are zigzag encoded.  Timestamps are stored as the
+    // difference from the previous timestamp, durations are stored as the
+    // difference from the start of the record, and IDs are stored as the
+    // difference from the previous ID.  Strings are stored once, in a String
+    // record before the first record that uses them, and are referenced by
+    // number afterwards.  The records are written in the same order that the
+    // JSON events would have been written, so a converted trace is identical
+    // to a JSON trace.
+    static const char   sc_BinaryMagic[8];
+    static const uint32_t   cBinaryVersion = 1;
+    static const size_t cBinaryBufferSize = 64 * 1024;
+
+    enum class BinaryOp : uint8_t
     {
-        if( m_RecordBuffer.size() >= m_BufferSize )
+        Eof = 0,
+        String,
+
+        ProcessMetadata,
+        ThreadMetadata,
+        StartTimeMetadata,
+        QueueMetadata,
+        Counters,
+
+        CallLogging,
+        CallLoggingTag,
+        CallLoggingId,
+        CallLoggingTagId,
+
+        DeviceTiming,
+        DeviceTimingPerKernel,
+        DeviceTimingInStages,
+        DeviceTimingInStagesPerKernel,
+    };
+
+    Format      m_Format = Format::JSON;
+
+    // Encoded binary or Perfetto records that have not been written to the
+    // file yet.
+    std::string m_BinaryBuffer;
+    std::vector<bool>   m_BinaryStrings;
+    uint64_t    m_BinaryLastTime = 0;
+    uint64_t    m_BinaryLastId = 0;
+
+    void putBinaryOp( BinaryOp op )
+    {
+        m_BinaryBuffer.push_back( (char)op );
+    }
+
+    void putVarint( uint64_t value )
+    {
+        while( value >= 0x80 )
         {
-            flushRecords();
+            m_BinaryBuffer.push_back( (char)( ( value & 0x7F ) | 0x80 ) );
+            value >>= 7;
         }
+        m_BinaryBuffer.push_back( (char)value );
+    }
+
+    void putSignedVarint( int64_t value )
+    {
+        putVarint( ( (uint64_t)value << 1 ) ^ (uint64_t)( value >> 63 ) );
     }
 
-    void flushRecords();
+    void putBinaryTime( uint64_t time )
+    {
+        putSignedVarint( (int64_t)( time - m_BinaryLastTime ) );
+        m_BinaryLastTime = time;
+    }
+
+    void putBinaryId( uint64_t id )
+    {
+        putSignedVarint( (int64_t)( id - m_BinaryLastId ) );
+        m_BinaryLastId = id;
+    }
+
+    void defineBinaryString( CStringInterner::Id id );
+
+    void writeBinaryRecord( const Record& rec );
+
+    CPerfettoWriter m_Perfetto;
+
+    void writePerfettoRecord( const Record& rec );
+
+    void writeBinaryBuffer()
+    {
+        m_TraceFile.write( m_BinaryBuffer.data(), m_BinaryBuffer.size() );
+        m_BinaryBuffer.clear();
+    }
 };
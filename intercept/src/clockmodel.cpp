@@ -0,0 +1,92 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "clockmodel.h"
+
+CClockModel::CClockModel() :
+    m_NextSample( 0 ),
+    m_NumSamples( 0 ),
+    m_TotalSamples( 0 ),
+    m_RefDeviceTimeNS( 0 ),
+    m_RefHostTimeNS( 0 ),
+    m_Intercept( 0.0 ),
+    m_Skew( 0.0 ),
+    m_RMSResidualNS( 0.0 ),
+    m_MaxResidualNS( 0.0 ),
+    m_WorstRMSResidualNS( 0.0 ) {}
+
+void CClockModel::addSample( uint64_t deviceTimeNS, uint64_t hostTimeNS )
+{
+    m_Samples[ m_NextSample ].DeviceTimeNS = deviceTimeNS;
+    m_Samples[ m_NextSample ].HostTimeNS = hostTimeNS;
+    m_NextSample = ( m_NextSample + 1 ) % cMaxSamples;
+    m_NumSamples = std::min( m_NumSamples + 1, cMaxSamples );
+    m_TotalSamples++;
+
+    m_RefDeviceTimeNS = deviceTimeNS;
+    m_RefHostTimeNS = hostTimeNS;
+
+    fit();
+}
+
+int64_t CClockModel::offsetNS( uint64_t deviceTimeNS ) const
+{
+    const double    x = (double)(int64_t)( deviceTimeNS - m_RefDeviceTimeNS );
+    return (int64_t)( m_RefHostTimeNS - m_RefDeviceTimeNS ) +
+        (int64_t)std::llround( m_Intercept + m_Skew * x );
+}
+
+void CClockModel::fit()
+{
+    // Fit the change in the offset between the two timers, rather than the
+    // host time directly, since the skew is expected to be very small.
+    double  sumX = 0.0;
+    double  sumY = 0.0;
+    double  sumXX = 0.0;
+    double  sumXY = 0.0;
+    for( size_t i = 0; i < m_NumSamples; i++ )
+    {
+        const SSample&  s = m_Samples[i];
+        const double    x = (double)(int64_t)( s.DeviceTimeNS - m_RefDeviceTimeNS );
+        const double    y = (double)(int64_t)( s.HostTimeNS - m_RefHostTimeNS ) - x;
+        sumX += x;
+        sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+    }
+
+    const double    n = (double)m_NumSamples;
+    const double    denominator = n * sumXX - sumX * sumX;
+    if( m_NumSamples < 2 || denominator <= 0.0 )
+    {
+        m_Skew = 0.0;
+        m_Intercept = sumY / n;
+    }
+    else
+    {
+        m_Skew = ( n * sumXY - sumX * sumY ) / denominator;
+        m_Intercept = ( sumY - m_Skew * sumX ) / n;
+    }
+
+    double  sumResidualSquared = 0.0;
+    double  maxResidual = 0.0;
+    for( size_t i = 0; i < m_NumSamples; i++ )
+    {
+        const SSample&  s = m_Samples[i];
+        const double    x = (double)(int64_t)( s.DeviceTimeNS - m_RefDeviceTimeNS );
+        const double    y = (double)(int64_t)( s.HostTimeNS - m_RefHostTimeNS ) - x;
+        const double    residual = y - ( m_Intercept + m_Skew * x );
+        sumResidualSquared += residual * residual;
+        maxResidual = std::max( maxResidual, std::fabs( residual ) );
+    }
+
+    m_RMSResidualNS = std::sqrt( sumResidualSquared / n );
+    m_MaxResidualNS = maxResidual;
+    m_WorstRMSResidualNS = std::max( m_WorstRMSResidualNS, m_RMSResidualNS );
+}
@@ -0,0 +1,95 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// This class models the relationship between a device timer and the
+// Intercept Layer's host timer as a line, with an offset and a skew.  The
+// line is fit to a sliding window of recent (device time, host time) samples
+// using least squares, so a device timestamp can be converted to host time
+// without synchronizing the two timers for every command, and the conversion
+// remains accurate if the two timers advance at slightly different rates.
+// The residuals of the fit describe how well the model matches the samples.
+// This class is not thread safe.
+class CClockModel
+{
+public:
+    CClockModel();
+
+    void    addSample( uint64_t deviceTimeNS, uint64_t hostTimeNS );
+
+    bool    valid() const
+    {
+        return m_NumSamples != 0;
+    }
+
+    // Gets the host time of the most recent sample.
+    uint64_t    lastSampleHostTimeNS() const
+    {
+        return m_RefHostTimeNS;
+    }
+
+    // Gets the difference between the host time and the device time at the
+    // given device time.
+    int64_t offsetNS( uint64_t deviceTimeNS ) const;
+
+    // Statistics for the report.
+    uint64_t    totalSamples() const
+    {
+        return m_TotalSamples;
+    }
+    size_t  windowSamples() const
+    {
+        return m_NumSamples;
+    }
+    double  skewPPM() const
+    {
+        return m_Skew * 1e6;
+    }
+    double  rmsResidualNS() const
+    {
+        return m_RMSResidualNS;
+    }
+    double  maxResidualNS() const
+    {
+        return m_MaxResidualNS;
+    }
+    double  worstRMSResidualNS() const
+    {
+        return m_WorstRMSResidualNS;
+    }
+
+private:
+    static const size_t cMaxSamples = 64;
+
+    struct SSample
+    {
+        uint64_t    DeviceTimeNS;
+        uint64_t    HostTimeNS;
+    };
+
+    SSample m_Samples[cMaxSamples];
+    size_t  m_NextSample;
+    size_t  m_NumSamples;
+    uint64_t    m_TotalSamples;
+
+    // The model is relative to the most recent sample, which keeps the
+    // values that are fit small enough to be represented exactly as doubles:
+    //   host - ref host = ( device - ref device ) * ( 1 + skew ) + intercept
+    uint64_t    m_RefDeviceTimeNS;
+    uint64_t    m_RefHostTimeNS;
+    double  m_Intercept;
+    double  m_Skew;
+
+    double  m_RMSResidualNS;
+    double  m_MaxResidualNS;
+    double  m_WorstRMSResidualNS;
+
+    void    fit();
+};
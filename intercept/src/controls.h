@@ -30,10 +30,12 @@ CLI_CONTROL( bool,          CallLoggingThreadId,                    false, "If s
 CLI_CONTROL( bool,          CallLoggingThreadNumber,                false, "If set to a nonzero value, logs the symbolic number of the calling thread in addition to function entry and exit information for every OpenCL call.  This can be helpful when debugging multi-threading issues." )
 CLI_CONTROL( bool,          CallLoggingElapsedTime,                 false, "If set to a nonzero value, logs the elapsed time in microseconds in addition to function entry and exit information for every OpenCL call, starting from the time the intercept DLL is loaded." )
 CLI_CONTROL( bool,          ITTCallLogging,                         false, "If set to a nonzero value, logs function entry and exit information for every OpenCL call using the ITT APIs.  This feature will only function if the Intercept Layer for OpenCL Applications is built with ITT support." )
-CLI_CONTROL( cl_uint,       ChromeTraceBufferSize,                  16384, "If set to a nonzero value, buffers JSON records for Chrome Tracing in memory before writing to a file.  The buffer will be flushed when it fills, upon application termination, and optionally on blocking OpenCL calls.")
-CLI_CONTROL( bool,          ChromeTraceBufferingBlockingCallFlush,  true,  "If set to a nonzero value, flushes buffered JSON records for Chrome Tracing after blocking OpenCL calls.")
+CLI_CONTROL( cl_uint,       ChromeTraceBufferSize,                  16384, "If set to a nonzero value, buffers records for Chrome Tracing in memory before writing to a file.  Each host thread buffers up to this many records without taking a lock, and a background writer thread writes the buffered records to the file periodically, or sooner if a buffer is half full.  If a buffer fills before the writer thread has written it, the host thread writes the buffered records itself.  Buffered records are also written upon application termination, and optionally after blocking OpenCL calls by the writer thread.")
+CLI_CONTROL( bool,          ChromeTraceBufferingBlockingCallFlush,  true,  "If set to a nonzero value, flushes buffered records for Chrome Tracing after blocking OpenCL calls.  The blocking OpenCL call only wakes the writer thread, which writes the buffered records and flushes the file, so the application thread does not wait for the records to be written.")
 CLI_CONTROL( bool,          ChromeCallLogging,                      false, "If set to a nonzero value, logs function entry and exit information and host performance timing for every OpenCL call to a JSON file that may be used for Chrome Tracing." )
 CLI_CONTROL( bool,          ChromeFlowEvents,                       false, "If set to a nonzero value, adds flow events between OpenCL calls and OpenCL commands in a JSON file that may be used for Chrome Tracing.  Requires both ChromeCallLogging and ChromePerformanceTiming." )
+CLI_CONTROL( bool,          ChromeTraceBinary,                      false, "If set to a nonzero value, writes the records for Chrome Tracing to a compact binary file named clintercept_trace.bin instead of a JSON file.  Strings are only written once and timestamps are delta encoded, so the binary file is much smaller and faster to write than the JSON file.  The binary file may be converted to the JSON file that would have been written otherwise, or to a Perfetto trace, with the clitrace tool." )
+CLI_CONTROL( bool,          ChromeTracePerfetto,                    false, "If set to a nonzero value, writes the records for Chrome Tracing to a Perfetto protobuf trace file named clintercept_trace.pftrace instead of a JSON file.  Perfetto traces are smaller than JSON traces, and very long traces can be loaded into the Perfetto UI and trace_processor.  There is a track for each host thread and for each command queue.  If ChromeTraceBinary is also set, this control takes precedence." )
 CLI_CONTROL( bool,          ErrorLogging,                           false, "If set to a nonzero value, logs all OpenCL errors and the function name that caused the error." )
 CLI_CONTROL( bool,          ErrorAssert,                            false, "If set to a nonzero value, breaks into the debugger when an OpenCL error occurs." )
 CLI_CONTROL( bool,          ContextCallbackLogging,                 false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will install a callback for every context and log any calls to the context callback.  The application's context callback, if any, will be invoked after the Intercept Layer for OpenCL Applications' context callback." )
@@ -55,13 +57,19 @@ CLI_CONTROL( bool,          DemangleKernelNames,                    false, "If s
 CLI_CONTROL_SEPARATOR( Reporting Controls: )
 CLI_CONTROL( bool,          ReportToStderr,                         false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will emit reports to stderr." )
 CLI_CONTROL( bool,          ReportToFile,                           true,  "If set to a nonzero value, the Intercept Layer for OpenCL Applications will write results to the file \"clintercept_report.txt\"." )
-CLI_CONTROL( cl_uint,       ReportInterval,                         0,     "If set to a nonzero value, the Intercept Layer for OpenCL Applications will generate a report at regular intervals (based on the enqueue counter).  This can be useful to generate report data while a long-running application is executing, or if an application does not exit cleanly." )
+CLI_CONTROL( bool,          ReportToJSON,                           false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will also write the host and device performance timing results, including percentiles, to the file \"clintercept_report.json\", for processing by other tools." )
+CLI_CONTROL( cl_uint,       ReportInterval,                         0,     "If set to a nonzero value, the Intercept Layer for OpenCL Applications will generate a report at regular intervals (based on the enqueue counter).  This can be useful to generate report data while a long-running application is executing, or if an application does not exit cleanly.  Reports are written by a background reporter thread, so the enqueue that reaches the interval is not delayed while the report is written." )
+CLI_CONTROL( cl_uint,       ReportIntervalMs,                       0,     "If set to a nonzero value, the Intercept Layer for OpenCL Applications will generate a report at regular intervals of this many milliseconds of wall-clock time.  Reports are written by a background reporter thread from a consistent snapshot of the collected data.  This can be useful to generate report data periodically while a long-running application is executing, even if it enqueues commands infrequently." )
 
 CLI_CONTROL_SEPARATOR( Performance Timing Controls: )
 CLI_CONTROL( bool,          HostPerformanceTiming,                  false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will track the minimum, maximum, and average host CPU time for each OpenCL entry point.  When the process exits, this information will be included in the file \"clIntercept_report.txt\"." )
 CLI_CONTROL( bool,          ToolOverheadTiming,                     true,  "If set to a nonzero value, the Intercept Layer for OpenCL Applications will include some types of tool overhead in timing reports and some types of logging." )
+CLI_CONTROL( bool,          SelfOverheadProfiling,                  false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will measure the time spent in each of its own instrumentation stages, such as call logging, timing tags, device timing event tracking, event checking, and buffer and image dumping.  The number of times each stage ran, the total time, and the estimated 99th percentile time will be included in the file \"clIntercept_report.txt\".  If Chrome Call Logging or Chrome Performance Timing is also enabled, the time spent in each stage will periodically be added to the Chrome trace as a counter track.  This is intended to show which controls are reducing application throughput." )
 CLI_CONTROL( bool,          DevicePerformanceTiming,                false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will add event profiling to track the minimum, maximum, and average device time for each OpenCL command. This operation may be fairly intrusive and may have side effects; in particular it forces all command queues to be created with PROFILING_ENABLED and may increment the reference count for application events. When the process exits, this information will be included in the file \"clIntercept_report.txt\"." )
-CLI_CONTROL( bool,          DevicePerformanceTimingHistogram,       false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will report a histogram of device times in addition to the table of device times for each OpenCL command." )
+CLI_CONTROL( bool,          DevicePerformanceTimingHistogram,       false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will report a histogram of device times for each OpenCL command in addition to the table of device times.  Kernels are distinguished by the same information as the table of device times, such as the kernel name and global and local work sizes.  Each power of two is split into eight buckets, so commands with several distinct device times can be identified.  If ReportToJSON is also set, the non-empty histogram buckets will be included in the file \"clintercept_report.json\", for plotting." )
+CLI_CONTROL( bool,          DevicePerformanceTimingStageStats,      false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will also report the time each OpenCL command spent between being queued and submitted, which is driver submission latency, and between being submitted and starting, which is device queueing delay.  The average and percentiles of each stage are reported for each OpenCL command and for each command queue.  This can show whether an application is limited by host submission or by device saturation.  This requires two additional event profiling queries for each command." )
+CLI_CONTROL( bool,          DevicePerformanceTimingOccupancy,       false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will also report how busy each device and each command queue was, based on the union of the start and end times of the timed OpenCL commands.  The report includes the utilization, the idle gaps between commands and their distribution, the overlap between command queues, and the largest idle gaps with the commands that precede them.  This can be used to find idle time caused by the host.  If device performance timing is sampled, only the sampled commands are counted." )
+CLI_CONTROL( cl_uint,       DevicePerformanceTimingCriticalPath,    0,     "If set to a nonzero value, the Intercept Layer for OpenCL Applications will record the dependencies between up to this many OpenCL commands and blocking host waits, and will report the critical path of the application.  Dependencies come from event wait lists, in-order command queues, and calls to clWaitForEvents and clFinish.  The report lists the OpenCL commands and host waits on the critical path and how much of the critical path they account for, and the slack of the OpenCL commands and host waits that are not on the critical path, which is how much later they could have completed without delaying the application.  Commands that are not timed, for example because device performance timing is sampled, are not included in the analysis." )
 CLI_CONTROL( bool,          DevicePerformanceTimeKernelInfoTracking,false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will distinguish between OpenCL NDRange kernels using information such as the kernel's Preferred Work Group Size Multiple (AKA SIMD size)." )
 CLI_CONTROL( bool,          DevicePerformanceTimeGWOTracking,       false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will distinguish between OpenCL NDRange kernels with different global work offsets for the purpose of device performance timing." )
 CLI_CONTROL( bool,          DevicePerformanceTimeGWSTracking,       false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will distinguish between OpenCL NDRange kernels with different global work sizes for the purpose of device performance timing." )
@@ -70,6 +78,12 @@ CLI_CONTROL( bool,          DevicePerformanceTimeSuggestedLWSTracking, false, "I
 CLI_CONTROL( bool,          DevicePerformanceTimeTransferTracking,  false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will distinguish between transfer operations of different sizes for the purpose of device performance timing." )
 CLI_CONTROL( bool,          DevicePerformanceTimingKernelsOnly,     false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will collect device performance timing for kernel commands only" )
 CLI_CONTROL( bool,          DevicePerformanceTimingSkipUnmap,       false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will skip device performance timing for unmap operations.  This is a workaround for a bug in some OpenCL implementations, where querying events created from unmap operations results in driver crashes." )
+CLI_CONTROL( bool,          DevicePerformanceTimingEventCallbacks,  false, "If set to a nonzero value, the Intercept Layer for OpenCL Applications will register a completion callback for each event used for device performance timing, rather than repeatedly querying the status of every pending event.  This reduces the tool overhead for applications that enqueue many commands before a blocking call.  Events from OpenCL implementations that do not support event callbacks will still be queried." )
+CLI_CONTROL( cl_uint,       DevicePerformanceTimingTimerSyncPeriod, 10000, "The period for sampling the OpenCL device timer and the Intercept Layer for OpenCL Applications timer for device performance timing, in microseconds.  The most recent samples for each device are fit to a linear clock model, which is used to convert device timestamps to host time for tracing.  A smaller period tracks changes in the timers more closely but increases overhead.  If set to zero, the timers are sampled for every command." )
+CLI_CONTROL( cl_uint,       DevicePerformanceTimingMaxPendingEvents, 0,    "If set to a nonzero value, the Intercept Layer for OpenCL Applications will limit the number of events used for device performance timing that have not completed yet to approximately this value.  Each pending event is retained by the Intercept Layer for OpenCL Applications, so this bounds the memory used by applications that enqueue many commands without calling a blocking API.  The DevicePerformanceTimingPendingEventPolicy control determines what happens when the limit is reached." )
+CLI_CONTROL( cl_uint,       DevicePerformanceTimingPendingEventPolicy, 0,  "Determines what the Intercept Layer for OpenCL Applications does when the number of pending device performance timing events reaches DevicePerformanceTimingMaxPendingEvents.  If set to 0, the pending events are checked and completed events are processed, and the new event is dropped if the limit is still reached.  If set to 1, the new event is dropped.  If set to 2, every other pending event is dropped, so the remaining events are spread over time.  The number of dropped events is included in the report." )
+CLI_CONTROL( cl_uint,       DevicePerformanceTimingSampleInterval,  0,     "If set to a value greater than one, the Intercept Layer for OpenCL Applications will only collect device performance timing metrics for one of every this many enqueues for each kernel name or OpenCL API, starting with the first enqueue.  Events are not created for enqueues that are not sampled, which reduces the tool overhead and the effect on the application.  The report includes the estimated total device time for each kernel name or OpenCL API, extrapolated from the sampled enqueues, with a 95% confidence interval." )
+CLI_CONTROL( cl_uint,       DevicePerformanceTimingSamplesPerSecond, 0,    "If set to a nonzero value, the Intercept Layer for OpenCL Applications will collect device performance timing metrics for at most this many enqueues per second for each kernel name or OpenCL API, so the tool overhead remains approximately constant regardless of how many enqueues the application issues.  This control may be combined with DevicePerformanceTimingSampleInterval, and is reported the same way." )
 CLI_CONTROL( cl_uint,       HostPerformanceTimingMinEnqueue,        0,     "The Intercept Layer for OpenCL Applications will only collect host performance timing metrics when the enqueue counter is greater than this value, inclusive." )
 CLI_CONTROL( cl_uint,       HostPerformanceTimingMaxEnqueue,        UINT_MAX, "The Intercept Layer for OpenCL Applications will only collect host performance timing metrics when the enqueue counter is less than this value, inclusive." )
 CLI_CONTROL( cl_uint,       DevicePerformanceTimingMinEnqueue,      0,     "The Intercept Layer for OpenCL Applications will only collect device performance timing metrics when the enqueue counter is greater than this value, inclusive." )
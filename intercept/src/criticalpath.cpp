@@ -0,0 +1,323 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#include <algorithm>
+
+#include "criticalpath.h"
+
+CCriticalPath::CCriticalPath() :
+    m_MaxNodes( 0 ),
+    m_DroppedNodes( 0 ),
+    m_LastHostWait( cInvalidNode ) {}
+
+void CCriticalPath::init( size_t maxNodes )
+{
+    m_MaxNodes = std::min< size_t >( maxNodes, cInvalidNode );
+}
+
+CCriticalPath::NodeIndex CCriticalPath::newNode()
+{
+    if( m_Nodes.size() >= m_MaxNodes )
+    {
+        m_DroppedNodes++;
+        return cInvalidNode;
+    }
+
+    m_Nodes.emplace_back();
+    return (NodeIndex)( m_Nodes.size() - 1 );
+}
+
+CCriticalPath::NodeIndex CCriticalPath::getCommandNode( uint64_t enqueueCounter )
+{
+    CCommandNodeMap::const_iterator iter = m_CommandNodeMap.find( enqueueCounter );
+    if( iter != m_CommandNodeMap.end() )
+    {
+        return iter->second;
+    }
+
+    const NodeIndex index = newNode();
+    if( index != cInvalidNode )
+    {
+        m_CommandNodeMap[ enqueueCounter ] = index;
+    }
+    return index;
+}
+
+CCriticalPath::NodeIndex CCriticalPath::findCommandNode( uint64_t enqueueCounter ) const
+{
+    CCommandNodeMap::const_iterator iter = m_CommandNodeMap.find( enqueueCounter );
+    return iter != m_CommandNodeMap.end() ? iter->second : cInvalidNode;
+}
+
+void CCriticalPath::addEdge( NodeIndex from, NodeIndex to )
+{
+    // Edges must go from an earlier node to a later node, so the nodes stay
+    // in topological order.  An edge can only go backwards if commands were
+    // enqueued to the same queue from multiple threads at the same time, in
+    // which case the order of the commands is not known anyway.
+    if( from != cInvalidNode && to != cInvalidNode && from < to )
+    {
+        std::vector<NodeIndex>& predecessors = m_Nodes[to].Predecessors;
+        if( std::find( predecessors.begin(), predecessors.end(), from ) == predecessors.end() )
+        {
+            predecessors.push_back( from );
+        }
+    }
+}
+
+void CCriticalPath::addCommandDependencies(
+    uint64_t enqueueCounter,
+    const uint64_t* pPredecessors,
+    size_t numPredecessors )
+{
+    // Dependencies are only recorded for commands that have been added, so
+    // commands that are not tracked, for example because they failed or were
+    // not sampled, do not add nodes without timing to the graph.
+    const NodeIndex index = findCommandNode( enqueueCounter );
+    if( index == cInvalidNode )
+    {
+        return;
+    }
+
+    for( size_t i = 0; i < numPredecessors; i++ )
+    {
+        addEdge( findCommandNode( pPredecessors[i] ), index );
+    }
+}
+
+void CCriticalPath::addCommand(
+    uint64_t enqueueCounter,
+    uint32_t tag,
+    unsigned int queueNumber,
+    bool inOrder )
+{
+    const NodeIndex index = getCommandNode( enqueueCounter );
+    if( index == cInvalidNode )
+    {
+        return;
+    }
+
+    m_Nodes[index].Tag = tag;
+
+    CQueueNodeMap::iterator iter = m_QueueLastNode.find( queueNumber );
+    const NodeIndex lastNode =
+        iter != m_QueueLastNode.end() ? iter->second : cInvalidNode;
+
+    if( inOrder )
+    {
+        addEdge( lastNode, index );
+    }
+
+    // Only the first command in each queue after a host wait needs an edge
+    // from the host wait, since later commands depend on it transitively
+    // for in-order queues.
+    if( m_LastHostWait != cInvalidNode &&
+        ( lastNode == cInvalidNode || lastNode < m_LastHostWait ) )
+    {
+        addEdge( m_LastHostWait, index );
+    }
+
+    m_QueueLastNode[ queueNumber ] = std::max(
+        index,
+        lastNode == cInvalidNode ? index : lastNode );
+}
+
+void CCriticalPath::setCommandTime(
+    uint64_t enqueueCounter,
+    uint64_t startNS,
+    uint64_t endNS )
+{
+    const NodeIndex index = findCommandNode( enqueueCounter );
+    if( index != cInvalidNode )
+    {
+        SNode&  node = m_Nodes[index];
+        node.HasTime = true;
+        node.StartNS = startNS;
+        node.EndNS = std::max( startNS, endNS );
+    }
+}
+
+void CCriticalPath::addHostWait(
+    uint32_t tag,
+    uint64_t startNS,
+    uint64_t endNS,
+    const uint64_t* pPredecessors,
+    size_t numPredecessors )
+{
+    const NodeIndex index = newNode();
+    if( index == cInvalidNode )
+    {
+        return;
+    }
+
+    SNode&  node = m_Nodes[index];
+    node.Tag = tag;
+    node.HostWait = true;
+    node.HasTime = true;
+    node.StartNS = startNS;
+    node.EndNS = std::max( startNS, endNS );
+
+    for( size_t i = 0; i < numPredecessors; i++ )
+    {
+        addEdge( findCommandNode( pPredecessors[i] ), index );
+    }
+    addEdge( m_LastHostWait, index );
+
+    m_LastHostWait = index;
+}
+
+void CCriticalPath::addQueueHostWait(
+    uint32_t tag,
+    uint64_t startNS,
+    uint64_t endNS,
+    unsigned int queueNumber )
+{
+    CQueueNodeMap::const_iterator iter = m_QueueLastNode.find( queueNumber );
+    const NodeIndex lastNode =
+        iter != m_QueueLastNode.end() ? iter->second : cInvalidNode;
+
+    const NodeIndex index = newNode();
+    if( index == cInvalidNode )
+    {
+        return;
+    }
+
+    SNode&  node = m_Nodes[index];
+    node.Tag = tag;
+    node.HostWait = true;
+    node.HasTime = true;
+    node.StartNS = startNS;
+    node.EndNS = std::max( startNS, endNS );
+
+    addEdge( lastNode, index );
+    addEdge( m_LastHostWait, index );
+
+    m_LastHostWait = index;
+}
+
+void CCriticalPath::analyze( SResults& results ) const
+{
+    results = SResults();
+
+    const size_t    numNodes = m_Nodes.size();
+
+    // The critical path ends at the node that ends last.
+    NodeIndex   sink = cInvalidNode;
+    uint64_t    runEndNS = 0;
+    for( size_t i = 0; i < numNodes; i++ )
+    {
+        const SNode&    node = m_Nodes[i];
+        if( node.HasTime )
+        {
+            results.Nodes++;
+            for( NodeIndex p : node.Predecessors )
+            {
+                results.Edges += m_Nodes[p].HasTime ? 1 : 0;
+            }
+            if( sink == cInvalidNode || node.EndNS > runEndNS )
+            {
+                sink = (NodeIndex)i;
+                runEndNS = node.EndNS;
+            }
+        }
+    }
+    if( sink == cInvalidNode )
+    {
+        return;
+    }
+
+    // Walk backwards from the sink, following the predecessor that ended
+    // last, since that is the predecessor that the node waited for.
+    std::vector<NodeIndex>  path;
+    NodeIndex   current = sink;
+    while( current != cInvalidNode )
+    {
+        const SNode&    node = m_Nodes[current];
+        path.push_back( current );
+
+        NodeIndex   next = cInvalidNode;
+        for( NodeIndex p : node.Predecessors )
+        {
+            if( m_Nodes[p].HasTime &&
+                ( next == cInvalidNode || m_Nodes[p].EndNS > m_Nodes[next].EndNS ) )
+            {
+                next = p;
+            }
+        }
+        current = next;
+    }
+
+    // Nodes on the critical path may overlap, for example a host wait
+    // starts before the command it waits for ends, so each node is only
+    // credited with the part of the path after the previous node ended.
+    // The rest of the path is gaps between nodes, such as host enqueue or
+    // driver submission latency.
+    std::vector<uint64_t>   pathNS( numNodes, UINT64_MAX );
+    uint64_t    prevEndNS = m_Nodes[path.back()].StartNS;
+    for( size_t i = path.size(); i-- > 0; )
+    {
+        const SNode&    node = m_Nodes[path[i]];
+        const uint64_t  startNS = std::max( node.StartNS, prevEndNS );
+        pathNS[path[i]] = node.EndNS > startNS ? node.EndNS - startNS : 0;
+        prevEndNS = std::max( prevEndNS, node.EndNS );
+    }
+    results.PathNodes = path.size();
+    results.PathStartNS = m_Nodes[path.back()].StartNS;
+    results.PathEndNS = runEndNS;
+
+    // The slack of a node is how much later it could have ended without
+    // delaying the end of the run.  Since the nodes are in topological
+    // order, every successor of a node has been processed before the node
+    // itself when iterating in reverse.
+    std::vector<uint64_t>   slack( numNodes, 0 );
+    for( size_t i = 0; i < numNodes; i++ )
+    {
+        const SNode&    node = m_Nodes[i];
+        slack[i] = node.HasTime ? runEndNS - std::min( runEndNS, node.EndNS ) : 0;
+    }
+    for( size_t i = numNodes; i-- > 0; )
+    {
+        const SNode&    node = m_Nodes[i];
+        if( !node.HasTime )
+        {
+            continue;
+        }
+        for( NodeIndex p : node.Predecessors )
+        {
+            const SNode&    pred = m_Nodes[p];
+            if( pred.HasTime )
+            {
+                const uint64_t  gapNS =
+                    node.StartNS > pred.EndNS ? node.StartNS - pred.EndNS : 0;
+                slack[p] = std::min( slack[p], gapNS + slack[i] );
+            }
+        }
+    }
+
+    for( size_t i = 0; i < numNodes; i++ )
+    {
+        const SNode&    node = m_Nodes[i];
+        if( !node.HasTime )
+        {
+            continue;
+        }
+
+        SNodeSummary&   summary =
+            results.Summaries[ std::make_pair( node.Tag, node.HostWait ) ];
+        summary.Nodes++;
+        if( pathNS[i] != UINT64_MAX )
+        {
+            summary.OnPath++;
+            summary.OnPathNS += pathNS[i];
+            results.PathBusyNS += pathNS[i];
+        }
+        else
+        {
+            summary.MinSlackNS = std::min( summary.MinSlackNS, slack[i] );
+            summary.TotalSlackNS += slack[i];
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// This class records a dependency graph of OpenCL commands and blocking host
+// waits, and computes the critical path through the graph and the slack of
+// every node that is not on the critical path.  Commands are identified by
+// their enqueue counter.  The edges of the graph are:
+//  - Explicit event wait lists.
+//  - The previous command in the same in-order command queue.
+//  - The events or command queue that a blocking host wait waited for.
+//  - The most recent blocking host wait, for the first command enqueued to
+//    each command queue after the host wait.
+// Since commands are recorded in the order they are enqueued, the graph is
+// always in topological order.  Commands without device timestamps, for
+// example because they were not sampled, are not included in the analysis.
+// This class is not thread safe.
+class CCriticalPath
+{
+public:
+    struct SNodeSummary
+    {
+        uint64_t    Nodes = 0;
+        uint64_t    OnPath = 0;
+        uint64_t    OnPathNS = 0;
+        uint64_t    MinSlackNS = UINT64_MAX;
+        uint64_t    TotalSlackNS = 0;
+    };
+
+    // The summary for each tag, and whether the nodes are host waits.
+    typedef std::map< std::pair< uint32_t, bool >, SNodeSummary >  CNodeSummaryMap;
+
+    struct SResults
+    {
+        uint64_t    Nodes = 0;
+        uint64_t    Edges = 0;
+
+        uint64_t    PathNodes = 0;
+        uint64_t    PathStartNS = 0;
+        uint64_t    PathEndNS = 0;
+        uint64_t    PathBusyNS = 0;
+
+        CNodeSummaryMap Summaries;
+    };
+
+    CCriticalPath();
+
+    // Sets the maximum number of commands and host waits to record.  Once
+    // the maximum is reached, additional nodes are dropped.
+    void    init( size_t maxNodes );
+
+    bool    empty() const
+    {
+        return m_Nodes.empty();
+    }
+    uint64_t    droppedNodes() const
+    {
+        return m_DroppedNodes;
+    }
+
+    // Adds the explicit dependencies of a command after the command has
+    // been added.  Dependencies of a command that was not added are ignored.
+    void    addCommandDependencies(
+                uint64_t enqueueCounter,
+                const uint64_t* pPredecessors,
+                size_t numPredecessors );
+    void    addCommand(
+                uint64_t enqueueCounter,
+                uint32_t tag,
+                unsigned int queueNumber,
+                bool inOrder );
+    void    setCommandTime(
+                uint64_t enqueueCounter,
+                uint64_t startNS,
+                uint64_t endNS );
+
+    void    addHostWait(
+                uint32_t tag,
+                uint64_t startNS,
+                uint64_t endNS,
+                const uint64_t* pPredecessors,
+                size_t numPredecessors );
+    void    addQueueHostWait(
+                uint32_t tag,
+                uint64_t startNS,
+                uint64_t endNS,
+                unsigned int queueNumber );
+
+    void    analyze( SResults& results ) const;
+
+private:
+    typedef uint32_t    NodeIndex;
+    static const NodeIndex  cInvalidNode = UINT32_MAX;
+
+    struct SNode
+    {
+        uint32_t    Tag = 0;
+        bool        HostWait = false;
+        bool        HasTime = false;
+        uint64_t    StartNS = 0;
+        uint64_t    EndNS = 0;
+
+        std::vector<NodeIndex>  Predecessors;
+    };
+
+    size_t  m_MaxNodes;
+    uint64_t    m_DroppedNodes;
+
+    std::vector<SNode>  m_Nodes;
+
+    typedef std::unordered_map< uint64_t, NodeIndex >   CCommandNodeMap;
+    CCommandNodeMap m_CommandNodeMap;
+
+    // The most recent command in each command queue.
+    typedef std::unordered_map< unsigned int, NodeIndex >   CQueueNodeMap;
+    CQueueNodeMap   m_QueueLastNode;
+
+    NodeIndex   m_LastHostWait;
+
+    NodeIndex   newNode();
+    NodeIndex   getCommandNode( uint64_t enqueueCounter );
+    NodeIndex   findCommandNode( uint64_t enqueueCounter ) const;
+    void        addEdge( NodeIndex from, NodeIndex to );
+};
@@ -2851,6 +2851,13 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clSetKernelArg)(
 
     if( pIntercept && pIntercept->dispatch().clSetKernelArg )
     {
+        FAST_PATH_PASS_THROUGH(
+            clSetKernelArg,
+            kernel,
+            arg_index,
+            arg_size,
+            arg_value );
+
         GET_ENQUEUE_COUNTER();
 
         std::string argsString;
@@ -3033,6 +3040,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clWaitForEvents)(
         CALL_LOGGING_ENTER( "event_list = %s",
             eventList.c_str() );
         CHECK_EVENT_LIST( num_events, event_list, NULL );
+        CRITICAL_PATH_HOST_WAIT_START();
         HOST_PERFORMANCE_TIMING_START();
 
         cl_int  retVal = pIntercept->dispatch().clWaitForEvents(
@@ -3040,6 +3048,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clWaitForEvents)(
             event_list );
 
         HOST_PERFORMANCE_TIMING_END();
+        CRITICAL_PATH_WAIT_FOR_EVENTS( num_events, event_list );
         CHECK_ERROR( retVal );
         CALL_LOGGING_EXIT( retVal );
         DEVICE_PERFORMANCE_TIMING_CHECK();
@@ -3334,12 +3343,14 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clFinish)(
     {
         GET_ENQUEUE_COUNTER();
         CALL_LOGGING_ENTER( "queue = %p", command_queue );
+        CRITICAL_PATH_HOST_WAIT_START();
         HOST_PERFORMANCE_TIMING_START();
 
         cl_int  retVal = pIntercept->dispatch().clFinish(
             command_queue );
 
         HOST_PERFORMANCE_TIMING_END();
+        CRITICAL_PATH_FINISH( command_queue );
         CHECK_ERROR( retVal );
         CALL_LOGGING_EXIT( retVal );
         DEVICE_PERFORMANCE_TIMING_CHECK();
@@ -3368,6 +3379,18 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueReadBuffer)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueReadBuffer )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueReadBuffer,
+            command_queue,
+            buffer,
+            blocking_read,
+            offset,
+            cb,
+            ptr,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -3391,7 +3414,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueReadBuffer)(
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_BLOCKING( blocking_read, cb );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             ITT_ADD_PARAM_AS_METADATA( blocking_read );
@@ -3425,6 +3448,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueReadBuffer)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -3465,6 +3489,23 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueReadBufferRect)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueReadBufferRect )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueReadBufferRect,
+            command_queue,
+            buffer,
+            blocking_read,
+            buffer_origin,
+            host_origin,
+            region,
+            buffer_row_pitch,
+            buffer_slice_pitch,
+            host_row_pitch,
+            host_slice_pitch,
+            ptr,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -3501,7 +3542,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueReadBufferRect)(
             }
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_BLOCKING( blocking_read, region ? region[0] * region[1] * region[2] : 0 );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             ITT_ADD_PARAM_AS_METADATA( blocking_read );
@@ -3524,6 +3565,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueReadBufferRect)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -3558,6 +3600,18 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueWriteBuffer)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueWriteBuffer )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueWriteBuffer,
+            command_queue,
+            buffer,
+            blocking_write,
+            offset,
+            cb,
+            ptr,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -3581,7 +3635,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueWriteBuffer)(
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_BLOCKING( blocking_write, cb );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             ITT_ADD_PARAM_AS_METADATA( blocking_write );
@@ -3615,6 +3669,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueWriteBuffer)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -3655,6 +3710,23 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueWriteBufferRect)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueWriteBufferRect )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueWriteBufferRect,
+            command_queue,
+            buffer,
+            blocking_write,
+            buffer_origin,
+            host_origin,
+            region,
+            buffer_row_pitch,
+            buffer_slice_pitch,
+            host_row_pitch,
+            host_slice_pitch,
+            ptr,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -3691,7 +3763,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueWriteBufferRect)(
             }
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_BLOCKING( blocking_write, region ? region[0] * region[1] * region[2] : 0 );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             ITT_ADD_PARAM_AS_METADATA( blocking_write );
@@ -3714,6 +3786,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueWriteBufferRect)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -3749,6 +3822,18 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueFillBuffer)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueFillBuffer )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueFillBuffer,
+            command_queue,
+            buffer,
+            pattern,
+            pattern_size,
+            offset,
+            size,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -3770,7 +3855,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueFillBuffer)(
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_BLOCKING( CL_FALSE, size );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueFillBuffer(
@@ -3786,6 +3871,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueFillBuffer)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -3818,6 +3904,18 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyBuffer)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueCopyBuffer )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueCopyBuffer,
+            command_queue,
+            src_buffer,
+            dst_buffer,
+            src_offset,
+            dst_offset,
+            cb,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -3840,7 +3938,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyBuffer)(
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_BLOCKING( CL_FALSE, cb );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             if( pIntercept->config().OverrideCopyBuffer )
@@ -3872,6 +3970,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyBuffer)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -3909,6 +4008,22 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyBufferRect)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueCopyBufferRect )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueCopyBufferRect,
+            command_queue,
+            src_buffer,
+            dst_buffer,
+            src_origin,
+            dst_origin,
+            region,
+            src_row_pitch,
+            src_slice_pitch,
+            dst_row_pitch,
+            dst_slice_pitch,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -3943,7 +4058,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyBufferRect)(
             }
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_BLOCKING( CL_FALSE, region ? region[0] * region[1] * region[2] : 0 );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueCopyBufferRect(
@@ -3963,6 +4078,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyBufferRect)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -3997,6 +4113,20 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueReadImage)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueReadImage )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueReadImage,
+            command_queue,
+            image,
+            blocking_read,
+            origin,
+            region,
+            row_pitch,
+            slice_pitch,
+            ptr,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -4034,7 +4164,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueReadImage)(
             }
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_BLOCKING( blocking_read, 0 );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             ITT_ADD_PARAM_AS_METADATA( blocking_read );
@@ -4072,6 +4202,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueReadImage)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -4108,6 +4239,20 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueWriteImage)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueWriteImage )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueWriteImage,
+            command_queue,
+            image,
+            blocking_write,
+            origin,
+            region,
+            input_row_pitch,
+            input_slice_pitch,
+            ptr,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -4129,7 +4274,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueWriteImage)(
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_BLOCKING( blocking_write, 0 );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             ITT_ADD_PARAM_AS_METADATA( blocking_write );
@@ -4167,6 +4312,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueWriteImage)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -4201,6 +4347,17 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueFillImage)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueFillImage )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueFillImage,
+            command_queue,
+            image,
+            fill_color,
+            origin,
+            region,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -4218,7 +4375,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueFillImage)(
                 image,
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueFillImage(
@@ -4233,6 +4390,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueFillImage)(
 
             HOST_PERFORMANCE_TIMING_END();
             DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -4265,6 +4423,18 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyImage)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueCopyImage )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueCopyImage,
+            command_queue,
+            src_image,
+            dst_image,
+            src_origin,
+            dst_origin,
+            region,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -4283,7 +4453,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyImage)(
                 dst_image,
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             if( pIntercept->config().OverrideCopyImage )
@@ -4315,6 +4485,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyImage)(
 
             HOST_PERFORMANCE_TIMING_END();
             DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -4365,7 +4536,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyImageToBuffer)(
                 dst_buffer,
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueCopyImageToBuffer(
@@ -4381,6 +4552,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyImageToBuffer)(
 
             HOST_PERFORMANCE_TIMING_END();
             DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -4431,7 +4603,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyBufferToImage)(
                 dst_image,
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueCopyBufferToImage(
@@ -4447,6 +4619,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueCopyBufferToImage)(
 
             HOST_PERFORMANCE_TIMING_END();
             DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -4517,7 +4690,7 @@ CL_API_ENTRY void* CL_API_CALL CLIRN(clEnqueueMapBuffer)(
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             CHECK_ERROR_INIT( errcode_ret );
             GET_TIMING_TAGS_MAP( blocking_map, map_flags, cb );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             ITT_ADD_PARAM_AS_METADATA( blocking_map );
@@ -4536,6 +4709,7 @@ CL_API_ENTRY void* CL_API_CALL CLIRN(clEnqueueMapBuffer)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             DUMP_BUFFER_AFTER_MAP( command_queue, buffer, blocking_map, map_flags, retVal, offset, cb );
             CHECK_ERROR( errcode_ret[0] );
             ADD_MAP_POINTER( retVal, map_flags, cb );
@@ -4641,7 +4815,7 @@ CL_API_ENTRY void* CL_API_CALL CLIRN(clEnqueueMapImage)(
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             CHECK_ERROR_INIT( errcode_ret );
             GET_TIMING_TAGS_MAP( blocking_map, map_flags, 0 );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             ITT_ADD_PARAM_AS_METADATA( blocking_map );
@@ -4662,6 +4836,7 @@ CL_API_ENTRY void* CL_API_CALL CLIRN(clEnqueueMapImage)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( errcode_ret[0] );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             if( pIntercept->config().CallLogging )
@@ -4739,7 +4914,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueUnmapMemObject)(
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_UNMAP( mapped_ptr );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueUnmapMemObject(
@@ -4752,6 +4927,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueUnmapMemObject)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             REMOVE_MAP_PTR( mapped_ptr );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
@@ -4813,7 +4989,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueMigrateMemObjects)(
                 flags,
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueMigrateMemObjects(
@@ -4827,6 +5003,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueMigrateMemObjects)(
 
             HOST_PERFORMANCE_TIMING_END();
             DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -4858,6 +5035,18 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueNDRangeKernel)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueNDRangeKernel )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueNDRangeKernel,
+            command_queue,
+            kernel,
+            work_dim,
+            global_work_offset,
+            global_work_size,
+            local_work_size,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -4917,7 +5106,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueNDRangeKernel)(
                 global_work_offset,
                 global_work_size,
                 local_work_size );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
 //            ITT_ADD_PARAM_AS_METADATA(command_queue);
@@ -4969,6 +5158,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueNDRangeKernel)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_KERNEL( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -4999,6 +5189,14 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueTask)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueTask )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueTask,
+            command_queue,
+            kernel,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -5019,7 +5217,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueTask)(
                 eventWaitListString.c_str());
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_KERNEL( command_queue, kernel, 0, NULL, NULL, NULL );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueTask(
@@ -5031,6 +5229,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueTask)(
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_KERNEL( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -5074,7 +5273,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueNativeKernel)(
             CALL_LOGGING_ENTER( "queue = %p",
                 command_queue );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueNativeKernel(
@@ -5091,6 +5290,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueNativeKernel)(
 
             HOST_PERFORMANCE_TIMING_END();
             DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -5125,7 +5325,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueMarker)(
         {
             CALL_LOGGING_ENTER( "queue = %p",
                 command_queue );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueMarker(
@@ -5254,6 +5454,13 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueMarkerWithWaitList)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueMarkerWithWaitList )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueMarkerWithWaitList,
+            command_queue,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -5307,6 +5514,13 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueBarrierWithWaitList)(
 
     if( pIntercept && pIntercept->dispatch().clEnqueueBarrierWithWaitList )
     {
+        FAST_PATH_PASS_THROUGH_ENQUEUE(
+            clEnqueueBarrierWithWaitList,
+            command_queue,
+            num_events_in_wait_list,
+            event_wait_list,
+            event );
+
         cl_int  retVal = CL_SUCCESS;
 
         INCREMENT_ENQUEUE_COUNTER();
@@ -5541,7 +5755,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueWaitSemaphoresKHR(
                     semaphoreString.c_str(),
                     eventWaitListString.c_str() );
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueWaitSemaphoresKHR(
@@ -5555,6 +5769,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueWaitSemaphoresKHR(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -5614,7 +5829,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueSignalSemaphoresKHR(
                     semaphoreString.c_str(),
                     eventWaitListString.c_str() );
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueSignalSemaphoresKHR(
@@ -5628,6 +5843,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueSignalSemaphoresKHR(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -6223,7 +6439,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueAcquireGLObjects)(
                 num_objects,
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueAcquireGLObjects(
@@ -6236,6 +6452,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueAcquireGLObjects)(
 
             HOST_PERFORMANCE_TIMING_END();
             DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -6290,7 +6507,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueReleaseGLObjects)(
                 num_objects,
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueReleaseGLObjects(
@@ -6303,6 +6520,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueReleaseGLObjects)(
 
             HOST_PERFORMANCE_TIMING_END();
             DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -6432,7 +6650,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueSVMFree) (
                 num_svm_pointers,
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueSVMFree(
@@ -6447,6 +6665,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueSVMFree) (
 
             HOST_PERFORMANCE_TIMING_END();
             DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             // TODO: REMOVE_SVM_ALLOCATIONS?
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
@@ -6502,7 +6721,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueSVMMemcpy) (
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_BLOCKING( blocking_copy, size );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueSVMMemcpy(
@@ -6517,6 +6736,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueSVMMemcpy) (
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -6571,7 +6791,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueSVMMemFill) (
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_BLOCKING( CL_FALSE, size );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueSVMMemFill(
@@ -6586,6 +6806,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueSVMMemFill) (
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -6640,7 +6861,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueSVMMap) (
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
             GET_TIMING_TAGS_MAP( blocking_map, map_flags, size );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueSVMMap(
@@ -6655,6 +6876,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueSVMMap) (
 
             HOST_PERFORMANCE_TIMING_END_WITH_TAG();
             DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_MAP_POINTER( svm_ptr, map_flags, size );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
@@ -6704,7 +6926,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueSVMUnmap) (
                 svm_ptr,
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueSVMUnmap(
@@ -6716,6 +6938,7 @@ CL_API_ENTRY cl_int CL_API_CALL CLIRN(clEnqueueSVMUnmap) (
 
             HOST_PERFORMANCE_TIMING_END();
             DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             REMOVE_MAP_PTR( svm_ptr );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
@@ -7509,7 +7732,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueSVMMigrateMem(
                 flags,
                 eventWaitListString.c_str() );
             CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-            DEVICE_PERFORMANCE_TIMING_START( event );
+            DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
             HOST_PERFORMANCE_TIMING_START();
 
             retVal = pIntercept->dispatch().clEnqueueSVMMigrateMem(
@@ -7524,6 +7747,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueSVMMigrateMem(
 
             HOST_PERFORMANCE_TIMING_END();
             DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+            CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
             CHECK_ERROR( retVal );
             ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
             CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -7565,7 +7789,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueAcquireExternalMemObjectsKHR(
             {
                 CALL_LOGGING_ENTER();
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueAcquireExternalMemObjectsKHR(
@@ -7578,6 +7802,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueAcquireExternalMemObjectsKHR(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -7621,7 +7846,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueReleaseExternalMemObjectsKHR(
             {
                 CALL_LOGGING_ENTER();
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueReleaseExternalMemObjectsKHR(
@@ -7634,6 +7859,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueReleaseExternalMemObjectsKHR(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -7954,7 +8180,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueAcquireD3D10ObjectsKHR(
             {
                 CALL_LOGGING_ENTER();
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueAcquireD3D10ObjectsKHR(
@@ -7967,6 +8193,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueAcquireD3D10ObjectsKHR(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -8010,7 +8237,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueReleaseD3D10ObjectsKHR(
             {
                 CALL_LOGGING_ENTER();
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueReleaseD3D10ObjectsKHR(
@@ -8023,6 +8250,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueReleaseD3D10ObjectsKHR(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -8259,7 +8487,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueAcquireD3D11ObjectsKHR(
             {
                 CALL_LOGGING_ENTER();
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueAcquireD3D11ObjectsKHR(
@@ -8272,6 +8500,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueAcquireD3D11ObjectsKHR(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -8315,7 +8544,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueReleaseD3D11ObjectsKHR(
             {
                 CALL_LOGGING_ENTER();
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueReleaseD3D11ObjectsKHR(
@@ -8328,6 +8557,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueReleaseD3D11ObjectsKHR(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -8476,7 +8706,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueAcquireDX9MediaSurfacesKHR(
             {
                 CALL_LOGGING_ENTER();
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueAcquireDX9MediaSurfacesKHR(
@@ -8489,6 +8719,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueAcquireDX9MediaSurfacesKHR(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -8532,7 +8763,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueReleaseDX9MediaSurfacesKHR(
             {
                 CALL_LOGGING_ENTER();
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueReleaseDX9MediaSurfacesKHR(
@@ -8545,6 +8776,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueReleaseDX9MediaSurfacesKHR(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -8693,7 +8925,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueAcquireDX9ObjectsINTEL(
             {
                 CALL_LOGGING_ENTER();
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueAcquireDX9ObjectsINTEL(
@@ -8706,6 +8938,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueAcquireDX9ObjectsINTEL(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -8749,7 +8982,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueReleaseDX9ObjectsINTEL(
             {
                 CALL_LOGGING_ENTER();
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueReleaseDX9ObjectsINTEL(
@@ -8762,6 +8995,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueReleaseDX9ObjectsINTEL(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -9661,7 +9895,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueAcquireVA_APIMediaSurfacesINTEL(
             {
                 CALL_LOGGING_ENTER();
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueAcquireVA_APIMediaSurfacesINTEL(
@@ -9674,6 +9908,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueAcquireVA_APIMediaSurfacesINTEL(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -9717,7 +9952,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueReleaseVA_APIMediaSurfacesINTEL(
             {
                 CALL_LOGGING_ENTER();
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueReleaseVA_APIMediaSurfacesINTEL(
@@ -9730,6 +9965,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueReleaseVA_APIMediaSurfacesINTEL(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -10405,7 +10641,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueMemsetINTEL(   // Deprecated
                     eventWaitListString.c_str() );
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
                 GET_TIMING_TAGS_MEMFILL( queue, dst_ptr, size );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueMemsetINTEL(
@@ -10419,6 +10655,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueMemsetINTEL(   // Deprecated
 
                 HOST_PERFORMANCE_TIMING_END_WITH_TAG();
                 DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -10475,7 +10712,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueMemFillINTEL(
                     eventWaitListString.c_str() );
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
                 GET_TIMING_TAGS_MEMFILL( queue, dst_ptr, size );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueMemFillINTEL(
@@ -10490,6 +10727,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueMemFillINTEL(
 
                 HOST_PERFORMANCE_TIMING_END_WITH_TAG();
                 DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -10547,7 +10785,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueMemcpyINTEL(
                     eventWaitListString.c_str() );
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
                 GET_TIMING_TAGS_MEMCPY( queue, blocking, dst_ptr, src_ptr, size );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueMemcpyINTEL(
@@ -10562,6 +10800,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueMemcpyINTEL(
 
                 HOST_PERFORMANCE_TIMING_END_WITH_TAG();
                 DEVICE_PERFORMANCE_TIMING_END_WITH_TAG( queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT_WITH_TAG( retVal, event );
@@ -10619,7 +10858,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueMigrateMemINTEL(
                     flags,
                     eventWaitListString.c_str() );
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueMigrateMemINTEL(
@@ -10633,6 +10872,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueMigrateMemINTEL(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -10688,7 +10928,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueMemAdviseINTEL(
                     advice,
                     eventWaitListString.c_str() );
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueMemAdviseINTEL(
@@ -10702,6 +10942,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueMemAdviseINTEL(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
@@ -10940,7 +11181,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueCommandBufferKHR(
                     command_buffer,
                     eventWaitListString.c_str() );
                 CHECK_EVENT_LIST( num_events_in_wait_list, event_wait_list, event );
-                DEVICE_PERFORMANCE_TIMING_START( event );
+                DEVICE_PERFORMANCE_TIMING_START( command_queue, event );
                 HOST_PERFORMANCE_TIMING_START();
 
                 retVal = dispatchX.clEnqueueCommandBufferKHR(
@@ -10953,6 +11194,7 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueCommandBufferKHR(
 
                 HOST_PERFORMANCE_TIMING_END();
                 DEVICE_PERFORMANCE_TIMING_END( command_queue, retVal, event );
+                CRITICAL_PATH_ADD_DEPENDENCIES( num_events_in_wait_list, event_wait_list );
                 CHECK_ERROR( retVal );
                 ADD_OBJECT_ALLOCATION_EVENT( retVal, event );
                 CALL_LOGGING_EXIT_EVENT( retVal, event );
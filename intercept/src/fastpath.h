@@ -0,0 +1,32 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+// This file lists the entry points that have a pass-through fast path, and
+// the features that may apply to each entry point.  When none of the
+// features that apply to an entry point are enabled, the entry point calls
+// directly into the OpenCL implementation.
+
+#ifndef CLI_FAST_PATH_ENTRY_POINT
+#error Must define CLI_FAST_PATH_ENTRY_POINT before including this file!
+#endif
+
+CLI_FAST_PATH_ENTRY_POINT( clSetKernelArg,              cFeatureMaskKernelArgs )
+
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueReadBuffer,         cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueReadBufferRect,     cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueWriteBuffer,        cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueWriteBufferRect,    cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueFillBuffer,         cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueCopyBuffer,         cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueCopyBufferRect,     cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueReadImage,          cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueWriteImage,         cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueFillImage,          cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueCopyImage,          cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueNDRangeKernel,      cFeatureMaskKernelEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueTask,               cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueMarkerWithWaitList, cFeatureMaskEnqueue )
+CLI_FAST_PATH_ENTRY_POINT( clEnqueueBarrierWithWaitList, cFeatureMaskEnqueue )
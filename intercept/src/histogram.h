@@ -0,0 +1,123 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// This is a log-linear histogram with a fixed amount of memory, similar to
+// an HDR histogram.  Each power of two is split into 2^SubBucketBits linear
+// buckets, so a percentile estimated from the histogram is within
+// 1 / 2^SubBucketBits of the actual value.  Values that are 2^ValueBits or
+// larger are counted in the last bucket.  This class is not thread safe.
+template<uint32_t SubBucketBits, uint32_t ValueBits>
+class CLogLinearHistogram
+{
+public:
+    static const uint32_t   cSubBuckets = 1 << SubBucketBits;
+    static const uint32_t   cNumBuckets = ( ValueBits - SubBucketBits + 1 ) * cSubBuckets;
+
+    CLogLinearHistogram()
+    {
+        for( uint32_t i = 0; i < cNumBuckets; i++ )
+        {
+            m_Buckets[i] = 0;
+        }
+    }
+
+    void    add( uint64_t value )
+    {
+        m_Buckets[ bucketIndex( value ) ]++;
+    }
+
+    void    add( const CLogLinearHistogram& other )
+    {
+        for( uint32_t i = 0; i < cNumBuckets; i++ )
+        {
+            m_Buckets[i] += other.m_Buckets[i];
+        }
+    }
+
+    uint64_t    bucketCount( uint32_t index ) const
+    {
+        return m_Buckets[index];
+    }
+
+    // Gets an upper bound for the value at the given percentile, given the
+    // total number of values in the histogram.
+    uint64_t    percentile( double percent, uint64_t count ) const
+    {
+        uint64_t    target = (uint64_t)( percent / 100.0 * count + 0.5 );
+        if( target == 0 )
+        {
+            target = 1;
+        }
+        uint64_t    seen = 0;
+        uint32_t    index = 0;
+        for( ; index < cNumBuckets - 1; index++ )
+        {
+            seen += m_Buckets[index];
+            if( seen >= target )
+            {
+                break;
+            }
+        }
+        return bucketUpperBound( index );
+    }
+
+    static uint32_t floorLog2( uint64_t value )
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll( value );
+#else
+        uint32_t    result = 0;
+        while( value >>= 1 )
+        {
+            result++;
+        }
+        return result;
+#endif
+    }
+
+    static uint32_t bucketIndex( uint64_t value )
+    {
+        if( value < cSubBuckets )
+        {
+            return (uint32_t)value;
+        }
+        if( ValueBits < 64 && ( value >> ( ValueBits % 64 ) ) != 0 )
+        {
+            return cNumBuckets - 1;
+        }
+        const uint32_t  msb = floorLog2( value );
+        const uint32_t  sub = (uint32_t)( value >> ( msb - SubBucketBits ) ) & ( cSubBuckets - 1 );
+        return ( msb - SubBucketBits + 1 ) * cSubBuckets + sub;
+    }
+
+    static uint64_t bucketLowerBound( uint32_t index )
+    {
+        if( index < cSubBuckets )
+        {
+            return index;
+        }
+        const uint32_t  shift = index / cSubBuckets - 1;
+        const uint64_t  sub = index % cSubBuckets;
+        return ( cSubBuckets + sub ) << shift;
+    }
+
+    static uint64_t bucketUpperBound( uint32_t index )
+    {
+        if( index < cSubBuckets )
+        {
+            return index;
+        }
+        const uint32_t  shift = index / cSubBuckets - 1;
+        return bucketLowerBound( index ) + ( ( (uint64_t)1 << shift ) - 1 );
+    }
+
+private:
+    uint64_t    m_Buckets[cNumBuckets];
+};
@@ -5,6 +5,7 @@
 */
 
 #include <algorithm>
+#include <cmath>
 #include <errno.h>
 #include <fstream>
 #include <iostream>
@@ -90,9 +91,15 @@ static inline uint64_t Hash(
 const char* CLIntercept::sc_URL = "https://github.com/intel/opencl-intercept-layer";
 const char* CLIntercept::sc_DumpDirectoryName = "CLIntercept_Dump";
 const char* CLIntercept::sc_ReportFileName = "clintercept_report.txt";
+const char* CLIntercept::sc_ReportJSONFileName = "clintercept_report.json";
 const char* CLIntercept::sc_LogFileName = "clintercept_log.txt";
 const char* CLIntercept::sc_PerfCountersFileNamePrefix = "clintercept_perfcounter";
 const char* CLIntercept::sc_TraceFileName = "clintercept_trace.json";
+const char* CLIntercept::sc_BinaryTraceFileName = "clintercept_trace.bin";
+const char* CLIntercept::sc_PerfettoTraceFileName = "clintercept_trace.pftrace";
+
+std::atomic<bool>       CLIntercept::s_TimingEventCallbacksEnabled( true );
+std::atomic<uint32_t>   CLIntercept::s_ActiveTimingEventCallbacks( 0 );
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -137,6 +144,12 @@ CLIntercept::CLIntercept( void* pGlobalData )
     m_LoggedCLInfo = false;
 
     m_EnqueueCounter.store(0, std::memory_order_relaxed);
+    m_CompletedTimingEvents.store(NULL, std::memory_order_relaxed);
+    m_NumPendingTimingEvents.store(0, std::memory_order_relaxed);
+    m_PeakPendingTimingEvents.store(0, std::memory_order_relaxed);
+    m_PendingTimingEventHarvests.store(0, std::memory_order_relaxed);
+    m_DroppedTimingEvents.store(0, std::memory_order_relaxed);
+    m_DownsampledTimingEvents.store(0, std::memory_order_relaxed);
 
     m_EventsChromeTraced = 0;
     m_ProgramNumber = 0;
@@ -158,6 +171,16 @@ CLIntercept::CLIntercept( void* pGlobalData )
 
     m_CommandBufferNumber = 0;
 
+    m_ReporterExit = false;
+    m_ReportRequested = false;
+
+    m_ThreadCount = 0;
+
+    for( auto& features : m_FastPathFeatures )
+    {
+        features = ~0U;
+    }
+
 #define CLI_CONTROL( _type, _name, _init, _desc )   m_Config . _name = _init;
 #include "controls.h"
 #undef CLI_CONTROL
@@ -179,13 +202,39 @@ CLIntercept::CLIntercept( void* pGlobalData )
 //
 CLIntercept::~CLIntercept()
 {
+    stopReporterThread();
     stopAubCapture( NULL );
     report();
 
+    if( m_Config.SelfOverheadProfiling &&
+        ( m_Config.ChromeCallLogging || m_Config.ChromePerformanceTiming ) )
+    {
+        chromeSelfOverheadCounters();
+    }
+
     std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+    std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
 
     log( "CLIntercept is shutting down...\n" );
 
+    // Disable timing event completion callbacks, so any callbacks that are
+    // called after this point do nothing, and wait for any active callbacks
+    // to return.  Then, free the callback info for the events that have not
+    // been processed, including the events that have completed.  The events
+    // themselves cannot be released, for the reasons described below.
+    s_TimingEventCallbacksEnabled.store( false );
+    while( s_ActiveTimingEventCallbacks.load() != 0 )
+    {
+        std::this_thread::yield();
+    }
+    m_CompletedTimingEvents.store( NULL, std::memory_order_relaxed );
+    for( auto pInfo : m_TimingEventCallbacks )
+    {
+        delete pInfo;
+    }
+    m_TimingEventCallbacks.clear();
+
     // Set the dispatch to the dummy dispatch.  The destructor is called
     // as the process is terminating.  We don't know when each DLL gets
     // unloaded, so it's not safe to call into any OpenCL functions in
@@ -267,6 +316,16 @@ CLIntercept::~CLIntercept()
         }
     }
 
+    {
+        CHostTimingThreadStatsList::iterator i = m_HostTimingThreadStatsList.begin();
+        while( i != m_HostTimingThreadStatsList.end() )
+        {
+            delete (*i);
+            (*i) = NULL;
+            ++i;
+        }
+    }
+
     m_ChromeTrace.flush();
 
     log( "... shutdown complete.\n" );
@@ -412,6 +471,7 @@ bool CLIntercept::init()
             fileName = Utils::GetUniqueFileName(fileName);
         }
 
+        std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
         if( m_Config.AppendFiles )
         {
             m_InterceptLog.open(
@@ -433,7 +493,21 @@ bool CLIntercept::init()
 
         OS().GetDumpDirectoryName( sc_DumpDirectoryName, fileName );
         fileName += "/";
-        fileName += sc_TraceFileName;
+        CChromeTracer::Format   format = CChromeTracer::Format::JSON;
+        if( m_Config.ChromeTracePerfetto )
+        {
+            format = CChromeTracer::Format::Perfetto;
+            fileName += sc_PerfettoTraceFileName;
+        }
+        else if( m_Config.ChromeTraceBinary )
+        {
+            format = CChromeTracer::Format::Binary;
+            fileName += sc_BinaryTraceFileName;
+        }
+        else
+        {
+            fileName += sc_TraceFileName;
+        }
 
         OS().MakeDumpDirectories( fileName );
         if( m_Config.UniqueFiles )
@@ -444,12 +518,17 @@ bool CLIntercept::init()
         uint64_t    processId = OS().GetProcessID();
         uint32_t    bufferSize = m_Config.ChromeTraceBufferSize;
         bool        addFlowEvents = m_Config.ChromeFlowEvents;
-        m_ChromeTrace.init( fileName, processId, bufferSize, addFlowEvents );
+        m_ChromeTrace.init( fileName, processId, bufferSize, addFlowEvents, format, &m_StringInterner );
 
         std::string processName = OS().GetProcessName();
         m_ChromeTrace.addProcessMetadata( processName );
     }
 
+    if( m_Config.DevicePerformanceTimingCriticalPath )
+    {
+        m_CriticalPath.init( m_Config.DevicePerformanceTimingCriticalPath );
+    }
+
     std::string name = "";
     OS().GetCLInterceptName( name );
 
@@ -648,6 +727,14 @@ bool CLIntercept::init()
         m_ChromeTrace.addStartTimeMetadata( usStartTime );
     }
 
+    initFastPath();
+
+    if( m_Config.ReportInterval != 0 ||
+        m_Config.ReportIntervalMs != 0 )
+    {
+        startReporterThread();
+    }
+
     log( "... loading complete.\n" );
 
     return true;
@@ -657,7 +744,34 @@ bool CLIntercept::init()
 //
 void CLIntercept::report()
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    if( !m_Config.ReportToStderr &&
+        !m_Config.ReportToFile &&
+        !m_Config.ReportToJSON )
+    {
+        return;
+    }
+
+    // Write the report into memory while holding the locks, so the report
+    // is a consistent snapshot, then write it to stderr or the report file
+    // after releasing the locks.
+    std::ostringstream  ss;
+    std::ostringstream  jsonss;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+        std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+
+        if( m_Config.ReportToStderr || m_Config.ReportToFile )
+        {
+            writeReport( ss );
+        }
+        if( m_Config.ReportToJSON )
+        {
+            writeReportJSON( jsonss );
+        }
+    }
+
+    const std::string   reportString = ss.str();
 
     char    filePath[MAX_PATH] = "";
 
@@ -764,7 +878,7 @@ void CLIntercept::report()
 
     if( m_Config.ReportToStderr )
     {
-        writeReport( std::cerr );
+        std::cerr << reportString;
     }
 
     if( m_Config.ReportToFile )
@@ -784,7 +898,7 @@ void CLIntercept::report()
         }
         if( os.good() )
         {
-            writeReport( os );
+            os << reportString;
             os.close();
         }
         else
@@ -792,6 +906,504 @@ void CLIntercept::report()
             logf( "Failed to open report file for writing: %s\n", filePath );
         }
     }
+
+    if( m_Config.ReportToJSON )
+    {
+        std::string fileName = "";
+
+        OS().GetDumpDirectoryName( sc_DumpDirectoryName, fileName );
+        fileName += "/";
+        fileName += sc_ReportJSONFileName;
+
+        OS().MakeDumpDirectories( fileName );
+        if( m_Config.UniqueFiles )
+        {
+            fileName = Utils::GetUniqueFileName(fileName);
+        }
+
+        // Unlike the text report, each JSON report replaces the previous
+        // report, so the file is always a single valid JSON document.
+        std::ofstream os;
+        os.open(
+            fileName.c_str(),
+            std::ios::out | std::ios::binary );
+        if( os.good() )
+        {
+            os << jsonss.str();
+            os.close();
+        }
+        else
+        {
+            logf( "Failed to open JSON report file for writing: %s\n", fileName.c_str() );
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+static uint32_t getControlFeatures( const char* name )
+{
+    // This table lists the controls that enable a fast path feature, or that
+    // are known not to affect any entry point with a fast path and hence do
+    // not enable any feature.  Controls that only modify the behavior of
+    // another control, such as the CallLogging options or the min and max
+    // enqueue controls, are in the second group, since the primary control
+    // must also be set for them to have an effect.  Any control that is not
+    // in this table enables cFeatureOther.
+    static const struct
+    {
+        const char* Name;
+        uint32_t    Features;
+    } cControlFeatures[] =
+    {
+        { "CallLogging",                            CLIntercept::cFeatureCallLogging },
+        { "ITTCallLogging",                         CLIntercept::cFeatureCallLogging },
+        { "ChromeCallLogging",                      CLIntercept::cFeatureCallLogging },
+        { "ErrorLogging",                           CLIntercept::cFeatureErrorChecking },
+        { "ErrorAssert",                            CLIntercept::cFeatureErrorChecking },
+        { "NoErrors",                               CLIntercept::cFeatureErrorChecking },
+        { "LeakChecking",                           CLIntercept::cFeatureLeakChecking },
+        { "HostPerformanceTiming",                  CLIntercept::cFeatureHostTiming },
+        { "DevicePerformanceTiming",                CLIntercept::cFeatureDeviceTiming },
+        { "ITTPerformanceTiming",                   CLIntercept::cFeatureDeviceTiming },
+        { "ChromePerformanceTiming",                CLIntercept::cFeatureDeviceTiming },
+        { "DevicePerfCounterEventBasedSampling",    CLIntercept::cFeatureDeviceTiming },
+        { "DevicePerfCounterTimeBasedSampling",     CLIntercept::cFeatureDeviceTiming },
+        { "DevicePerfCounterCustom",                CLIntercept::cFeatureDeviceTiming },
+        { "DevicePerfCounterFile",                  CLIntercept::cFeatureDeviceTiming },
+        { "EventChecking",                          CLIntercept::cFeatureEnqueue },
+        { "FinishAfterEnqueue",                     CLIntercept::cFeatureEnqueue },
+        { "FlushAfterEnqueue",                      CLIntercept::cFeatureEnqueue },
+        { "FlushAfterEnqueueBarrier",               CLIntercept::cFeatureEnqueue },
+        { "NullEnqueue",                            CLIntercept::cFeatureEnqueue },
+        { "AubCapture",                             CLIntercept::cFeatureEnqueue },
+        { "DumpArgumentsOnSet",                     CLIntercept::cFeatureKernelEnqueue },
+        { "DumpBuffersBeforeEnqueue",               CLIntercept::cFeatureKernelEnqueue },
+        { "DumpBuffersAfterEnqueue",                CLIntercept::cFeatureKernelEnqueue },
+        { "DumpImagesBeforeEnqueue",                CLIntercept::cFeatureKernelEnqueue },
+        { "DumpImagesAfterEnqueue",                 CLIntercept::cFeatureKernelEnqueue },
+        { "InjectBuffers",                          CLIntercept::cFeatureKernelEnqueue },
+        { "InjectImages",                           CLIntercept::cFeatureKernelEnqueue },
+        { "CaptureReplay",                          CLIntercept::cFeatureKernelEnqueue },
+        { "NullLocalWorkSize",                      CLIntercept::cFeatureKernelEnqueue },
+        { "NullLocalWorkSizeX",                     CLIntercept::cFeatureKernelEnqueue },
+        { "NullLocalWorkSizeY",                     CLIntercept::cFeatureKernelEnqueue },
+        { "NullLocalWorkSizeZ",                     CLIntercept::cFeatureKernelEnqueue },
+        { "OverrideBuiltinKernels",                 CLIntercept::cFeatureKernelEnqueue },
+
+        // Modifiers for other controls:
+        { "CallLoggingEnqueueCounter",              0 },
+        { "CallLoggingThreadId",                    0 },
+        { "CallLoggingThreadNumber",                0 },
+        { "CallLoggingElapsedTime",                 0 },
+        { "ChromeTraceBufferSize",                  0 },
+        { "ChromeTraceBufferingBlockingCallFlush",  0 },
+        { "ChromeFlowEvents",                       0 },
+        { "ChromeTraceBinary",                      0 },
+        { "ChromeTracePerfetto",                    0 },
+        { "ToolOverheadTiming",                     0 },
+        { "SelfOverheadProfiling",                  0 },
+        { "DevicePerformanceTimingHistogram",       0 },
+        { "DevicePerformanceTimingStageStats",      0 },
+        { "DevicePerformanceTimingOccupancy",       0 },
+        { "DevicePerformanceTimingCriticalPath",    0 },
+        { "DevicePerformanceTimeKernelInfoTracking",0 },
+        { "DevicePerformanceTimeGWOTracking",       0 },
+        { "DevicePerformanceTimeGWSTracking",       0 },
+        { "DevicePerformanceTimeLWSTracking",       0 },
+        { "DevicePerformanceTimeSuggestedLWSTracking", 0 },
+        { "DevicePerformanceTimeTransferTracking",  0 },
+        { "DevicePerformanceTimingKernelsOnly",     0 },
+        { "DevicePerformanceTimingSkipUnmap",       0 },
+        { "DevicePerformanceTimingEventCallbacks",  0 },
+        { "DevicePerformanceTimingTimerSyncPeriod", 0 },
+        { "DevicePerformanceTimingMaxPendingEvents", 0 },
+        { "DevicePerformanceTimingPendingEventPolicy", 0 },
+        { "DevicePerformanceTimingSampleInterval",  0 },
+        { "DevicePerformanceTimingSamplesPerSecond", 0 },
+        { "HostPerformanceTimingMinEnqueue",        0 },
+        { "HostPerformanceTimingMaxEnqueue",        0 },
+        { "DevicePerformanceTimingMinEnqueue",      0 },
+        { "DevicePerformanceTimingMaxEnqueue",      0 },
+        { "HostPerformanceTimeLogging",             0 },
+        { "DevicePerformanceTimeLogging",           0 },
+        { "DevicePerformanceTimelineLogging",       0 },
+        { "DevicePerfCounterLibName",               0 },
+        { "DevicePerfCounterAdapterIndex",          0 },
+        { "DevicePerfCounterTiming",                0 },
+        { "DevicePerfCounterReportMax",             0 },
+        { "DevicePerfCounterTimeBasedSamplingPeriod", 0 },
+        { "DevicePerfCounterTimeBasedBufferSize",   0 },
+        { "ITTShowOnlyExecutingEvents",             0 },
+        { "ChromePerformanceTimingInStages",        0 },
+        { "ChromePerformanceTimingPerKernel",       0 },
+        { "ChromePerformanceTimingEstimateQueuedTime", 0 },
+        { "PerformanceTimingConditional",           0 },
+        { "DumpBufferHashes",                       0 },
+        { "DumpImageHashes",                        0 },
+        { "DumpBuffersForKernel",                   0 },
+        { "DumpImagesForKernel",                    0 },
+        { "DumpBuffersMinEnqueue",                  0 },
+        { "DumpBuffersMaxEnqueue",                  0 },
+        { "DumpImagesMinEnqueue",                   0 },
+        { "DumpImagesMaxEnqueue",                   0 },
+        { "DumpArgumentsOnSetMinEnqueue",           0 },
+        { "DumpArgumentsOnSetMaxEnqueue",           0 },
+        { "CaptureReplayMinEnqueue",                0 },
+        { "CaptureReplayMaxEnqueue",                0 },
+        { "CaptureReplayKernelName",                0 },
+        { "CaptureReplayUniqueKernels",             0 },
+        { "CaptureReplayNumKernelEnqueuesSkip",     0 },
+        { "CaptureReplayNumKernelEnqueuesCapture",  0 },
+        { "AubCaptureKDC",                          0 },
+        { "AubCaptureIndividualEnqueues",           0 },
+        { "AubCaptureMinEnqueue",                   0 },
+        { "AubCaptureMaxEnqueue",                   0 },
+        { "AubCaptureKernelName",                   0 },
+        { "AubCaptureKernelGWS",                    0 },
+        { "AubCaptureKernelLWS",                    0 },
+        { "AubCaptureUniqueKernels",                0 },
+        { "AubCaptureNumKernelEnqueuesSkip",        0 },
+        { "AubCaptureNumKernelEnqueuesCapture",     0 },
+        { "AubCaptureStartWait",                    0 },
+        { "AubCaptureEndWait",                      0 },
+        { "ForceByteBufferOverrides",               0 },
+
+        // The enqueue counter is still incremented on the fast path, which
+        // handles these controls:
+        { "ReportInterval",                         0 },
+        { "ExitOnEnqueueCount",                     0 },
+
+        // Controls that do not affect entry points with a fast path:
+        { "BetaExtensionIntercepting",              0 },
+        { "SuppressLogging",                        0 },
+        { "AppendFiles",                            0 },
+        { "LogToFile",                              0 },
+        { "LogToDebugger",                          0 },
+        { "LogIndent",                              0 },
+        { "BuildLogging",                           0 },
+        { "PreferredWorkGroupSizeMultipleLogging",  0 },
+        { "KernelInfoLogging",                      0 },
+        { "ContextCallbackLogging",                 0 },
+        { "ContextHintLevel",                       0 },
+        { "EventCallbackLogging",                   0 },
+        { "QueueInfoLogging",                       0 },
+        { "CLInfoLogging",                          0 },
+        { "FlushFiles",                             0 },
+        { "DumpDir",                                0 },
+        { "AppendPid",                              0 },
+        { "UniqueFiles",                            0 },
+        { "KernelNameHashTracking",                 0 },
+        { "LongKernelNameCutoff",                   0 },
+        { "DemangleKernelNames",                    0 },
+        { "ReportToStderr",                         0 },
+        { "ReportToFile",                           0 },
+        { "ReportToJSON",                           0 },
+        { "ReportIntervalMs",                       0 },
+        { "OmitProgramNumber",                      0 },
+        { "SimpleDumpProgramSource",                0 },
+        { "DumpProgramSourceScript",                0 },
+        { "DumpProgramSource",                      0 },
+        { "DumpInputProgramBinaries",               0 },
+        { "DumpProgramBinaries",                    0 },
+        { "DumpProgramSPIRV",                       0 },
+        { "InjectProgramSource",                    0 },
+        { "InjectProgramBinaries",                  0 },
+        { "RejectProgramBinaries",                  0 },
+        { "InjectProgramSPIRV",                     0 },
+        { "PrependProgramSource",                   0 },
+        { "AppendBuildOptions",                     0 },
+        { "AppendLinkOptions",                      0 },
+        { "DumpProgramBuildLogs",                   0 },
+        { "DumpKernelISABinaries",                  0 },
+        { "AutoCreateSPIRV",                        0 },
+        { "SPIRVClang",                             0 },
+        { "SPIRVCLHeader",                          0 },
+        { "SPIRVDis",                               0 },
+        { "DefaultOptions",                         0 },
+        { "OpenCL2Options",                         0 },
+        { "OmitCommandBufferNumber",                0 },
+        { "DumpCommandBuffers",                     0 },
+        { "DumpBuffersAfterCreate",                 0 },
+        { "AutoPartitionAllDevices",                0 },
+        { "AutoPartitionAllSubDevices",             0 },
+        { "AutoPartitionSingleSubDevice",           0 },
+        { "AutoPartitionByAffinityDomain",          0 },
+        { "AutoPartitionEqually",                   0 },
+        { "NullContextCallback",                    0 },
+        { "InOrderQueue",                           0 },
+        { "NoProfilingQueue",                       0 },
+        { "DummyOutOfOrderQueue",                   0 },
+        { "InitializeBuffers",                      0 },
+        { "DefaultQueuePriorityHint",               0 },
+        { "DefaultQueueThrottleHint",               0 },
+        { "RelaxAllocationLimits",                  0 },
+        { "PlatformName",                           0 },
+        { "PlatformVendor",                         0 },
+        { "PlatformProfile",                        0 },
+        { "PlatformVersion",                        0 },
+        { "DeviceTypeFilter",                       0 },
+        { "DeviceType",                             0 },
+        { "DeviceName",                             0 },
+        { "DeviceVendor",                           0 },
+        { "DeviceProfile",                          0 },
+        { "DeviceVersion",                          0 },
+        { "DeviceCVersion",                         0 },
+        { "DeviceExtensions",                       0 },
+        { "DeviceILVersion",                        0 },
+        { "DeviceVendorID",                         0 },
+        { "DeviceMaxComputeUnits",                  0 },
+        { "DevicePreferredVectorWidthChar",         0 },
+        { "DevicePreferredVectorWidthShort",        0 },
+        { "DevicePreferredVectorWidthInt",          0 },
+        { "DevicePreferredVectorWidthLong",         0 },
+        { "DevicePreferredVectorWidthHalf",         0 },
+        { "DevicePreferredVectorWidthFloat",        0 },
+        { "DevicePreferredVectorWidthDouble",       0 },
+        { "DriverVersion",                          0 },
+        { "PrependDeviceExtensions",                0 },
+    };
+
+    for( const auto& entry : cControlFeatures )
+    {
+        if( strcmp( entry.Name, name ) == 0 )
+        {
+            return entry.Features;
+        }
+    }
+
+    return CLIntercept::cFeatureOther;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::initFastPath()
+{
+    uint32_t    enabledFeatures = 0;
+
+#define CLI_CONTROL( _type, _name, _init, _desc )                   \
+    if ( m_Config . _name != _init ) {                              \
+        enabledFeatures |= getControlFeatures( #_name );            \
+    }
+#include "controls.h"
+#undef CLI_CONTROL
+
+    uint32_t    numFastPathEntryPoints = 0;
+
+#define CLI_FAST_PATH_ENTRY_POINT( _name, _features )               \
+    m_FastPathFeatures[ cFastPath_##_name ] = enabledFeatures & _features; \
+    if( m_FastPathFeatures[ cFastPath_##_name ] == 0 ) {            \
+        numFastPathEntryPoints++;                                   \
+    }
+#include "fastpath.h"
+#undef CLI_FAST_PATH_ENTRY_POINT
+
+    logf( "Enabled fast path for %u of %u entry points.\n",
+        numFastPathEntryPoints,
+        (unsigned int)cNumFastPathEntryPoints );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::startReporterThread()
+{
+    log( "Starting reporter thread.\n" );
+
+    m_ReporterThread = std::thread( &CLIntercept::reporterThread, this );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::stopReporterThread()
+{
+    if( m_ReporterThread.joinable() )
+    {
+        {
+            std::lock_guard<std::mutex> reporterLock(m_ReporterMutex);
+            m_ReporterExit = true;
+        }
+        m_ReporterCondition.notify_one();
+
+        m_ReporterThread.join();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::requestReport()
+{
+    if( m_ReporterThread.joinable() )
+    {
+        {
+            std::lock_guard<std::mutex> reporterLock(m_ReporterMutex);
+            m_ReportRequested = true;
+        }
+        m_ReporterCondition.notify_one();
+    }
+    else
+    {
+        report();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::reporterThread()
+{
+    const std::chrono::milliseconds interval( m_Config.ReportIntervalMs );
+    clock::time_point   nextReportTime = clock::now() + interval;
+
+    std::unique_lock<std::mutex> reporterLock(m_ReporterMutex);
+    while( !m_ReporterExit )
+    {
+        auto    wakeup = [this] { return m_ReporterExit || m_ReportRequested; };
+        if( m_Config.ReportIntervalMs != 0 )
+        {
+            if( !m_ReporterCondition.wait_until( reporterLock, nextReportTime, wakeup ) )
+            {
+                // The wall-clock interval expired.  Schedule the next report
+                // relative to the previous deadline so reports do not drift,
+                // unless reports are taking longer than the interval.
+                nextReportTime += interval;
+                nextReportTime = std::max( nextReportTime, clock::now() );
+            }
+        }
+        else
+        {
+            m_ReporterCondition.wait( reporterLock, wakeup );
+        }
+
+        if( m_ReporterExit )
+        {
+            break;
+        }
+
+        m_ReportRequested = false;
+
+        reporterLock.unlock();
+        report();
+        reporterLock.lock();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// The percentiles that are reported for host and device timing.
+static const double sc_ReportPercentiles[] = { 50.0, 90.0, 99.0, 99.9 };
+static const char*  sc_ReportPercentileNames[] = { "p50", "p90", "p99", "p99.9" };
+
+static uint64_t getPercentile(
+    const CLIntercept::CTimingHistogram& histogram,
+    double percent,
+    uint64_t count,
+    uint64_t minNS,
+    uint64_t maxNS )
+{
+    // The histogram gives an upper bound for the percentile, which may be
+    // larger than the largest time, so clamp it to the measured range.
+    const uint64_t  value = histogram.percentile( percent, count );
+    return std::min( std::max( value, minNS ), maxNS );
+}
+
+static void writePercentileHeaders(
+    std::ostream& os )
+{
+    for( const char* name : sc_ReportPercentileNames )
+    {
+        os << ", " << std::right << std::setw(13) << ( std::string(name) + " (ns)" );
+    }
+}
+
+static void writePercentiles(
+    std::ostream& os,
+    const CLIntercept::CTimingHistogram& histogram,
+    uint64_t count,
+    uint64_t minNS,
+    uint64_t maxNS )
+{
+    for( double percent : sc_ReportPercentiles )
+    {
+        os << ", " << std::right << std::setw(13)
+            << getPercentile( histogram, percent, count, minNS, maxNS );
+    }
+}
+
+static void writeJSONString(
+    std::ostream& os,
+    const std::string& str )
+{
+    os << '"';
+    for( char c : str )
+    {
+        switch( c )
+        {
+        case '"':   os << "\\\""; break;
+        case '\\':  os << "\\\\"; break;
+        case '\n':  os << "\\n"; break;
+        case '\t':  os << "\\t"; break;
+        default:
+            if( (unsigned char)c < 0x20 )
+            {
+                char    buffer[8];
+                CLI_SPRINTF( buffer, sizeof(buffer), "\\u%04x", (unsigned char)c );
+                os << buffer;
+            }
+            else
+            {
+                os << c;
+            }
+            break;
+        }
+    }
+    os << '"';
+}
+
+static void writeJSONTimingStats(
+    std::ostream& os,
+    const std::string& name,
+    uint64_t numberOfCalls,
+    uint64_t totalNS,
+    uint64_t minNS,
+    uint64_t maxNS,
+    const CLIntercept::CTimingHistogram& histogram,
+    bool includeBuckets = false )
+{
+    os << "{\"name\":";
+    writeJSONString( os, name );
+    os << ",\"calls\":" << numberOfCalls
+        << ",\"total_ns\":" << totalNS
+        << ",\"min_ns\":" << minNS
+        << ",\"max_ns\":" << maxNS;
+    for( size_t i = 0; i < sizeof(sc_ReportPercentiles) / sizeof(sc_ReportPercentiles[0]); i++ )
+    {
+        os << ",\"" << sc_ReportPercentileNames[i] << "_ns\":"
+            << getPercentile( histogram, sc_ReportPercentiles[i], numberOfCalls, minNS, maxNS );
+    }
+    if( includeBuckets )
+    {
+        // Only non-empty buckets are written.  The upper bound of the last
+        // bucket is omitted since it counts all larger values.
+        typedef CLIntercept::CTimingHistogram   CHistogram;
+        bool    firstBucket = true;
+        os << ",\"histogram\":[";
+        for( uint32_t b = 0; b < CHistogram::cNumBuckets; b++ )
+        {
+            const uint64_t  count = histogram.bucketCount(b);
+            if( count != 0 )
+            {
+                os << ( firstBucket ? "" : "," )
+                    << "{\"lower_ns\":" << CHistogram::bucketLowerBound(b);
+                if( b != CHistogram::cNumBuckets - 1 )
+                {
+                    os << ",\"upper_ns\":" << CHistogram::bucketUpperBound(b);
+                }
+                os << ",\"count\":" << count << "}";
+                firstBucket = false;
+            }
+        }
+        os << "]";
+    }
+    os << "}";
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -820,6 +1432,12 @@ void CLIntercept::writeReport(
         m_ObjectTracker.writeReport( os );
     }
 
+    if( config().SelfOverheadProfiling )
+    {
+        os << std::endl << "Self Overhead Profiling Results:" << std::endl;
+        m_SelfOverhead.writeReport( os );
+    }
+
     if( !m_LongKernelNameMap.empty() )
     {
         os << std::endl << "Kernel name mapping:" << std::endl;
@@ -838,19 +1456,25 @@ void CLIntercept::writeReport(
         }
     }
 
+    CHostTimingStatsMap hostTimingStatsMap;
+    if( config().HostPerformanceTiming )
+    {
+        getHostTimingStats( hostTimingStatsMap );
+    }
+
     if( config().HostPerformanceTiming &&
-        !m_HostTimingStatsMap.empty() )
+        !hostTimingStatsMap.empty() )
     {
         os << std::endl << "Host Performance Timing Results:" << std::endl;
 
         std::vector<std::string> keys;
-        keys.reserve(m_HostTimingStatsMap.size());
+        keys.reserve(hostTimingStatsMap.size());
 
         uint64_t    totalTotalNS = 0;
         size_t      longestName = 32;
 
-        CHostTimingStatsMap::const_iterator i = m_HostTimingStatsMap.begin();
-        while( i != m_HostTimingStatsMap.end() )
+        CHostTimingStatsMap::const_iterator i = hostTimingStatsMap.begin();
+        while( i != hostTimingStatsMap.end() )
         {
             const std::string& name = (*i).first;
             const SHostTimingStats& hostTimingStats = (*i).second;
@@ -876,11 +1500,13 @@ void CLIntercept::writeReport(
             << std::right << std::setw( 8) << "Time (%)" << ", "
             << std::right << std::setw(13) << "Average (ns)" << ", "
             << std::right << std::setw(13) << "Min (ns)" << ", "
-            << std::right << std::setw(13) << "Max (ns)" << std::endl;
+            << std::right << std::setw(13) << "Max (ns)";
+        writePercentileHeaders( os );
+        os << std::endl;
 
         for( const auto& name : keys )
         {
-            const SHostTimingStats& hostTimingStats = m_HostTimingStatsMap.at(name);
+            const SHostTimingStats& hostTimingStats = hostTimingStatsMap.at(name);
 
             os << std::right << std::setw(longestName) << name << ", "
                 << std::right << std::setw( 6) << hostTimingStats.NumberOfCalls << ", "
@@ -888,7 +1514,14 @@ void CLIntercept::writeReport(
                 << std::right << std::setw( 7) << std::fixed << std::setprecision(2) << hostTimingStats.TotalNS * 100.0f / totalTotalNS << "%, "
                 << std::right << std::setw(13) << hostTimingStats.TotalNS / hostTimingStats.NumberOfCalls << ", "
                 << std::right << std::setw(13) << hostTimingStats.MinNS << ", "
-                << std::right << std::setw(13) << hostTimingStats.MaxNS << std::endl;
+                << std::right << std::setw(13) << hostTimingStats.MaxNS;
+            writePercentiles(
+                os,
+                hostTimingStats.Histogram,
+                hostTimingStats.NumberOfCalls,
+                hostTimingStats.MinNS,
+                hostTimingStats.MaxNS );
+            os << std::endl;
         }
     }
 
@@ -905,7 +1538,7 @@ void CLIntercept::writeReport(
 
             os << std::endl << "Device Performance Timing Results for " << deviceInfo.NameForReport << ":" << std::endl;
 
-            std::vector<std::string> keys;
+            std::vector<CStringInterner::Id> keys;
             keys.reserve(dtsm.size());
 
             cl_ulong    totalTotalNS = 0;
@@ -914,12 +1547,12 @@ void CLIntercept::writeReport(
             CDeviceTimingStatsMap::const_iterator i = dtsm.begin();
             while( i != dtsm.end() )
             {
-                const std::string& name = (*i).first;
+                const std::string& name = m_StringInterner.name( (*i).first );
                 const SDeviceTimingStats& deviceTimingStats = (*i).second;
 
                 if( !name.empty() )
                 {
-                    keys.push_back(name);
+                    keys.push_back((*i).first);
                     totalTotalNS += deviceTimingStats.TotalNS;
                     longestName = std::max< size_t >( name.length(), longestName );
                 }
@@ -927,7 +1560,11 @@ void CLIntercept::writeReport(
                 ++i;
             }
 
-            std::sort(keys.begin(), keys.end());
+            std::sort(keys.begin(), keys.end(),
+                [this]( CStringInterner::Id a, CStringInterner::Id b )
+                {
+                    return m_StringInterner.name(a) < m_StringInterner.name(b);
+                });
 
             os << std::endl << "Total Time (ns): " << totalTotalNS << std::endl;
 
@@ -938,11 +1575,14 @@ void CLIntercept::writeReport(
                 << std::right << std::setw( 8) << "Time (%)" << ", "
                 << std::right << std::setw(13) << "Average (ns)" << ", "
                 << std::right << std::setw(13) << "Min (ns)" << ", "
-                << std::right << std::setw(13) << "Max (ns)" << std::endl;
+                << std::right << std::setw(13) << "Max (ns)";
+            writePercentileHeaders( os );
+            os << std::endl;
 
-            for( const auto& name : keys )
+            for( const auto& key : keys )
             {
-                const SDeviceTimingStats& deviceTimingStats = dtsm.at(name);
+                const std::string& name = m_StringInterner.name(key);
+                const SDeviceTimingStats& deviceTimingStats = dtsm.at(key);
 
                 os << std::right << std::setw(longestName) << name << ", "
                     << std::right << std::setw( 6) << deviceTimingStats.NumberOfCalls << ", "
@@ -950,57 +1590,80 @@ void CLIntercept::writeReport(
                     << std::right << std::setw( 7) << std::fixed << std::setprecision(2) << deviceTimingStats.TotalNS * 100.0f / totalTotalNS << "%, "
                     << std::right << std::setw(13) << deviceTimingStats.TotalNS / deviceTimingStats.NumberOfCalls << ", "
                     << std::right << std::setw(13) << deviceTimingStats.MinNS << ", "
-                    << std::right << std::setw(13) << deviceTimingStats.MaxNS << std::endl;
+                    << std::right << std::setw(13) << deviceTimingStats.MaxNS;
+                writePercentiles(
+                    os,
+                    deviceTimingStats.Histogram,
+                    deviceTimingStats.NumberOfCalls,
+                    deviceTimingStats.MinNS,
+                    deviceTimingStats.MaxNS );
+                os << std::endl;
+            }
+
+            if( m_DeviceTimingSampleMap.find( device ) != m_DeviceTimingSampleMap.end() )
+            {
+                writeDeviceTimingSampleReport( os, device, dtsm, keys, longestName );
+            }
+
+            if( config().DevicePerformanceTimingHistogram )
+            {
+                writeDeviceTimingHistogramReport( os, dtsm, keys );
+            }
+
+            if( config().DevicePerformanceTimingStageStats )
+            {
+                writeDeviceStageTimingReport( os, device, keys, longestName );
+            }
+
+            if( config().DevicePerformanceTimingOccupancy )
+            {
+                writeDeviceOccupancyReport( os, device );
             }
 
             ++id;
         }
     }
 
-    if( config().DevicePerformanceTimingHistogram )
+    if( config().DevicePerformanceTimingCriticalPath &&
+        !m_CriticalPath.empty() )
     {
-        CDeviceTimingHistogramMap::const_iterator id = m_DeviceTimingHistogramMap.begin();
-        while( id != m_DeviceTimingHistogramMap.end() )
-        {
-            const cl_device_id  device = (*id).first;
-            const SDeviceTimingHistogram& histogram = (*id).second;
+        writeCriticalPathReport( os );
+    }
 
-            const SDeviceInfo&  deviceInfo = m_DeviceInfoMap[device];
+    if( config().DevicePerformanceTimingMaxPendingEvents != 0 )
+    {
+        os << std::endl << "Device Performance Timing Pending Events:" << std::endl;
 
-            os << std::endl << "Device Performance Timing Histogram for " << deviceInfo.NameForReport << ":" << std::endl;
+        os << std::endl
+            << "Max Pending Events: " << config().DevicePerformanceTimingMaxPendingEvents << std::endl
+            << "Peak Pending Events: " << m_PeakPendingTimingEvents.load(std::memory_order_relaxed) << std::endl
+            << "Forced Harvests: " << m_PendingTimingEventHarvests.load(std::memory_order_relaxed) << std::endl
+            << "Dropped Events: " << m_DroppedTimingEvents.load(std::memory_order_relaxed) << std::endl
+            << "Downsampled Events: " << m_DownsampledTimingEvents.load(std::memory_order_relaxed) << std::endl;
+    }
 
-            uint32_t total = 0;
-            for( uint32_t bin = 0; bin < SDeviceTimingHistogram::cNumBins; bin++ )
-            {
-                total += histogram.Bins[bin];
-            }
+    if( !m_ClockModelMap.empty() )
+    {
+        // The residuals describe how closely the clock model matches the
+        // most recent timer samples, which bounds the error converting
+        // device timestamps to host time.
+        CClockModelMap::const_iterator id = m_ClockModelMap.begin();
+        while( id != m_ClockModelMap.end() )
+        {
+            const cl_device_id  device = (*id).first;
+            const CClockModel&  clockModel = (*id).second;
 
-            os << std::endl << "Total Events: " << total << std::endl << std::endl;
+            const SDeviceInfo&  deviceInfo = m_DeviceInfoMap[device];
 
-            for( uint32_t bin = 0; bin < SDeviceTimingHistogram::cNumBins; bin++ )
-            {
-                if( bin == SDeviceTimingHistogram::cNumBins - 1 )
-                {
-                    os << " >= ";
-                }
-                else
-                {
-                    os << "  < ";
-                }
-                const uint32_t count = histogram.Bins[bin];
-                os  << std::setw(9) << (1ULL << bin) << " ns: " << std::setw(9) << count << " : ";
+            os << std::endl << "Device Clock Model for " << deviceInfo.NameForReport << ":" << std::endl;
 
-                uint32_t dots = static_cast<uint32_t>( 64.0f * count / total );
-                if( count != 0 && dots == 0 )
-                {
-                    dots++;
-                }
-                for( uint32_t d = 0; d < dots; d++ )
-                {
-                    os << "*";
-                }
-                os << std::endl;
-            }
+            os << std::endl
+                << "Total Samples: " << clockModel.totalSamples() << std::endl
+                << "Window Samples: " << clockModel.windowSamples() << std::endl
+                << "Skew (ppm): " << std::fixed << std::setprecision(3) << clockModel.skewPPM() << std::endl
+                << "RMS Residual (ns): " << std::setprecision(1) << clockModel.rmsResidualNS() << std::endl
+                << "Max Residual (ns): " << clockModel.maxResidualNS() << std::endl
+                << "Worst RMS Residual (ns): " << clockModel.worstRMSResidualNS() << std::endl;
 
             ++id;
         }
@@ -1016,32 +1679,636 @@ void CLIntercept::writeReport(
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-void CLIntercept::addShortKernelName(
-    const std::string& kernelName )
+void CLIntercept::writeReportJSON(
+    std::ostream& os )
 {
-    if( kernelName.length() > m_Config.LongKernelNameCutoff )
+    os << "{\"total_enqueues\":" << m_EnqueueCounter.load(std::memory_order_relaxed);
+
+    if( config().HostPerformanceTiming )
     {
-        std::string shortKernelName("k_");
-        shortKernelName += std::to_string(m_KernelID);
-        m_LongKernelNameMap[ kernelName ] = shortKernelName;
+        CHostTimingStatsMap hostTimingStatsMap;
+        getHostTimingStats( hostTimingStatsMap );
 
-        logf( "Added kernel name mapping: %s to %s\n",
-            kernelName.c_str(),
-            shortKernelName.c_str() );
+        std::vector<std::string> keys;
+        keys.reserve(hostTimingStatsMap.size());
+        for( const auto& it : hostTimingStatsMap )
+        {
+            if( !it.first.empty() )
+            {
+                keys.push_back(it.first);
+            }
+        }
+        std::sort(keys.begin(), keys.end());
 
-        m_KernelID++;
+        os << ",\n\"host_timing\":[";
+        for( size_t i = 0; i < keys.size(); i++ )
+        {
+            const SHostTimingStats& hostTimingStats = hostTimingStatsMap.at(keys[i]);
+
+            os << ( i == 0 ? "\n" : ",\n" );
+            writeJSONTimingStats(
+                os,
+                keys[i],
+                hostTimingStats.NumberOfCalls,
+                hostTimingStats.TotalNS,
+                hostTimingStats.MinNS,
+                hostTimingStats.MaxNS,
+                hostTimingStats.Histogram );
+        }
+        os << "]";
     }
-}
 
-///////////////////////////////////////////////////////////////////////////////
-//
-void CLIntercept::getCallLoggingPrefix(
-    std::string& str )
-{
-    if( m_Config.CallLoggingElapsedTime )
+    if( config().DevicePerformanceTiming )
     {
-        using us = std::chrono::microseconds;
-        uint64_t usDelta =
+        os << ",\n\"device_timing\":[";
+
+        bool    firstDevice = true;
+        for( const auto& id : m_DeviceTimingStatsMap )
+        {
+            const SDeviceInfo&  deviceInfo = m_DeviceInfoMap[id.first];
+            const CDeviceTimingStatsMap& dtsm = id.second;
+
+            std::vector<CStringInterner::Id> keys;
+            keys.reserve(dtsm.size());
+            for( const auto& it : dtsm )
+            {
+                if( !m_StringInterner.name(it.first).empty() )
+                {
+                    keys.push_back(it.first);
+                }
+            }
+            std::sort(keys.begin(), keys.end(),
+                [this]( CStringInterner::Id a, CStringInterner::Id b )
+                {
+                    return m_StringInterner.name(a) < m_StringInterner.name(b);
+                });
+
+            os << ( firstDevice ? "\n" : ",\n" ) << "{\"device\":";
+            writeJSONString( os, deviceInfo.NameForReport );
+            os << ",\"stats\":[";
+            for( size_t i = 0; i < keys.size(); i++ )
+            {
+                const SDeviceTimingStats& deviceTimingStats = dtsm.at(keys[i]);
+
+                os << ( i == 0 ? "\n" : ",\n" );
+                writeJSONTimingStats(
+                    os,
+                    m_StringInterner.name(keys[i]),
+                    deviceTimingStats.NumberOfCalls,
+                    deviceTimingStats.TotalNS,
+                    deviceTimingStats.MinNS,
+                    deviceTimingStats.MaxNS,
+                    deviceTimingStats.Histogram,
+                    config().DevicePerformanceTimingHistogram );
+            }
+            os << "]}";
+
+            firstDevice = false;
+        }
+        os << "]";
+    }
+
+    os << "}\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::writeDeviceTimingSampleReport(
+    std::ostream& os,
+    cl_device_id device,
+    const CDeviceTimingStatsMap& dtsm,
+    const std::vector<CStringInterner::Id>& keys,
+    size_t longestName )
+{
+    // The total device time for each key is estimated as the mean sampled
+    // device time times the number of enqueues.  The confidence interval
+    // uses the normal approximation for the sample mean, with a finite
+    // population correction since the sampled enqueues are a subset of a
+    // known number of enqueues.
+    const double    z95 = 1.96;
+
+    os << std::endl << "Sampled Device Performance Timing Estimates:" << std::endl;
+
+    os << std::endl
+        << std::right << std::setw(longestName) << "Function Name" << ", "
+        << std::right << std::setw(10) << "Enqueues" << ", "
+        << std::right << std::setw(10) << "Sampled" << ", "
+        << std::right << std::setw(16) << "Est. Time (ns)" << ", "
+        << std::right << std::setw(16) << "95% CI (+/- ns)" << std::endl;
+
+    const CDeviceTimingSampleMap&   dtsampm = m_DeviceTimingSampleMap.at( device );
+
+    double  estimatedTotalNS = 0.0;
+    double  estimatedTotalVariance = 0.0;
+    for( const auto& key : keys )
+    {
+        const SDeviceTimingStats& deviceTimingStats = dtsm.at(key);
+
+        const double    sampled = (double)deviceTimingStats.NumberOfCalls;
+        double          enqueues = sampled;
+
+        CDeviceTimingSampleMap::const_iterator  iter = dtsampm.find( key );
+        if( iter != dtsampm.end() )
+        {
+            enqueues = std::max( enqueues, (double)iter->second.Enqueues );
+        }
+
+        const double    estimatedNS = deviceTimingStats.MeanNS * enqueues;
+        double          variance = 0.0;
+        if( deviceTimingStats.NumberOfCalls > 1 )
+        {
+            const double    sampleVariance =
+                deviceTimingStats.M2NS / ( sampled - 1.0 );
+            variance =
+                enqueues * enqueues * sampleVariance / sampled *
+                ( 1.0 - sampled / enqueues );
+        }
+
+        estimatedTotalNS += estimatedNS;
+        estimatedTotalVariance += variance;
+
+        os << std::right << std::setw(longestName) << m_StringInterner.name(key) << ", "
+            << std::right << std::setw(10) << (uint64_t)enqueues << ", "
+            << std::right << std::setw(10) << deviceTimingStats.NumberOfCalls << ", "
+            << std::right << std::setw(16) << (uint64_t)estimatedNS << ", "
+            << std::right << std::setw(16) << (uint64_t)( z95 * std::sqrt( variance ) ) << std::endl;
+    }
+
+    os << std::endl << "Estimated Total Time (ns): " << (uint64_t)estimatedTotalNS
+        << " +/- " << (uint64_t)( z95 * std::sqrt( estimatedTotalVariance ) ) << std::endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::writeDeviceTimingHistogramReport(
+    std::ostream& os,
+    const CDeviceTimingStatsMap& dtsm,
+    const std::vector<CStringInterner::Id>& keys )
+{
+    typedef CTimingHistogram    CHistogram;
+
+    os << std::endl << "Device Performance Timing Histograms:" << std::endl;
+
+    for( const auto& key : keys )
+    {
+        const SDeviceTimingStats& deviceTimingStats = dtsm.at(key);
+        const CHistogram&   histogram = deviceTimingStats.Histogram;
+
+        // Only the range of buckets between the smallest and largest time
+        // is printed.  The bars are scaled to the largest bucket, so
+        // distributions with multiple peaks are easy to see.
+        uint32_t    first = CHistogram::cNumBuckets;
+        uint32_t    last = 0;
+        uint64_t    maxCount = 0;
+        for( uint32_t b = 0; b < CHistogram::cNumBuckets; b++ )
+        {
+            const uint64_t  count = histogram.bucketCount(b);
+            if( count != 0 )
+            {
+                first = std::min( first, b );
+                last = b;
+                maxCount = std::max( maxCount, count );
+            }
+        }
+        if( maxCount == 0 )
+        {
+            continue;
+        }
+
+        os << std::endl << m_StringInterner.name(key)
+            << " (Total Events: " << deviceTimingStats.NumberOfCalls << "):" << std::endl;
+
+        for( uint32_t b = first; b <= last; b++ )
+        {
+            if( b == CHistogram::cNumBuckets - 1 )
+            {
+                os << " >= " << std::setw(13) << CHistogram::bucketLowerBound(b) << "                ";
+            }
+            else
+            {
+                os << "    " << std::setw(13) << CHistogram::bucketLowerBound(b)
+                    << " - " << std::setw(13) << CHistogram::bucketUpperBound(b);
+            }
+
+            const uint64_t  count = histogram.bucketCount(b);
+            os << " ns: " << std::setw(9) << count << " : ";
+
+            uint32_t dots = static_cast<uint32_t>( 64.0 * count / maxCount );
+            if( count != 0 && dots == 0 )
+            {
+                dots++;
+            }
+            for( uint32_t d = 0; d < dots; d++ )
+            {
+                os << "*";
+            }
+            os << std::endl;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+static void writeStageTimingRow(
+    std::ostream& os,
+    const std::string& name,
+    size_t longestName,
+    const char* stage,
+    uint64_t numberOfCalls,
+    uint64_t totalNS,
+    uint64_t minNS,
+    uint64_t maxNS,
+    const CLIntercept::CTimingHistogram& histogram )
+{
+    os << std::right << std::setw(longestName) << name << ", "
+        << std::right << std::setw(16) << stage << ", "
+        << std::right << std::setw( 6) << numberOfCalls << ", "
+        << std::right << std::setw(13) << totalNS / numberOfCalls << ", "
+        << std::right << std::setw(13) << minNS << ", "
+        << std::right << std::setw(13) << maxNS;
+    writePercentiles(
+        os,
+        histogram,
+        numberOfCalls,
+        minNS,
+        maxNS );
+    os << std::endl;
+}
+
+static void writeStageTimingHeader(
+    std::ostream& os,
+    const char* name,
+    size_t longestName )
+{
+    os << std::endl
+        << std::right << std::setw(longestName) << name << ", "
+        << std::right << std::setw(16) << "Stage" << ", "
+        << std::right << std::setw( 6) << "Calls" << ", "
+        << std::right << std::setw(13) << "Average (ns)" << ", "
+        << std::right << std::setw(13) << "Min (ns)" << ", "
+        << std::right << std::setw(13) << "Max (ns)";
+    writePercentileHeaders( os );
+    os << std::endl;
+}
+
+void CLIntercept::writeDeviceStageTimingReport(
+    std::ostream& os,
+    cl_device_id device,
+    const std::vector<CStringInterner::Id>& keys,
+    size_t longestName )
+{
+    // Queued -> submit is the time the driver took to submit the command
+    // to the device, and submit -> start is the time the command waited
+    // for the device once it was submitted.
+    const char* queuedToSubmit = "Queued->Submit";
+    const char* submitToStart = "Submit->Start";
+
+    os << std::endl << "Device Performance Timing Stages:" << std::endl;
+
+    CDeviceDeviceStageTimingStatsMap::const_iterator id =
+        m_DeviceStageTimingStatsMap.find( device );
+    if( id != m_DeviceStageTimingStatsMap.end() )
+    {
+        const CDeviceStageTimingStatsMap& dstsm = (*id).second;
+
+        writeStageTimingHeader( os, "Function Name", longestName );
+
+        for( const auto& key : keys )
+        {
+            CDeviceStageTimingStatsMap::const_iterator i = dstsm.find( key );
+            if( i != dstsm.end() )
+            {
+                const std::string& name = m_StringInterner.name(key);
+                const SDeviceStageTimingStats& stageStats = (*i).second;
+
+                writeStageTimingRow(
+                    os,
+                    name,
+                    longestName,
+                    queuedToSubmit,
+                    stageStats.QueuedToSubmit.NumberOfCalls,
+                    stageStats.QueuedToSubmit.TotalNS,
+                    stageStats.QueuedToSubmit.MinNS,
+                    stageStats.QueuedToSubmit.MaxNS,
+                    stageStats.QueuedToSubmit.Histogram );
+                writeStageTimingRow(
+                    os,
+                    name,
+                    longestName,
+                    submitToStart,
+                    stageStats.SubmitToStart.NumberOfCalls,
+                    stageStats.SubmitToStart.TotalNS,
+                    stageStats.SubmitToStart.MinNS,
+                    stageStats.SubmitToStart.MaxNS,
+                    stageStats.SubmitToStart.Histogram );
+            }
+        }
+    }
+
+    CDeviceQueueStageTimingStatsMap::const_iterator iq =
+        m_QueueStageTimingStatsMap.find( device );
+    if( iq != m_QueueStageTimingStatsMap.end() )
+    {
+        const CQueueStageTimingStatsMap& qstsm = (*iq).second;
+
+        writeStageTimingHeader( os, "Queue", longestName );
+
+        for( const auto& it : qstsm )
+        {
+            const std::string   name = "Queue " + std::to_string( it.first );
+            const SDeviceStageTimingStats& stageStats = it.second;
+
+            writeStageTimingRow(
+                os,
+                name,
+                longestName,
+                queuedToSubmit,
+                stageStats.QueuedToSubmit.NumberOfCalls,
+                stageStats.QueuedToSubmit.TotalNS,
+                stageStats.QueuedToSubmit.MinNS,
+                stageStats.QueuedToSubmit.MaxNS,
+                stageStats.QueuedToSubmit.Histogram );
+            writeStageTimingRow(
+                os,
+                name,
+                longestName,
+                submitToStart,
+                stageStats.SubmitToStart.NumberOfCalls,
+                stageStats.SubmitToStart.TotalNS,
+                stageStats.SubmitToStart.MinNS,
+                stageStats.SubmitToStart.MaxNS,
+                stageStats.SubmitToStart.Histogram );
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+static void writeOccupancyRow(
+    std::ostream& os,
+    const std::string& name,
+    const COccupancyTracker::SResults& results )
+{
+    const uint64_t  elapsedNS = results.elapsedNS();
+
+    os << std::right << std::setw(16) << name << ", "
+        << std::right << std::setw(10) << results.Commands << ", "
+        << std::right << std::setw(14) << elapsedNS << ", "
+        << std::right << std::setw(14) << results.BusyNS << ", "
+        << std::right << std::setw( 7) << std::fixed << std::setprecision(2)
+        << ( elapsedNS == 0 ? 100.0 : results.BusyNS * 100.0 / elapsedNS ) << "%, "
+        << std::right << std::setw( 8) << results.NumGaps << ", "
+        << std::right << std::setw(14) << results.TotalGapNS;
+    if( results.NumGaps == 0 )
+    {
+        for( size_t i = 0; i < sizeof(sc_ReportPercentiles) / sizeof(sc_ReportPercentiles[0]); i++ )
+        {
+            os << ", " << std::right << std::setw(13) << "-";
+        }
+    }
+    else
+    {
+        writePercentiles(
+            os,
+            results.GapHistogram,
+            results.NumGaps,
+            results.MinGapNS,
+            results.MaxGapNS );
+    }
+    os << std::endl;
+}
+
+void CLIntercept::writeDeviceOccupancyReport(
+    std::ostream& os,
+    cl_device_id device )
+{
+    CDeviceOccupancyMap::const_iterator id = m_DeviceOccupancyMap.find( device );
+    if( id == m_DeviceOccupancyMap.end() )
+    {
+        return;
+    }
+
+    // Each result is computed once, since computing the results merges any
+    // intervals that have not been merged yet.
+    std::vector< std::pair< std::string, COccupancyTracker::SResults > > rows;
+
+    rows.emplace_back( "Device", COccupancyTracker::SResults() );
+    (*id).second.getResults( rows.back().second );
+
+    uint64_t    totalQueueBusyNS = 0;
+
+    CDeviceQueueOccupancyMap::const_iterator iq = m_QueueOccupancyMap.find( device );
+    if( iq != m_QueueOccupancyMap.end() )
+    {
+        for( const auto& it : (*iq).second )
+        {
+            rows.emplace_back(
+                "Queue " + std::to_string( it.first ),
+                COccupancyTracker::SResults() );
+            it.second.getResults( rows.back().second );
+
+            totalQueueBusyNS += rows.back().second.BusyNS;
+        }
+    }
+
+    const COccupancyTracker::SResults&  deviceResults = rows.front().second;
+
+    os << std::endl << "Device Occupancy:" << std::endl;
+
+    os << std::endl
+        << std::right << std::setw(16) << "Name" << ", "
+        << std::right << std::setw(10) << "Commands" << ", "
+        << std::right << std::setw(14) << "Elapsed (ns)" << ", "
+        << std::right << std::setw(14) << "Busy (ns)" << ", "
+        << std::right << std::setw( 8) << "Busy (%)" << ", "
+        << std::right << std::setw( 8) << "Gaps" << ", "
+        << std::right << std::setw(14) << "Idle (ns)";
+    for( const char* name : sc_ReportPercentileNames )
+    {
+        os << ", " << std::right << std::setw(13) << ( std::string("Gap ") + name );
+    }
+    os << std::endl;
+
+    for( const auto& row : rows )
+    {
+        writeOccupancyRow( os, row.first, row.second );
+    }
+
+    // When commands from different queues execute at the same time, the sum
+    // of the busy time for each queue is larger than the busy time for the
+    // device.
+    const uint64_t  overlapNS =
+        totalQueueBusyNS > deviceResults.BusyNS ?
+        totalQueueBusyNS - deviceResults.BusyNS :
+        0;
+    os << std::endl << "Queue Overlap (ns): " << overlapNS;
+    if( deviceResults.BusyNS != 0 )
+    {
+        os << " (" << std::fixed << std::setprecision(2)
+            << overlapNS * 100.0 / deviceResults.BusyNS << "% of busy time)";
+    }
+    os << std::endl;
+
+    os << std::endl << "Largest Idle Gaps:" << std::endl;
+
+    os << std::endl
+        << std::right << std::setw(16) << "Name" << ", "
+        << std::right << std::setw(14) << "Gap (ns)" << ", "
+        << std::right << std::setw(14) << "Offset (ns)" << ", "
+        << "Preceding Command" << std::endl;
+
+    for( const auto& row : rows )
+    {
+        const COccupancyTracker::SResults&  results = row.second;
+        for( size_t i = 0; i < results.NumLargestGaps; i++ )
+        {
+            const COccupancyTracker::SGap&  gap = results.LargestGaps[i];
+            os << std::right << std::setw(16) << row.first << ", "
+                << std::right << std::setw(14) << gap.GapNS << ", "
+                << std::right << std::setw(14) << gap.StartNS - results.FirstStartNS << ", "
+                << m_StringInterner.name( gap.PrecedingTag ) << std::endl;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::writeCriticalPathReport(
+    std::ostream& os )
+{
+    CCriticalPath::SResults results;
+    m_CriticalPath.analyze( results );
+
+    const uint64_t  pathNS = results.PathEndNS - results.PathStartNS;
+
+    os << std::endl << "Critical Path:" << std::endl;
+
+    os << std::endl
+        << "Commands and Host Waits: " << results.Nodes << std::endl
+        << "Dependencies: " << results.Edges << std::endl;
+    if( m_CriticalPath.droppedNodes() != 0 )
+    {
+        os << "Dropped Commands and Host Waits: " << m_CriticalPath.droppedNodes() << std::endl;
+    }
+    os << "Critical Path Length (ns): " << pathNS << std::endl
+        << "Critical Path Commands and Host Waits: " << results.PathNodes << std::endl
+        << "Critical Path Gaps (ns): " << pathNS - std::min( pathNS, results.PathBusyNS ) << std::endl;
+
+    typedef CCriticalPath::CNodeSummaryMap::value_type  CSummary;
+
+    std::vector<const CSummary*>    summaries;
+    summaries.reserve( results.Summaries.size() );
+
+    size_t  longestName = 32;
+    for( const auto& it : results.Summaries )
+    {
+        summaries.push_back( &it );
+
+        const std::string&  name = m_StringInterner.name( it.first.first );
+        longestName = std::max< size_t >(
+            name.length() + ( it.first.second ? 12 : 0 ),
+            longestName );
+    }
+
+    // Sort by the time on the critical path, then by the minimum slack, so
+    // the most critical commands and host waits are first.
+    std::sort( summaries.begin(), summaries.end(),
+        []( const CSummary* a, const CSummary* b )
+        {
+            if( a->second.OnPathNS != b->second.OnPathNS )
+            {
+                return a->second.OnPathNS > b->second.OnPathNS;
+            }
+            return a->second.MinSlackNS < b->second.MinSlackNS;
+        });
+
+    os << std::endl
+        << std::right << std::setw(longestName) << "Name" << ", "
+        << std::right << std::setw( 8) << "Count" << ", "
+        << std::right << std::setw( 8) << "On Path" << ", "
+        << std::right << std::setw(14) << "On Path (ns)" << ", "
+        << std::right << std::setw( 8) << "Path (%)" << ", "
+        << std::right << std::setw(14) << "Min Slack (ns)" << ", "
+        << std::right << std::setw(14) << "Avg Slack (ns)" << std::endl;
+
+    for( const CSummary* pSummary : summaries )
+    {
+        const CCriticalPath::SNodeSummary&  summary = pSummary->second;
+        const uint64_t  offPath = summary.Nodes - summary.OnPath;
+
+        std::string name = m_StringInterner.name( pSummary->first.first );
+        if( pSummary->first.second )
+        {
+            name += " (host wait)";
+        }
+
+        os << std::right << std::setw(longestName) << name << ", "
+            << std::right << std::setw( 8) << summary.Nodes << ", "
+            << std::right << std::setw( 8) << summary.OnPath << ", "
+            << std::right << std::setw(14) << summary.OnPathNS << ", "
+            << std::right << std::setw( 7) << std::fixed << std::setprecision(2)
+            << ( pathNS == 0 ? 0.0 : summary.OnPathNS * 100.0 / pathNS ) << "%, ";
+        if( offPath == 0 )
+        {
+            os << std::right << std::setw(14) << "-" << ", "
+                << std::right << std::setw(14) << "-" << std::endl;
+        }
+        else
+        {
+            os << std::right << std::setw(14) << summary.MinSlackNS << ", "
+                << std::right << std::setw(14) << summary.TotalSlackNS / offPath << std::endl;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::addShortKernelName(
+    const std::string& kernelName )
+{
+    if( kernelName.length() > m_Config.LongKernelNameCutoff )
+    {
+        std::string shortKernelName("k_");
+        shortKernelName += std::to_string(m_KernelID);
+        m_LongKernelNameMap[ kernelName ] = shortKernelName;
+
+        logf( "Added kernel name mapping: %s to %s\n",
+            kernelName.c_str(),
+            shortKernelName.c_str() );
+
+        m_KernelID++;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::registerThread(
+    SThreadInfo& threadInfo )
+{
+    std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
+
+    threadInfo.ThreadId = OS().GetThreadID();
+    threadInfo.ThreadNumber = m_ThreadCount++;
+
+    if( m_Config.ChromeCallLogging )
+    {
+        m_ChromeTrace.addThreadMetadata(
+            threadInfo.ThreadId,
+            threadInfo.ThreadNumber );
+    }
+
+    threadInfo.pIntercept = this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::getCallLoggingPrefix(
+    std::string& str )
+{
+    if( m_Config.CallLoggingElapsedTime )
+    {
+        using us = std::chrono::microseconds;
+        uint64_t usDelta =
             std::chrono::duration_cast<us>(clock::now() - m_StartTime).count();
 
         std::ostringstream  ss;
@@ -1056,20 +2323,19 @@ void CLIntercept::getCallLoggingPrefix(
     if( m_Config.CallLoggingThreadId ||
         m_Config.CallLoggingThreadNumber )
     {
-        uint64_t    threadId = OS().GetThreadID();
+        const SThreadInfo&  threadInfo = getThreadInfo();
         std::ostringstream  ss;
 
         if( m_Config.CallLoggingThreadId )
         {
             ss << "TID = ";
-            ss << threadId;
+            ss << threadInfo.ThreadId;
             ss << " ";
         }
         if( m_Config.CallLoggingThreadNumber )
         {
-            unsigned int    threadNumber = getThreadNumber( threadId );
             ss << "TNum = ";
-            ss << threadNumber;
+            ss << threadInfo.ThreadNumber;
             ss << " ";
         }
 
@@ -1084,7 +2350,16 @@ void CLIntercept::callLoggingEnter(
     const uint64_t enqueueCounter,
     const cl_kernel kernel )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    // Hold the kernel mutex while building the log line, so the kernel name
+    // can be used without copying it.  The kernel mutex is ordered before
+    // the log mutex.
+    std::unique_lock<std::mutex> kernelLock(m_KernelMutex, std::defer_lock);
+    if( kernel )
+    {
+        kernelLock.lock();
+    }
+
+    std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
 
     std::string str(">>>> ");
     getCallLoggingPrefix( str );
@@ -1093,9 +2368,8 @@ void CLIntercept::callLoggingEnter(
 
     if( kernel )
     {
-        const std::string& kernelName = getShortKernelNameWithHash(kernel);
         str += "( ";
-        str += kernelName;
+        str += getShortKernelNameWithHash(kernel);
         str += " )";
     }
 
@@ -1118,7 +2392,16 @@ void CLIntercept::callLoggingEnter(
     const char* formatStr,
     ... )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    // Hold the kernel mutex while building the log line, so the kernel name
+    // can be used without copying it.  The kernel mutex is ordered before
+    // the log mutex.
+    std::unique_lock<std::mutex> kernelLock(m_KernelMutex, std::defer_lock);
+    if( kernel )
+    {
+        kernelLock.lock();
+    }
+
+    std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
 
     va_list args;
     va_start( args, formatStr );
@@ -1130,9 +2413,8 @@ void CLIntercept::callLoggingEnter(
 
     if( kernel )
     {
-        const std::string& kernelName = getShortKernelNameWithHash(kernel);
         str += "( ";
-        str += kernelName;
+        str += getShortKernelNameWithHash(kernel);
         str += " )";
     }
 
@@ -1167,7 +2449,7 @@ void CLIntercept::callLoggingEnter(
 void CLIntercept::callLoggingInfo(
     const std::string& str )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
 
     log( "---- " + str + "\n" );
 }
@@ -1176,6 +2458,8 @@ void CLIntercept::callLoggingInfo(
     const char* formatStr,
     ... )
 {
+    std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
+
     va_list args;
     va_start( args, formatStr );
 
@@ -1200,7 +2484,7 @@ void CLIntercept::callLoggingExit(
     const cl_event* event,
     const cl_sync_point_khr* syncPoint )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
 
     std::string str("<<<< ");
     getCallLoggingPrefix( str );
@@ -1235,7 +2519,7 @@ void CLIntercept::callLoggingExit(
     const char* formatStr,
     ... )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
 
     va_list args;
     va_start( args, formatStr );
@@ -1410,7 +2694,7 @@ void CLIntercept::cacheDeviceInfo(
         deviceInfo.MaxClockFrequency = deviceMaxClockFrequency;
 
         deviceInfo.HasDeviceAndHostTimer = false;
-        deviceInfo.DeviceHostTimeDeltaNS = 0;
+        deviceInfo.HasClockSample = false;
 
         // If the device numeric version is OpenCL 2.1 or newer and we have
         // the device and host timer APIs we might be able to use the device
@@ -1428,7 +2712,6 @@ void CLIntercept::cacheDeviceInfo(
             if( errorCode == CL_SUCCESS )
             {
                 deviceInfo.HasDeviceAndHostTimer = true;
-                deviceInfo.DeviceHostTimeDeltaNS = deviceTimeNS - hostTimeNS;
             }
         }
 
@@ -3447,7 +4730,6 @@ void CLIntercept::logError(
     const char* functionName,
     cl_int errorCode )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
     logf( "ERROR! %s returned %s (%d)\n", functionName, enumName().name(errorCode).c_str(), errorCode );
 }
 
@@ -3457,7 +4739,6 @@ void CLIntercept::logFlushOrFinishAfterEnqueueStart(
     const char* flushOrFinish,
     const char* functionName )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
     logf( "Calling %s after %s...\n", flushOrFinish, functionName );
 }
 
@@ -3468,7 +4749,6 @@ void CLIntercept::logFlushOrFinishAfterEnqueueEnd(
     const char* functionName,
     cl_int errorCode )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
     logf( "...%s after %s returned %s (%d)\n", flushOrFinish, functionName, enumName().name( errorCode ).c_str(), errorCode );
 }
 
@@ -3480,7 +4760,8 @@ void CLIntercept::logKernelInfo(
 {
     if( numKernels > 0 )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+        std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
 
         cl_int  errorCode = CL_SUCCESS;
 
@@ -3645,7 +4926,7 @@ void CLIntercept::logQueueInfo(
     const cl_device_id device,
     const cl_command_queue queue )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
 
     cl_int  errorCode = CL_SUCCESS;
 
@@ -3903,7 +5184,6 @@ void CLIntercept::contextCallback(
         private_info,
         cb );
 
-    std::lock_guard<std::mutex> lock(m_Mutex);
     log( str + errinfo + "\n" + "<======= End of Context Callback\n" );
 }
 
@@ -4099,7 +5379,6 @@ void CLIntercept::overrideNullLocalWorkSize(
                 }
                 else
                 {
-                    std::lock_guard<std::mutex> lock(m_Mutex);
                     logf( "Couldn't override NULL local work size: < %zu > %% < %zu > != 0!\n",
                         global_work_size[0],
                         m_Config.NullLocalWorkSizeX );
@@ -4117,7 +5396,6 @@ void CLIntercept::overrideNullLocalWorkSize(
                 }
                 else
                 {
-                    std::lock_guard<std::mutex> lock(m_Mutex);
                     logf( "Couldn't override NULL local work size: < %zu x %zu > %% < %zu x %zu > != 0!\n",
                         global_work_size[0],
                         global_work_size[1],
@@ -4139,7 +5417,6 @@ void CLIntercept::overrideNullLocalWorkSize(
                 }
                 else
                 {
-                    std::lock_guard<std::mutex> lock(m_Mutex);
                     logf( "Couldn't override NULL local work size: < %zu x %zu x %zu > %% < %zu x %zu x %zu > != 0!\n",
                         global_work_size[0],
                         global_work_size[1],
@@ -5581,7 +6858,7 @@ void CLIntercept::getTimingTagsUnmap(
 {
     if( ptr )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
         CMapPointerInfoMap::iterator iter = m_MapPointerInfoMap.find( ptr );
         if( iter != m_MapPointerInfoMap.end() )
@@ -5632,9 +6909,9 @@ void CLIntercept::getTimingTagsMemfill(
     std::string& hostTag,
     std::string& deviceTag )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
-
-    cl_platform_id  platform = getPlatform(queue);
+    const SQueueInfo    queueInfo = getQueueInfo( queue );
+    const cl_platform_id    platform = queueInfo.Platform;
+    const cl_context    context = queueInfo.Context;
 
     // If we don't have a function pointer for clGetMemAllocINFO, try to
     // get one.  It's possible that the function pointer exists but
@@ -5642,6 +6919,7 @@ void CLIntercept::getTimingTagsMemfill(
     // be installed into the dispatch table.
     if( dispatchX(platform).clGetMemAllocInfoINTEL == NULL )
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         getExtensionFunctionAddress(
             platform,
             "clGetMemAllocInfoINTEL" );
@@ -5650,14 +6928,6 @@ void CLIntercept::getTimingTagsMemfill(
     const auto& dispatchX = this->dispatchX(platform);
     if( dispatchX.clGetMemAllocInfoINTEL != NULL )
     {
-        cl_context  context = NULL;
-        dispatch().clGetCommandQueueInfo(
-            queue,
-            CL_QUEUE_CONTEXT,
-            sizeof( context ),
-            &context,
-            NULL );
-
         if( context )
         {
             cl_unified_shared_memory_type_intel dstType = CL_MEM_TYPE_UNKNOWN_INTEL;
@@ -5703,9 +6973,9 @@ void CLIntercept::getTimingTagsMemcpy(
     std::string& hostTag,
     std::string& deviceTag )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
-
-    cl_platform_id  platform = getPlatform(queue);
+    const SQueueInfo    queueInfo = getQueueInfo( queue );
+    const cl_platform_id    platform = queueInfo.Platform;
+    const cl_context    context = queueInfo.Context;
 
     // If we don't have a function pointer for clGetMemAllocINFO, try to
     // get one.  It's possible that the function pointer exists but
@@ -5713,6 +6983,7 @@ void CLIntercept::getTimingTagsMemcpy(
     // be installed into the dispatch table.
     if( dispatchX(platform).clGetMemAllocInfoINTEL == NULL )
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         getExtensionFunctionAddress(
             platform,
             "clGetMemAllocInfoINTEL" );
@@ -5721,14 +6992,6 @@ void CLIntercept::getTimingTagsMemcpy(
     const auto& dispatchX = this->dispatchX(platform);
     if( dispatchX.clGetMemAllocInfoINTEL != NULL )
     {
-        cl_context  context = NULL;
-        dispatch().clGetCommandQueueInfo(
-            queue,
-            CL_QUEUE_CONTEXT,
-            sizeof( context ),
-            &context,
-            NULL );
-
         if( context )
         {
             cl_unified_shared_memory_type_intel dstType = CL_MEM_TYPE_UNKNOWN_INTEL;
@@ -5794,29 +7057,25 @@ void CLIntercept::getTimingTagsKernel(
     std::string& hostTag,
     std::string& deviceTag )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
-
-    cl_device_id device = NULL;
-    dispatch().clGetCommandQueueInfo(
-        queue,
-        CL_QUEUE_DEVICE,
-        sizeof(device),
-        &device,
-        NULL );
-
-    // Cache the device info if it's not cached already, since we'll print
-    // the device name and other device properties as part of the report.
-    cacheDeviceInfo( device );
+    // This caches the device info if it's not cached already, since we'll
+    // print the device name and other device properties as part of the
+    // report.
+    const SQueueInfo    queueInfo = getQueueInfo( queue );
+    const cl_device_id  device = queueInfo.Device;
+    const cl_platform_id    platform = queueInfo.Platform;
 
     if( kernel )
     {
-        hostTag += getShortKernelNameWithHash(kernel);
+        {
+            std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+            hostTag += getShortKernelNameWithHash(kernel);
+        }
 
         deviceTag += hostTag;
 
-        if( config().DevicePerformanceTimeKernelInfoTracking && device )
+        if( config().DevicePerformanceTimeKernelInfoTracking && queueInfo.pDeviceInfo )
         {
-            const SDeviceInfo& deviceInfo = m_DeviceInfoMap[device];
+            const SDeviceInfo& deviceInfo = *queueInfo.pDeviceInfo;
 
             std::ostringstream  ss;
             {
@@ -5856,9 +7115,9 @@ void CLIntercept::getTimingTagsKernel(
                 if( maxsgs == 0 &&
                     deviceInfo.Supports_cl_khr_subgroups )
                 {
-                    cl_platform_id  platform = getPlatform(device);
                     if( dispatchX(platform).clGetKernelSubGroupInfoKHR == NULL )
                     {
+                        std::lock_guard<std::mutex> lock(m_Mutex);
                         getExtensionFunctionAddress(
                             platform,
                             "clGetKernelSubGroupInfoKHR" );
@@ -6038,13 +7297,12 @@ void CLIntercept::getTimingTagsKernel(
                 workDim <= 3 &&
                 config().DevicePerformanceTimeSuggestedLWSTracking )
             {
-                cl_platform_id  platform = getPlatform(device);
-
                 // Try the cl_khr_suggested_local_work_size version first.
                 if( useSuggestedLWS == false )
                 {
                     if( dispatchX(platform).clGetKernelSuggestedLocalWorkSizeKHR == NULL )
                     {
+                        std::lock_guard<std::mutex> lock(m_Mutex);
                         getExtensionFunctionAddress(
                             platform,
                             "clGetKernelSuggestedLocalWorkSizeKHR" );
@@ -6069,6 +7327,7 @@ void CLIntercept::getTimingTagsKernel(
                 {
                     if( dispatchX(platform).clGetKernelSuggestedLocalWorkSizeINTEL == NULL )
                     {
+                        std::lock_guard<std::mutex> lock(m_Mutex);
                         getExtensionFunctionAddress(
                             platform,
                             "clGetKernelSuggestedLocalWorkSizeINTEL" );
@@ -6138,7 +7397,7 @@ void CLIntercept::getRecordTagCommandBufferKernel(
     const cl_mutable_command_khr* mutable_handle,
     std::string& recordTag )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
 
     if( kernel )
     {
@@ -6225,34 +7484,119 @@ void CLIntercept::updateHostTimingStats(
     clock::time_point start,
     clock::time_point end )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
-
-    std::string key( functionName );
-    if( !tag.empty() )
-    {
-        key += "( ";
-        key += tag;
-        key += " )";
-    }
-
-    SHostTimingStats& hostTimingStats = m_HostTimingStatsMap[ key ];
+    CSelfOverheadScope  selfOverheadScope(
+        selfOverhead(),
+        CSelfOverhead::cStage_HostTiming );
 
     using ns = std::chrono::nanoseconds;
     uint64_t    nsDelta = std::chrono::duration_cast<ns>(end - start).count();
 
-    hostTimingStats.NumberOfCalls++;
-    hostTimingStats.TotalNS += nsDelta;
-    hostTimingStats.MinNS = std::min<uint64_t>( hostTimingStats.MinNS, nsDelta );
-    hostTimingStats.MaxNS = std::max<uint64_t>( hostTimingStats.MaxNS, nsDelta );
-
+    // Host performance time logging logs a global call count, so it uses
+    // the shared stats map rather than the per-thread stats.
     if( config().HostPerformanceTimeLogging )
     {
+        std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+
+        std::string key( functionName );
+        if( !tag.empty() )
+        {
+            key += "( ";
+            key += tag;
+            key += " )";
+        }
+
+        SHostTimingStats& hostTimingStats = m_HostTimingStatsMap[ key ];
+
+        hostTimingStats.NumberOfCalls++;
+        hostTimingStats.TotalNS += nsDelta;
+        hostTimingStats.MinNS = std::min<uint64_t>( hostTimingStats.MinNS, nsDelta );
+        hostTimingStats.MaxNS = std::max<uint64_t>( hostTimingStats.MaxNS, nsDelta );
+        hostTimingStats.Histogram.add( nsDelta );
+
         uint64_t    numberOfCalls = hostTimingStats.NumberOfCalls;
         logf( "Host Time for call %" PRIu64 ": %s = %" PRIu64 " ns\n",
             numberOfCalls,
             key.c_str(),
             nsDelta );
     }
+    else
+    {
+        SHostTimingThreadStats& threadStats = getHostTimingThreadStats();
+
+        std::lock_guard<std::mutex> lock(threadStats.Mutex);
+
+        const CStringInterner::Id   tagId = tag.empty() ?
+            CStringInterner::cEmptyId :
+            m_StringInterner.intern( tag );
+
+        SHostTimingStats& hostTimingStats =
+            threadStats.FunctionStatsMap[ functionName ][ tagId ];
+
+        hostTimingStats.NumberOfCalls++;
+        hostTimingStats.TotalNS += nsDelta;
+        hostTimingStats.MinNS = std::min<uint64_t>( hostTimingStats.MinNS, nsDelta );
+        hostTimingStats.MaxNS = std::max<uint64_t>( hostTimingStats.MaxNS, nsDelta );
+        hostTimingStats.Histogram.add( nsDelta );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+CLIntercept::SHostTimingThreadStats& CLIntercept::getHostTimingThreadStats()
+{
+    static thread_local const CLIntercept*      tlsIntercept = NULL;
+    static thread_local SHostTimingThreadStats* tlsThreadStats = NULL;
+
+    if( tlsIntercept != this || tlsThreadStats == NULL )
+    {
+        std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+
+        tlsThreadStats = new SHostTimingThreadStats;
+        tlsIntercept = this;
+
+        m_HostTimingThreadStatsList.push_back( tlsThreadStats );
+    }
+
+    return *tlsThreadStats;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// This function assumes that the timing lock is already held.
+void CLIntercept::getHostTimingStats(
+    CHostTimingStatsMap& hostTimingStatsMap )
+{
+    hostTimingStatsMap = m_HostTimingStatsMap;
+
+    for( auto pThreadStats : m_HostTimingThreadStatsList )
+    {
+        std::lock_guard<std::mutex> lock(pThreadStats->Mutex);
+
+        for( const auto& functionStats : pThreadStats->FunctionStatsMap )
+        {
+            for( const auto& tagStats : functionStats.second )
+            {
+                const std::string& tag = m_StringInterner.name( tagStats.first );
+
+                std::string key( functionStats.first );
+                if( !tag.empty() )
+                {
+                    key += "( ";
+                    key += tag;
+                    key += " )";
+                }
+
+                const SHostTimingStats& threadTimingStats = tagStats.second;
+                SHostTimingStats& hostTimingStats = hostTimingStatsMap[ key ];
+
+                hostTimingStats.NumberOfCalls += threadTimingStats.NumberOfCalls;
+                hostTimingStats.TotalNS += threadTimingStats.TotalNS;
+                hostTimingStats.MinNS = std::min<uint64_t>( hostTimingStats.MinNS, threadTimingStats.MinNS );
+                hostTimingStats.MaxNS = std::max<uint64_t>( hostTimingStats.MaxNS, threadTimingStats.MaxNS );
+                hostTimingStats.Histogram.add( threadTimingStats.Histogram );
+            }
+        }
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -6483,7 +7827,7 @@ void CLIntercept::dummyCommandQueue(
             NULL );
         if( props & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE )
         {
-            std::lock_guard<std::mutex> lock(m_Mutex);
+            std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
 
             log( "Creating and destroying a dummy out-of-order queue.\n" );
 
@@ -6509,294 +7853,901 @@ void CLIntercept::dummyCommandQueue(
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-void CLIntercept::addTimingEvent(
-    const char* functionName,
-    const uint64_t enqueueCounter,
-    const clock::time_point queuedTime,
-    const std::string& tag,
-    const cl_command_queue queue,
-    cl_event event )
+CLIntercept::SQueueInfo CLIntercept::getQueueInfo(
+    cl_command_queue queue )
+{
+    {
+        std::lock_guard<std::mutex> queueInfoLock(m_QueueInfoMutex);
+
+        CQueueInfoMap::const_iterator iter = m_QueueInfoMap.find( queue );
+        if( iter != m_QueueInfoMap.end() && iter->second.Cached )
+        {
+            return iter->second;
+        }
+    }
+
+    // The queue info is not cached yet, so query it without holding any
+    // locks.  If two threads get here for the same queue they will cache
+    // the same info.
+    cl_device_id    device = NULL;
+    dispatch().clGetCommandQueueInfo(
+        queue,
+        CL_QUEUE_DEVICE,
+        sizeof(device),
+        &device,
+        NULL );
+
+    cl_context  context = NULL;
+    dispatch().clGetCommandQueueInfo(
+        queue,
+        CL_QUEUE_CONTEXT,
+        sizeof(context),
+        &context,
+        NULL );
+
+    cl_command_queue_properties properties = 0;
+    dispatch().clGetCommandQueueInfo(
+        queue,
+        CL_QUEUE_PROPERTIES,
+        sizeof(properties),
+        &properties,
+        NULL );
+
+    cl_platform_id  platform = device ? getPlatform(device) : NULL;
+
+    // Cache the device info if it's not cached already, since we'll print
+    // the device name and other device properties as part of the report.
+    // Device info is never removed, so the pointer remains valid.
+    SDeviceInfo*    pDeviceInfo = NULL;
+    if( device )
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        cacheDeviceInfo( device );
+        pDeviceInfo = &m_DeviceInfoMap[device];
+    }
+
+    std::lock_guard<std::mutex> queueInfoLock(m_QueueInfoMutex);
+
+    SQueueInfo& queueInfo = m_QueueInfoMap[ queue ];
+    queueInfo.Device = device;
+    queueInfo.Platform = platform;
+    queueInfo.Context = context;
+    queueInfo.pDeviceInfo = pDeviceInfo;
+    queueInfo.InOrder =
+        ( properties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE ) == 0;
+    queueInfo.Cached = true;
+
+    return queueInfo;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::sampleDeviceClock(
+    cl_device_id device,
+    SDeviceInfo& deviceInfo,
+    clock::time_point queuedTime )
+{
+    // These conditions should have been checked for HasDeviceAndHostTimer to be true:
+    CLI_ASSERT( deviceInfo.NumericVersion >= CL_MAKE_VERSION_KHR(2, 1, 0) );
+    CLI_ASSERT( dispatch().clGetDeviceAndHostTimer );
+
+    // Note: Even though ideally the intercept timer and the device timer should
+    // advance at a consistent rate and hence the delta between the two timers
+    // should remain constant, empirically this does not appear to be the case.
+    // Rather than synchronizing the two timers for every command, the timers are
+    // sampled periodically and the samples are fit to a clock model, which also
+    // accounts for the timers advancing at slightly different rates.
+
+    const std::chrono::microseconds samplePeriod(
+        m_Config.DevicePerformanceTimingTimerSyncPeriod );
+
+    // Decide whether the device timer is due to be sampled while holding the
+    // timing mutex, but sample the device timer without holding any locks.
+    // The sample time is updated first so other threads do not also sample
+    // the device timer.
+    {
+        std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+        if( deviceInfo.HasClockSample &&
+            samplePeriod.count() != 0 &&
+            queuedTime - deviceInfo.ClockSampleTime < samplePeriod )
+        {
+            return;
+        }
+
+        deviceInfo.HasClockSample = true;
+        deviceInfo.ClockSampleTime = queuedTime;
+    }
+
+    using ns = std::chrono::nanoseconds;
+    const clock::time_point interceptTimeStart = clock::now();
+
+    cl_ulong    deviceTimeNS = 0;
+    cl_ulong    hostTimeNS = 0;
+    cl_int  errorCode = dispatch().clGetDeviceAndHostTimer(
+        device,
+        &deviceTimeNS,
+        &hostTimeNS);
+
+    const clock::time_point interceptTimeEnd = clock::now();
+
+    if( errorCode == CL_SUCCESS )
+    {
+        const uint64_t  interceptTimeStartNS =
+            std::chrono::duration_cast<ns>(interceptTimeStart.time_since_epoch()).count();
+        const uint64_t  interceptTimeEndNS =
+            std::chrono::duration_cast<ns>(interceptTimeEnd.time_since_epoch()).count();
+
+        std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+        m_ClockModelMap[device].addSample(
+            deviceTimeNS,
+            interceptTimeStartNS + ( interceptTimeEndNS - interceptTimeStartNS ) / 2 );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+bool CLIntercept::getProfilingDelta(
+    cl_device_id device,
+    cl_ulong commandQueued,
+    int64_t& profilingDeltaNS ) const
+{
+    CClockModelMap::const_iterator  iter = m_ClockModelMap.find( device );
+    if( iter == m_ClockModelMap.end() || !iter->second.valid() )
+    {
+        return false;
+    }
+
+    profilingDeltaNS = iter->second.offsetNS( commandQueued );
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+bool CLIntercept::sampleDevicePerformanceTiming(
+    cl_command_queue queue,
+    const char* name )
+{
+    const CStringInterner::Id   nameId = m_StringInterner.intern( name );
+    const cl_device_id  device = getQueueInfo( queue ).Device;
+
+    std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+
+    SDeviceTimingSampleState&   sampleState = m_DeviceTimingSampleMap[ device ][ nameId ];
+    sampleState.Enqueues++;
+
+    const cl_uint   sampleInterval = m_Config.DevicePerformanceTimingSampleInterval;
+    if( sampleInterval > 1 &&
+        ( sampleState.Enqueues - 1 ) % sampleInterval != 0 )
+    {
+        return false;
+    }
+
+    const cl_uint   samplesPerSecond = m_Config.DevicePerformanceTimingSamplesPerSecond;
+    if( samplesPerSecond != 0 )
+    {
+        const clock::time_point now = clock::now();
+        if( sampleState.PeriodSamples == 0 ||
+            now - sampleState.PeriodStart >= std::chrono::seconds(1) )
+        {
+            sampleState.PeriodStart = now;
+            sampleState.PeriodSamples = 0;
+        }
+        if( sampleState.PeriodSamples >= samplesPerSecond )
+        {
+            return false;
+        }
+        sampleState.PeriodSamples++;
+    }
+
+    sampleState.Sampled++;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::addTimingEvent(
+    const char* functionName,
+    const uint64_t enqueueCounter,
+    const clock::time_point queuedTime,
+    const std::string& tag,
+    const cl_command_queue queue,
+    cl_event event,
+    bool retainEvent )
+{
+    CSelfOverheadScope  selfOverheadScope(
+        selfOverhead(),
+        CSelfOverhead::cStage_AddTimingEvent );
+
+    if( event == NULL )
+    {
+        logf( "Unexpectedly got a NULL timing event for %s, check for OpenCL errors!\n",
+            functionName );
+        return;
+    }
+
+    if( config().DevicePerformanceTimingMaxPendingEvents != 0 &&
+        !reservePendingTimingEvent() )
+    {
+        // If the event was created by the Intercept Layer then it is owned
+        // by the Intercept Layer and must be released.
+        if( !retainEvent )
+        {
+            dispatch().clReleaseEvent( event );
+        }
+        return;
+    }
+
+    const uint64_t  numPendingTimingEvents =
+        m_NumPendingTimingEvents.fetch_add( 1, std::memory_order_relaxed ) + 1;
+    if( numPendingTimingEvents > m_PeakPendingTimingEvents.load( std::memory_order_relaxed ) )
+    {
+        m_PeakPendingTimingEvents.store( numPendingTimingEvents, std::memory_order_relaxed );
+    }
+
+    cl_device_id    device = NULL;
+    unsigned int    queueNumber = 0;
+    bool            inOrder = true;
+    bool            useProfilingDelta = false;
+
+    {
+        const SQueueInfo    queueInfo = getQueueInfo( queue );
+
+        device = queueInfo.Device;
+        queueNumber = queueInfo.Number;
+        inOrder = queueInfo.InOrder;
+
+        if( queueInfo.pDeviceInfo &&
+            queueInfo.pDeviceInfo->HasDeviceAndHostTimer )
+        {
+            useProfilingDelta = true;
+            sampleDeviceClock(
+                device,
+                *queueInfo.pDeviceInfo,
+                queuedTime );
+        }
+    }
+
+    // If the event was created by the Intercept Layer and not returned to
+    // the application, take ownership of the event rather than retaining it.
+    if( retainEvent )
+    {
+        dispatch().clRetainEvent( event );
+    }
+
+    const CStringInterner::Id   nameId = !tag.empty() ?
+        m_StringInterner.intern( tag ) :
+        m_StringInterner.intern( functionName );
+
+    if( config().DevicePerformanceTimingCriticalPath )
+    {
+        std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+        m_CriticalPath.addCommand(
+            enqueueCounter,
+            nameId,
+            queueNumber,
+            inOrder );
+    }
+
+    if( config().DevicePerformanceTimingEventCallbacks &&
+        dispatch().clSetEventCallback )
+    {
+        STimingEventCallbackInfo*   pInfo = new STimingEventCallbackInfo;
+
+        pInfo->pIntercept = this;
+        pInfo->pNext = NULL;
+        pInfo->Status = CL_SUCCESS;
+
+        SEventListNode& node = pInfo->Node;
+
+        node.Device = device;
+        node.QueueNumber = queueNumber;
+        node.NameId = nameId;
+        node.EnqueueCounter = enqueueCounter;
+        node.QueuedTime = queuedTime;
+        node.UseProfilingDelta = useProfilingDelta;
+        node.Event = event;
+
+        // The callback info must be tracked before the callback is
+        // registered, since the callback may be called and the event may be
+        // processed before clSetEventCallback returns.
+        {
+            std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+            m_TimingEventCallbacks.insert( pInfo );
+        }
+
+        cl_int  errorCode = dispatch().clSetEventCallback(
+            event,
+            CL_COMPLETE,
+            timingEventCallbackCaller,
+            pInfo );
+        if( errorCode == CL_SUCCESS )
+        {
+            return;
+        }
+
+        // If the callback could not be registered, fall back to adding the
+        // event to the list of events that are queried.
+        {
+            std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+            m_TimingEventCallbacks.erase( pInfo );
+        }
+        delete pInfo;
+    }
+
+    SEventListNode  node;
+
+    node.Device = device;
+    node.QueueNumber = queueNumber;
+    node.NameId = nameId;
+    node.EnqueueCounter = enqueueCounter;
+    node.QueuedTime = queuedTime;
+    node.UseProfilingDelta = useProfilingDelta;
+    node.Event = event;
+
+    std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+
+    SQueueTimingEvents& queueEvents = m_QueueTimingEventsMap[ queue ];
+    if( queueEvents.Events.empty() )
+    {
+        // A queue handle may be reused for a new queue after it is
+        // released, so only update the queue order when the queue has no
+        // pending events.
+        queueEvents.InOrder = inOrder;
+    }
+    queueEvents.Released = false;
+    queueEvents.Events.push_back( node );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::addCriticalPathDependencies(
+    uint64_t enqueueCounter,
+    cl_uint numEvents,
+    const cl_event* eventList )
+{
+    if( eventList == NULL )
+    {
+        return;
+    }
+
+    // Events that were not returned by a command, such as user events, do
+    // not have an enqueue counter and are not part of the graph.
+    std::vector<uint64_t>   predecessors;
+    predecessors.reserve( numEvents );
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for( cl_uint i = 0; i < numEvents; i++ )
+        {
+            CEventIdMap::const_iterator iter = m_EventIdMap.find( eventList[i] );
+            if( iter != m_EventIdMap.end() )
+            {
+                predecessors.push_back( iter->second );
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+    m_CriticalPath.addCommandDependencies(
+        enqueueCounter,
+        predecessors.data(),
+        predecessors.size() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::addCriticalPathWaitForEvents(
+    const char* functionName,
+    clock::time_point waitStart,
+    cl_uint numEvents,
+    const cl_event* eventList )
+{
+    const clock::time_point waitEnd = clock::now();
+
+    std::vector<uint64_t>   predecessors;
+    predecessors.reserve( numEvents );
+    if( eventList )
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for( cl_uint i = 0; i < numEvents; i++ )
+        {
+            CEventIdMap::const_iterator iter = m_EventIdMap.find( eventList[i] );
+            if( iter != m_EventIdMap.end() )
+            {
+                predecessors.push_back( iter->second );
+            }
+        }
+    }
+
+    using ns = std::chrono::nanoseconds;
+    const uint64_t  startNS =
+        std::chrono::duration_cast<ns>(waitStart - m_StartTime).count();
+    const uint64_t  endNS =
+        std::chrono::duration_cast<ns>(waitEnd - m_StartTime).count();
+    const CStringInterner::Id   nameId = m_StringInterner.intern( functionName );
+
+    std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+    m_CriticalPath.addHostWait(
+        nameId,
+        startNS,
+        endNS,
+        predecessors.data(),
+        predecessors.size() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::addCriticalPathFinish(
+    const char* functionName,
+    clock::time_point waitStart,
+    cl_command_queue queue )
+{
+    const clock::time_point waitEnd = clock::now();
+
+    const unsigned int  queueNumber = getQueueInfo( queue ).Number;
+
+    using ns = std::chrono::nanoseconds;
+    const uint64_t  startNS =
+        std::chrono::duration_cast<ns>(waitStart - m_StartTime).count();
+    const uint64_t  endNS =
+        std::chrono::duration_cast<ns>(waitEnd - m_StartTime).count();
+    const CStringInterner::Id   nameId = m_StringInterner.intern( functionName );
+
+    std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+    m_CriticalPath.addQueueHostWait(
+        nameId,
+        startNS,
+        endNS,
+        queueNumber );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::checkTimingEvents()
+{
+    CSelfOverheadScope  selfOverheadScope(
+        selfOverhead(),
+        CSelfOverhead::cStage_CheckTimingEvents );
+
+    std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+
+    // Process the events that completed since the last check.  Events are
+    // pushed onto the front of the completed list, so reverse the list to
+    // process events in the order they completed.
+    STimingEventCallbackInfo*   pCompleted =
+        m_CompletedTimingEvents.exchange( NULL, std::memory_order_acquire );
+    STimingEventCallbackInfo*   pReversed = NULL;
+    while( pCompleted )
+    {
+        STimingEventCallbackInfo*   pNext = pCompleted->pNext;
+        pCompleted->pNext = pReversed;
+        pReversed = pCompleted;
+        pCompleted = pNext;
+    }
+    while( pReversed )
+    {
+        STimingEventCallbackInfo*   pNext = pReversed->pNext;
+        const SEventListNode&       node = pReversed->Node;
+
+        if( pReversed->Status == CL_COMPLETE )
+        {
+            processTimingEvent( node );
+        }
+        else
+        {
+            logf( "Event for %s terminated abnormally: %s (%d)\n",
+                m_StringInterner.name(node.NameId).c_str(),
+                enumName().name( pReversed->Status ).c_str(),
+                pReversed->Status );
+        }
+
+        dispatch().clReleaseEvent( node.Event );
+        m_TimingEventCallbacks.erase( pReversed );
+        delete pReversed;
+        m_NumPendingTimingEvents.fetch_sub( 1, std::memory_order_relaxed );
+
+        pReversed = pNext;
+    }
+
+    // Commands in an in-order queue complete in order, so stop checking
+    // the events for an in-order queue at the first event that is not
+    // complete.  The events for an out-of-order queue must all be checked.
+    // Note that events may be added to a queue's ring slightly out of order
+    // if multiple threads enqueue to the same queue, which only delays when
+    // a completed event is processed.
+    for( auto it = m_QueueTimingEventsMap.begin(); it != m_QueueTimingEventsMap.end(); )
+    {
+        SQueueTimingEvents& queueEvents = it->second;
+        const size_t        numEvents = queueEvents.Events.size();
+        if( queueEvents.InOrder )
+        {
+            while( !queueEvents.Events.empty() &&
+                   checkTimingEvent( queueEvents.Events.front() ) )
+            {
+                queueEvents.Events.pop_front();
+            }
+        }
+        else
+        {
+            queueEvents.Events.remove_if(
+                [this]( const SEventListNode& node )
+                {
+                    return checkTimingEvent( node );
+                } );
+        }
+        m_NumPendingTimingEvents.fetch_sub(
+            numEvents - queueEvents.Events.size(),
+            std::memory_order_relaxed );
+
+        if( queueEvents.Released && queueEvents.Events.empty() )
+        {
+            it = m_QueueTimingEventsMap.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+#if defined(USE_MDAPI)
+    if( config().DevicePerfCounterTimeBasedSampling )
+    {
+        getMDAPICountersFromStream();
+    }
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+bool CLIntercept::reservePendingTimingEvent()
+{
+    const uint64_t  maxPendingTimingEvents =
+        config().DevicePerformanceTimingMaxPendingEvents;
+    if( m_NumPendingTimingEvents.load( std::memory_order_relaxed ) < maxPendingTimingEvents )
+    {
+        return true;
+    }
+
+    switch( config().DevicePerformanceTimingPendingEventPolicy )
+    {
+    case cPendingEventPolicyHarvest:
+        // Note: Waiting for the pending events to complete could deadlock,
+        // for example if a pending command is waiting for a user event, so
+        // only the events that have already completed are processed.
+        m_PendingTimingEventHarvests.fetch_add( 1, std::memory_order_relaxed );
+        checkTimingEvents();
+        break;
+    case cPendingEventPolicyDownsample:
+        downsampleTimingEvents();
+        break;
+    default:
+        break;
+    }
+
+    if( m_NumPendingTimingEvents.load( std::memory_order_relaxed ) < maxPendingTimingEvents )
+    {
+        return true;
+    }
+
+    m_DroppedTimingEvents.fetch_add( 1, std::memory_order_relaxed );
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::downsampleTimingEvents()
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> timingLock(m_TimingMutex);
 
-    if( event == NULL )
+    // Drop every other pending event in each queue, rather than the oldest
+    // or the newest events, so the events that remain are spread over the
+    // same period of time.  Events with completion callbacks cannot be
+    // dropped until they complete.
+    uint64_t    numDropped = 0;
+    for( auto& it : m_QueueTimingEventsMap )
     {
-        logf( "Unexpectedly got a NULL timing event for %s, check for OpenCL errors!\n",
-            functionName );
-        return;
-    }
+        SQueueTimingEvents& queueEvents = it.second;
 
-    m_EventList.emplace_back();
+        size_t  index = 0;
+        queueEvents.Events.remove_if(
+            [this, &index, &numDropped]( const SEventListNode& node )
+            {
+                if( index++ % 2 == 0 )
+                {
+                    return false;
+                }
+                dispatch().clReleaseEvent( node.Event );
+                numDropped++;
+                return true;
+            } );
+    }
 
-    SEventListNode& node = m_EventList.back();
+    m_NumPendingTimingEvents.fetch_sub( numDropped, std::memory_order_relaxed );
+    m_DownsampledTimingEvents.fetch_add( numDropped, std::memory_order_relaxed );
+}
 
-    cl_device_id device = NULL;
-    dispatch().clGetCommandQueueInfo(
-        queue,
-        CL_QUEUE_DEVICE,
-        sizeof(device),
-        &device,
+///////////////////////////////////////////////////////////////////////////////
+//
+bool CLIntercept::checkTimingEvent(
+    const SEventListNode& node )
+{
+    cl_int  eventStatus = 0;
+    cl_int  errorCode = dispatch().clGetEventInfo(
+        node.Event,
+        CL_EVENT_COMMAND_EXECUTION_STATUS,
+        sizeof( eventStatus ),
+        &eventStatus,
         NULL );
 
-    // Cache the device info if it's not cached already, since we'll print
-    // the device name and other device properties as part of the report.
-    cacheDeviceInfo( device );
-
-    dispatch().clRetainEvent( event );
-
-    node.Device = device;
-    node.QueueNumber = m_QueueNumberMap[ queue ];
-    node.Name = !tag.empty() ? tag : functionName;
-    node.EnqueueCounter = enqueueCounter;
-    node.QueuedTime = queuedTime;
-    node.UseProfilingDelta = false;
-    node.ProfilingDeltaNS = 0;
-    node.Event = event;
-
-    if( device )
+    switch( errorCode )
     {
-        const SDeviceInfo& deviceInfo = m_DeviceInfoMap[device];
-
-        // Note: Even though ideally the intercept timer and the host timer should advance
-        // at a consistent rate and hence the delta between the two timers should remain
-        // constant, empirically this does not appear to be the case.  Synchronizing the
-        // two timers is relatively inexpensive, and reduces the timer drift, so compute
-        // the current delta for each event.
-
-        if( deviceInfo.HasDeviceAndHostTimer )
+    case CL_SUCCESS:
+        if( eventStatus == CL_COMPLETE )
         {
-            // These conditions should have been checked for HasDeviceAndHostTimer to be true:
-            CLI_ASSERT( deviceInfo.NumericVersion >= CL_MAKE_VERSION_KHR(2, 1, 0) );
-            CLI_ASSERT( dispatch().clGetHostTimer );
-
-            using ns = std::chrono::nanoseconds;
-            const uint64_t  interceptTimeStartNS =
-                std::chrono::duration_cast<ns>(clock::now().time_since_epoch()).count();
-
-            cl_ulong    hostTimeNS = 0;
-            dispatch().clGetHostTimer(
-                device,
-                &hostTimeNS);
-
-            const uint64_t  interceptTimeEndNS =
-                std::chrono::duration_cast<ns>(clock::now().time_since_epoch()).count();
+            processTimingEvent( node );
 
-            const int64_t   interceptHostTimeDeltaNS =
-                ( interceptTimeEndNS - interceptTimeStartNS ) / 2 +
-                ( interceptTimeStartNS - hostTimeNS );
-
-            node.UseProfilingDelta = true;
-            node.ProfilingDeltaNS =
-                interceptHostTimeDeltaNS -
-                deviceInfo.DeviceHostTimeDeltaNS;
+            dispatch().clReleaseEvent( node.Event );
+            return true;
+        }
+        else if( eventStatus < 0 )
+        {
+            // The command terminated abnormally and will never complete.
+            // Remove the event, so it does not prevent later events in an
+            // in-order queue from being processed.
+            logf( "Event for %s terminated abnormally: %s (%d)\n",
+                m_StringInterner.name(node.NameId).c_str(),
+                enumName().name( eventStatus ).c_str(),
+                eventStatus );
 
-            //logf( "Current Profiling Delta is %lld ns (%.2f us, %.2f ms)\n"
-            //    "\tIntercept to Host Timer delta: %lld ns (%.2f us, %.2f ms)\n"
-            //    "\tIntercept Start %llu ns, Intercept End %llu ns (delta %lld ns)\n"
-            //    "\tHost %llu ns\n",
-            //    node.ProfilingDeltaNS, node.ProfilingDeltaNS / 1000.0, node.ProfilingDeltaNS / 1000000.0,
-            //    interceptHostTimeDeltaNS, interceptHostTimeDeltaNS / 1000.0, interceptHostTimeDeltaNS / 1000000.0,
-            //    interceptTimeStartNS, interceptTimeEndNS, interceptTimeEndNS - interceptTimeStartNS,
-            //    hostTimeNS );
+            dispatch().clReleaseEvent( node.Event );
+            return true;
         }
+        break;
+    case CL_INVALID_EVENT:
+        // This is unexpected.  We retained the event when we added it to
+        // the list.  Remove the event from the list.
+        logf( "Unexpectedly got CL_INVALID_EVENT for an event from %s!\n",
+            m_StringInterner.name(node.NameId).c_str() );
+        return true;
+    default:
+        // nothing
+        break;
     }
+
+    return false;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-void CLIntercept::checkTimingEvents()
+void CLIntercept::timingEventCallbackCaller(
+    cl_event,
+    cl_int status,
+    void* user_data )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    // If the Intercept Layer is being destroyed, or has been destroyed,
+    // the callback info may have been freed, so do nothing.
+    s_ActiveTimingEventCallbacks.fetch_add( 1 );
+    if( !s_TimingEventCallbacksEnabled.load() )
+    {
+        s_ActiveTimingEventCallbacks.fetch_sub( 1 );
+        return;
+    }
 
-    CEventList::iterator    current = m_EventList.begin();
-    CEventList::iterator    next;
+    STimingEventCallbackInfo*   pInfo =
+        (STimingEventCallbackInfo*)user_data;
 
-    while( current != m_EventList.end() )
+    CLIntercept*    pIntercept = pInfo->pIntercept;
+
+    // This may be called from a driver thread, or from within
+    // clSetEventCallback if the event is already complete, so it only
+    // pushes the event onto the completed list without taking any locks.
+    pInfo->Status = status;
+    pInfo->pNext = pIntercept->m_CompletedTimingEvents.load( std::memory_order_relaxed );
+    while( !pIntercept->m_CompletedTimingEvents.compare_exchange_weak(
+                pInfo->pNext,
+                pInfo,
+                std::memory_order_release,
+                std::memory_order_relaxed ) )
     {
-        cl_int  errorCode = CL_SUCCESS;
-        cl_int  eventStatus = 0;
+        // pInfo->pNext was updated, try again.
+    }
 
-        next = current;
-        ++next;
+    s_ActiveTimingEventCallbacks.fetch_sub( 1 );
+}
 
-        const SEventListNode& node = *current;
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::processTimingEvent(
+    const SEventListNode& node )
+{
+    if( config().DevicePerformanceTiming ||
+        config().ITTPerformanceTiming ||
+        config().ChromePerformanceTiming )
+    {
+        cl_ulong    commandQueued = 0;
+        cl_ulong    commandSubmit = 0;
+        cl_ulong    commandStart = 0;
+        cl_ulong    commandEnd = 0;
 
-        errorCode = dispatch().clGetEventInfo(
+        // The queued and submit times are only needed for stage stats,
+        // critical path analysis, logging, and tracing, so skip querying
+        // them for device timing stats alone.
+        cl_int  errorCode = CL_SUCCESS;
+        if( config().DevicePerformanceTimingStageStats ||
+            config().DevicePerformanceTimingCriticalPath ||
+            config().DevicePerformanceTimeLogging ||
+            config().DevicePerformanceTimelineLogging ||
+            config().ITTPerformanceTiming ||
+            config().ChromePerformanceTiming )
+        {
+            errorCode |= dispatch().clGetEventProfilingInfo(
+                node.Event,
+                CL_PROFILING_COMMAND_QUEUED,
+                sizeof( commandQueued ),
+                &commandQueued,
+                NULL );
+            errorCode |= dispatch().clGetEventProfilingInfo(
+                node.Event,
+                CL_PROFILING_COMMAND_SUBMIT,
+                sizeof( commandSubmit ),
+                &commandSubmit,
+                NULL );
+        }
+        errorCode |= dispatch().clGetEventProfilingInfo(
             node.Event,
-            CL_EVENT_COMMAND_EXECUTION_STATUS,
-            sizeof( eventStatus ),
-            &eventStatus,
+            CL_PROFILING_COMMAND_START,
+            sizeof( commandStart ),
+            &commandStart,
             NULL );
-
-        switch( errorCode )
+        errorCode |= dispatch().clGetEventProfilingInfo(
+            node.Event,
+            CL_PROFILING_COMMAND_END,
+            sizeof( commandEnd ),
+            &commandEnd,
+            NULL );
+        if( errorCode == CL_SUCCESS )
         {
-        case CL_SUCCESS:
-            if( eventStatus == CL_COMPLETE )
-            {
-                if( config().DevicePerformanceTiming ||
-                    config().ITTPerformanceTiming ||
-                    config().ChromePerformanceTiming )
-                {
-                    cl_ulong    commandQueued = 0;
-                    cl_ulong    commandSubmit = 0;
-                    cl_ulong    commandStart = 0;
-                    cl_ulong    commandEnd = 0;
+            cl_ulong delta = commandEnd - commandStart;
 
-                    errorCode |= dispatch().clGetEventProfilingInfo(
-                        node.Event,
-                        CL_PROFILING_COMMAND_QUEUED,
-                        sizeof( commandQueued ),
-                        &commandQueued,
-                        NULL );
-                    errorCode |= dispatch().clGetEventProfilingInfo(
-                        node.Event,
-                        CL_PROFILING_COMMAND_SUBMIT,
-                        sizeof( commandSubmit ),
-                        &commandSubmit,
-                        NULL );
-                    errorCode |= dispatch().clGetEventProfilingInfo(
-                        node.Event,
-                        CL_PROFILING_COMMAND_START,
-                        sizeof( commandStart ),
-                        &commandStart,
-                        NULL );
-                    errorCode |= dispatch().clGetEventProfilingInfo(
-                        node.Event,
-                        CL_PROFILING_COMMAND_END,
-                        sizeof( commandEnd ),
-                        &commandEnd,
-                        NULL );
-                    if( errorCode == CL_SUCCESS )
-                    {
-                        cl_ulong delta = commandEnd - commandStart;
+            SDeviceTimingStats& deviceTimingStats = m_DeviceTimingStatsMap[node.Device][node.NameId];
 
-                        SDeviceTimingStats& deviceTimingStats = m_DeviceTimingStatsMap[node.Device][node.Name];
+            deviceTimingStats.NumberOfCalls++;
+            deviceTimingStats.TotalNS += delta;
+            deviceTimingStats.MinNS = std::min< cl_ulong >( deviceTimingStats.MinNS, delta );
+            deviceTimingStats.MaxNS = std::max< cl_ulong >( deviceTimingStats.MaxNS, delta );
+            deviceTimingStats.Histogram.add( delta );
 
-                        deviceTimingStats.NumberOfCalls++;
-                        deviceTimingStats.TotalNS += delta;
-                        deviceTimingStats.MinNS = std::min< cl_ulong >( deviceTimingStats.MinNS, delta );
-                        deviceTimingStats.MaxNS = std::max< cl_ulong >( deviceTimingStats.MaxNS, delta );
+            const double    meanDelta = delta - deviceTimingStats.MeanNS;
+            deviceTimingStats.MeanNS += meanDelta / deviceTimingStats.NumberOfCalls;
+            deviceTimingStats.M2NS += meanDelta * ( delta - deviceTimingStats.MeanNS );
 
-                        //uint64_t    numberOfCalls = deviceTimingStats.NumberOfCalls;
+            if( config().DevicePerformanceTimingOccupancy )
+            {
+                m_DeviceOccupancyMap[node.Device].add(
+                    commandStart,
+                    commandEnd,
+                    node.NameId );
+                m_QueueOccupancyMap[node.Device][node.QueueNumber].add(
+                    commandStart,
+                    commandEnd,
+                    node.NameId );
+            }
 
-                        if( config().DevicePerformanceTimeLogging )
-                        {
-                            cl_ulong    queuedDelta = commandSubmit - commandQueued;
-                            cl_ulong    submitDelta = commandStart - commandSubmit;
+            // Some implementations do not report queued or submit times for
+            // all commands, so only consistent timestamps are counted.
+            if( config().DevicePerformanceTimingStageStats &&
+                commandQueued != 0 &&
+                commandQueued <= commandSubmit &&
+                commandSubmit <= commandStart )
+            {
+                const cl_ulong  queuedDelta = commandSubmit - commandQueued;
+                const cl_ulong  submitDelta = commandStart - commandSubmit;
 
-                            std::ostringstream  ss;
+                SDeviceStageTimingStats& keyStats =
+                    m_DeviceStageTimingStatsMap[node.Device][node.NameId];
+                keyStats.QueuedToSubmit.add( queuedDelta );
+                keyStats.SubmitToStart.add( submitDelta );
 
-                            ss << "Device Time for "
-                                //<< "call " << numberOfCalls << " to "
-                                << node.Name << " (enqueue " << node.EnqueueCounter << ") = "
-                                << queuedDelta << " ns (queued -> submit), "
-                                << submitDelta << " ns (submit -> start), "
-                                << delta << " ns (start -> end)\n";
+                SDeviceStageTimingStats& queueStats =
+                    m_QueueStageTimingStatsMap[node.Device][node.QueueNumber];
+                queueStats.QueuedToSubmit.add( queuedDelta );
+                queueStats.SubmitToStart.add( submitDelta );
+            }
 
-                            log( ss.str() );
-                        }
+            //uint64_t    numberOfCalls = deviceTimingStats.NumberOfCalls;
 
-                        if( config().DevicePerformanceTimelineLogging )
-                        {
-                            std::ostringstream  ss;
+            if( config().DevicePerformanceTimeLogging )
+            {
+                cl_ulong    queuedDelta = commandSubmit - commandQueued;
+                cl_ulong    submitDelta = commandStart - commandSubmit;
 
-                            ss << "Device Timeline for "
-                                //<< "call " << numberOfCalls << " to "
-                                << node.Name << " (enqueue " << node.EnqueueCounter << ") = "
-                                << commandQueued << " ns (queued), "
-                                << commandSubmit << " ns (submit), "
-                                << commandStart << " ns (start), "
-                                << commandEnd << " ns (end)\n";
+                std::ostringstream  ss;
 
-                            log( ss.str() );
-                        }
+                ss << "Device Time for "
+                    //<< "call " << numberOfCalls << " to "
+                    << m_StringInterner.name(node.NameId) << " (enqueue " << node.EnqueueCounter << ") = "
+                    << queuedDelta << " ns (queued -> submit), "
+                    << submitDelta << " ns (submit -> start), "
+                    << delta << " ns (start -> end)\n";
 
-#if defined(USE_ITT)
-                        if( config().ITTPerformanceTiming )
-                        {
-                            ittTraceEvent(
-                                node.Name,
-                                node.Event,
-                                node.QueuedTime,
-                                commandQueued,
-                                commandSubmit,
-                                commandStart,
-                                commandEnd );
-                        }
-#endif
+                log( ss.str() );
+            }
 
-                        if( config().ChromePerformanceTiming )
-                        {
-                            bool useProfilingDelta =
-                                node.UseProfilingDelta &&
-                                !config().ChromePerformanceTimingEstimateQueuedTime;
-
-                            chromeTraceEvent(
-                                node.Name,
-                                useProfilingDelta,
-                                node.ProfilingDeltaNS,
-                                node.EnqueueCounter,
-                                node.QueueNumber,
-                                node.QueuedTime,
-                                commandQueued,
-                                commandSubmit,
-                                commandStart,
-                                commandEnd );
-                        }
+            if( config().DevicePerformanceTimelineLogging )
+            {
+                std::ostringstream  ss;
 
-                        if( config().DevicePerformanceTimingHistogram )
-                        {
-                            SDeviceTimingHistogram& histogram = m_DeviceTimingHistogramMap[node.Device];
+                ss << "Device Timeline for "
+                    //<< "call " << numberOfCalls << " to "
+                    << m_StringInterner.name(node.NameId) << " (enqueue " << node.EnqueueCounter << ") = "
+                    << commandQueued << " ns (queued), "
+                    << commandSubmit << " ns (submit), "
+                    << commandStart << " ns (start), "
+                    << commandEnd << " ns (end)\n";
 
-                            constexpr uint32_t cNumBins = SDeviceTimingHistogram::cNumBins;
-                            const uint32_t count = Utils::CountLeadingZeroes( delta );
-                            const uint32_t bin = count == 64 ? 0 :
-                                count <= ( 64 - cNumBins ) ? cNumBins - 1 :
-                                64 - count;
+                log( ss.str() );
+            }
 
-                            CLI_ASSERT( bin < cNumBins );
-                            histogram.Bins[bin]++;
-                        }
-                    }
-                }
+            // The profiling delta is computed from the clock model when the
+            // event is processed, rather than when the event is queued, so
+            // it includes any samples taken while the command executed.
+            int64_t profilingDeltaNS = 0;
+            bool    useProfilingDelta =
+                node.UseProfilingDelta &&
+                getProfilingDelta( node.Device, commandQueued, profilingDeltaNS );
 
-#if defined(USE_MDAPI)
-                if( config().DevicePerfCounterEventBasedSampling )
-                {
-                    getMDAPICountersFromEvent(
-                        node.Name,
-                        node.Event );
-                }
+#if defined(USE_ITT)
+            if( config().ITTPerformanceTiming )
+            {
+                ittTraceEvent(
+                    m_StringInterner.name(node.NameId),
+                    node.Event,
+                    useProfilingDelta,
+                    profilingDeltaNS,
+                    node.QueuedTime,
+                    commandQueued,
+                    commandSubmit,
+                    commandStart,
+                    commandEnd );
+            }
 #endif
 
-                dispatch().clReleaseEvent( node.Event );
-
-                m_EventList.erase( current );
-            }
-            break;
-        case CL_INVALID_EVENT:
+            if( config().DevicePerformanceTimingCriticalPath )
             {
-                // This is unexpected.  We retained the event when we
-                // added it to the list.  Remove the event from the
-                // list.
-                logf( "Unexpectedly got CL_INVALID_EVENT for an event from %s!\n",
-                    node.Name.c_str() );
+                const uint64_t  normalizedQueuedTimeNS = getNormalizedQueuedTimeNS(
+                    useProfilingDelta,
+                    profilingDeltaNS,
+                    node.QueuedTime,
+                    commandQueued );
+                m_CriticalPath.setCommandTime(
+                    node.EnqueueCounter,
+                    commandStart - commandQueued + normalizedQueuedTimeNS,
+                    commandEnd - commandQueued + normalizedQueuedTimeNS );
+            }
 
-                m_EventList.erase( current );
+            if( config().ChromePerformanceTiming )
+            {
+                chromeTraceEvent(
+                    node.NameId,
+                    useProfilingDelta &&
+                        !config().ChromePerformanceTimingEstimateQueuedTime,
+                    profilingDeltaNS,
+                    node.EnqueueCounter,
+                    node.QueueNumber,
+                    node.QueuedTime,
+                    commandQueued,
+                    commandSubmit,
+                    commandStart,
+                    commandEnd );
             }
-            break;
-        default:
-            // nothing
-            break;
         }
-
-        current = next;
     }
 
 #if defined(USE_MDAPI)
-    if( config().DevicePerfCounterTimeBasedSampling )
+    if( config().DevicePerfCounterEventBasedSampling )
     {
-        getMDAPICountersFromStream();
+        getMDAPICountersFromEvent(
+            m_StringInterner.name(node.NameId),
+            node.Event );
     }
 #endif
 }
@@ -7103,6 +9054,47 @@ void CLIntercept::checkRemoveDeviceInfo(
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// This function assumes that the kernel lock is held.
+void CLIntercept::initKernelInfoNames(
+    SKernelInfo& kernelInfo )
+{
+    addShortKernelName( kernelInfo.KernelName );
+
+    CLongKernelNameMap::const_iterator i =
+        m_LongKernelNameMap.find( kernelInfo.KernelName );
+    kernelInfo.ShortKernelName =
+        ( i != m_LongKernelNameMap.end() ) ?
+        i->second :
+        kernelInfo.KernelName;
+
+    CLI_ASSERT( kernelInfo.ShortKernelName.length() <= m_Config.LongKernelNameCutoff );
+
+    kernelInfo.ShortKernelNameWithHash = kernelInfo.ShortKernelName;
+    if( config().KernelNameHashTracking )
+    {
+        char    hashString[256] = "";
+        if( config().OmitProgramNumber )
+        {
+            CLI_SPRINTF( hashString, 256, "$%08X_%04u_%08X",
+                (unsigned int)kernelInfo.ProgramHash,
+                kernelInfo.CompileCount,
+                (unsigned int)kernelInfo.OptionsHash );
+        }
+        else
+        {
+            CLI_SPRINTF( hashString, 256, "$%04u_%08X_%04u_%08X",
+                kernelInfo.ProgramNumber,
+                (unsigned int)kernelInfo.ProgramHash,
+                kernelInfo.CompileCount,
+                (unsigned int)kernelInfo.OptionsHash );
+        }
+
+        kernelInfo.ShortKernelNameWithHash += hashString;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 void CLIntercept::addKernelInfo(
@@ -7111,23 +9103,22 @@ void CLIntercept::addKernelInfo(
     const std::string& kernelName )
 {
     std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
 
     const SProgramInfo& programInfo = m_ProgramInfoMap[ program ];
 
     SKernelInfo& kernelInfo = m_KernelInfoMap[ kernel ];
-    std::string demangledName = config().DemangleKernelNames ?
+    kernelInfo.KernelName = config().DemangleKernelNames ?
         demangle(kernelName) :
         kernelName;
 
-    kernelInfo.KernelName = demangledName;
-
     kernelInfo.ProgramHash = programInfo.ProgramHash;
     kernelInfo.OptionsHash = programInfo.OptionsHash;
 
     kernelInfo.ProgramNumber = programInfo.ProgramNumber;
     kernelInfo.CompileCount = programInfo.CompileCount - 1;
 
-    addShortKernelName( demangledName );
+    initKernelInfoNames( kernelInfo );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -7138,6 +9129,7 @@ void CLIntercept::addKernelInfo(
     cl_uint numKernels )
 {
     std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
 
     const SProgramInfo& programInfo = m_ProgramInfoMap[ program ];
 
@@ -7170,19 +9162,17 @@ void CLIntercept::addKernelInfo(
                     kernelName[ kernelNameSize ] = 0;
 
                     SKernelInfo& kernelInfo = m_KernelInfoMap[ kernel ];
-                    std::string demangledName = config().DemangleKernelNames ?
+                    kernelInfo.KernelName = config().DemangleKernelNames ?
                         demangle(kernelName) :
                         kernelName;
 
-                    kernelInfo.KernelName = demangledName;
-
                     kernelInfo.ProgramHash = programInfo.ProgramHash;
                     kernelInfo.OptionsHash = programInfo.OptionsHash;
 
                     kernelInfo.ProgramNumber = programInfo.ProgramNumber;
                     kernelInfo.CompileCount = programInfo.CompileCount - 1;
 
-                    addShortKernelName( demangledName );
+                    initKernelInfoNames( kernelInfo );
                 }
 
                 delete [] kernelName;
@@ -7197,16 +9187,19 @@ void CLIntercept::addKernelInfo(
     const cl_kernel kernel,
     const cl_kernel source_kernel )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
 
-    m_KernelInfoMap[ kernel ] = m_KernelInfoMap[ source_kernel ];
+    // Copy the source kernel info first, since inserting the new kernel may
+    // move the entries in the kernel info map.
+    const SKernelInfo   kernelInfo = m_KernelInfoMap[ source_kernel ];
+    m_KernelInfoMap[ kernel ] = kernelInfo;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //
 void CLIntercept::checkRemoveKernelInfo( cl_kernel kernel )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
 
     cl_uint refCount = getRefCount( kernel );
     if( refCount == 1 )
@@ -7418,7 +9411,7 @@ void CLIntercept::addSamplerString(
 {
     if( sampler )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
         m_SamplerDataMap[sampler] = str;
     }
 }
@@ -7428,7 +9421,7 @@ void CLIntercept::addSamplerString(
 void CLIntercept::checkRemoveSamplerString(
     cl_sampler sampler )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     cl_uint refCount = getRefCount( sampler );
     if( refCount == 1 )
@@ -7469,11 +9462,24 @@ void CLIntercept::addQueue(
 {
     if( queue )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        {
+            std::lock_guard<std::mutex> queueInfoLock(m_QueueInfoMutex);
+
+            SQueueInfo& queueInfo = m_QueueInfoMap[ queue ];
+            queueInfo = SQueueInfo();
+            queueInfo.Number = m_QueueNumber + 1;   // should be nonzero
+            m_QueueNumber++;
+        }
 
-        m_QueueNumberMap[ queue ] = m_QueueNumber + 1;  // should be nonzero
-        m_QueueNumber++;
+        if( config().DevicePerformanceTiming ||
+            config().ITTPerformanceTiming ||
+            config().ChromePerformanceTiming ||
+            config().DevicePerfCounterEventBasedSampling )
+        {
+            getQueueInfo( queue );
+        }
 
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_ContextQueuesMap[context].push_back(queue);
     }
 }
@@ -7488,7 +9494,30 @@ void CLIntercept::checkRemoveQueue(
     cl_uint refCount = getRefCount( queue );
     if( refCount == 1 )
     {
-        m_QueueNumberMap.erase( queue );
+        {
+            std::lock_guard<std::mutex> queueInfoLock(m_QueueInfoMutex);
+            m_QueueInfoMap.erase( queue );
+        }
+
+        // Remove the queue's timing events once they have been processed.
+        // Note: This nests the timing mutex inside the intercept mutex, in
+        // the same order as report().
+        {
+            std::lock_guard<std::mutex> timingLock(m_TimingMutex);
+            CQueueTimingEventsMap::iterator iter =
+                m_QueueTimingEventsMap.find( queue );
+            if( iter != m_QueueTimingEventsMap.end() )
+            {
+                if( iter->second.Events.empty() )
+                {
+                    m_QueueTimingEventsMap.erase( iter );
+                }
+                else
+                {
+                    iter->second.Released = true;
+                }
+            }
+        }
 
         cl_context  context = NULL;
 
@@ -7546,7 +9575,7 @@ void CLIntercept::addBuffer(
 {
     if( buffer )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
         cl_int  errorCode = CL_SUCCESS;
         size_t  size = 0;
@@ -7574,7 +9603,7 @@ void CLIntercept::addImage(
 {
     if( image )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
         cl_int  errorCode = CL_SUCCESS;
 
@@ -7695,7 +9724,7 @@ void CLIntercept::addImage(
 void CLIntercept::checkRemoveMemObj(
     cl_mem memobj )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     cl_uint refCount = getRefCount( memobj );
     if( refCount == 1 )
@@ -7714,7 +9743,7 @@ void CLIntercept::addSVMAllocation(
 {
     if( svmPtr )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
         m_MemAllocNumberMap[ svmPtr ] = m_MemAllocNumber;
         m_SVMAllocInfoMap[ svmPtr ] = size;
@@ -7727,7 +9756,7 @@ void CLIntercept::addSVMAllocation(
 void CLIntercept::removeSVMAllocation(
     void* svmPtr )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     m_MemAllocNumberMap.erase( svmPtr );
     m_SVMAllocInfoMap.erase( svmPtr );
@@ -7741,7 +9770,7 @@ void CLIntercept::addUSMAllocation(
 {
     if( usmPtr )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
         m_MemAllocNumberMap[ usmPtr ] = m_MemAllocNumber;
         m_USMAllocInfoMap[ usmPtr ] = size;
@@ -7754,7 +9783,7 @@ void CLIntercept::addUSMAllocation(
 void CLIntercept::removeUSMAllocation(
     void* usmPtr )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     m_MemAllocNumberMap.erase( usmPtr );
     m_USMAllocInfoMap.erase( usmPtr );
@@ -7768,7 +9797,8 @@ void CLIntercept::setKernelArg(
     const void* arg_value,
     size_t arg_size )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     if( arg_value != nullptr )
     {
@@ -7809,7 +9839,8 @@ void CLIntercept::setKernelArgSVMPointer(
     cl_uint arg_index,
     const void* arg )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     if( m_SVMAllocInfoMap.empty() )
     {
@@ -7851,7 +9882,8 @@ void CLIntercept::setKernelArgUSMPointer(
     cl_uint arg_index,
     const void* arg )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     if( m_USMAllocInfoMap.empty() )
     {
@@ -8116,6 +10148,8 @@ void CLIntercept::dumpBuffersForKernel(
     cl_command_queue command_queue )
 {
     std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     cl_platform_id  platform = getPlatform(kernel);
 
@@ -8365,7 +10399,8 @@ void CLIntercept::dumpImagesForKernel(
     cl_kernel kernel,
     cl_command_queue command_queue )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     std::vector<char>   transferBuf;
     std::string captureReplayPrefix;
@@ -8529,6 +10564,8 @@ void CLIntercept::injectBuffersForKernel(
     cl_command_queue command_queue )
 {
     std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     cl_platform_id  platform = getPlatform(kernel);
 
@@ -8725,7 +10762,8 @@ void CLIntercept::injectImagesForKernel(
     cl_kernel kernel,
     cl_command_queue command_queue )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     std::vector<char>   transferBuf;
     std::string prefix;
@@ -8860,7 +10898,7 @@ void CLIntercept::dumpArgument(
 {
     if( kernel )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
 
         std::string fileName = "";
 
@@ -8929,7 +10967,7 @@ void CLIntercept::dumpBuffer(
     size_t offset,
     size_t size )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     if( m_BufferInfoMap.find( memobj ) != m_BufferInfoMap.end() )
     {
@@ -9051,7 +11089,7 @@ void CLIntercept::addMapPointer(
 {
     if( ptr )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
         if( m_MapPointerInfoMap.find(ptr) != m_MapPointerInfoMap.end() )
         {
@@ -9074,7 +11112,7 @@ void CLIntercept::removeMapPointer(
 {
     if( ptr )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
         m_MapPointerInfoMap.erase(ptr);
     }
 }
@@ -9089,7 +11127,6 @@ void CLIntercept::checkEventList(
 {
     if( numEvents != 0 && eventList == NULL )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
         logf( "Check Events for %s: Num Events is %u, but Event List is NULL!\n",
             functionName,
             numEvents );
@@ -9100,7 +11137,6 @@ void CLIntercept::checkEventList(
         {
             if( event != NULL && *event == eventList[i] )
             {
-                std::lock_guard<std::mutex> lock(m_Mutex);
                 logf( "Check Events for %s: outgoing event %p is also in the event wait list!\n",
                     functionName,
                     eventList[i] );
@@ -9116,7 +11152,6 @@ void CLIntercept::checkEventList(
                 NULL );
             if( errorCode != CL_SUCCESS )
             {
-                std::lock_guard<std::mutex> lock(m_Mutex);
                 logf( "Check Events for %s: clGetEventInfo for wait event %p returned %s (%d)!\n",
                     functionName,
                     eventList[i],
@@ -9125,7 +11160,6 @@ void CLIntercept::checkEventList(
             }
             else if( eventCommandExecutionStatus < 0 )
             {
-                std::lock_guard<std::mutex> lock(m_Mutex);
                 logf( "Check Events for %s: wait event %p is in an error state (%d)!\n",
                     functionName,
                     eventList[i],
@@ -9503,7 +11537,8 @@ void CLIntercept::startCaptureReplay(
     const size_t* gws,
     const size_t* lws )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+    std::lock_guard<std::mutex> memObjLock(m_MemObjMutex);
 
     std::string fileNamePrefix = "";
 
@@ -9551,7 +11586,8 @@ void CLIntercept::startAubCapture(
 {
     if( m_AubCaptureStarted == false )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+        std::lock_guard<std::mutex> captureLock(m_CaptureMutex);
 
         // For kernels, perform aub capture skip checks.  We'll skip aubcapture if:
         // - the current skip counter is less than the specified skip counter, or
@@ -9719,7 +11755,7 @@ void CLIntercept::stopAubCapture(
 {
     if( m_AubCaptureStarted == true )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> captureLock(m_CaptureMutex);
 
         if( m_AubCaptureStarted == true )
         {
@@ -13676,12 +15712,12 @@ void* CLIntercept::getExtensionFunctionAddress(
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-// This function assumes that CLIntercept already has entered its
-// critical section.  If it hasn't, bad things could happen.
 void CLIntercept::log( const std::string& s )
 {
     if( m_Config.SuppressLogging == false )
     {
+        std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
+
         std::string logString( m_Config.LogIndent, ' ' );
         logString += s;
         if( m_Config.LogToFile )
@@ -13706,6 +15742,8 @@ void CLIntercept::log( const std::string& s )
 }
 void CLIntercept::logf( const char* formatStr, ... )
 {
+    std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
+
     va_list args;
     va_start( args, formatStr );
 
@@ -14227,7 +16265,7 @@ void CLIntercept::ittCallLoggingEnter(
     std::string str( functionName );
     if( kernel )
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
 
         const std::string& kernelName = getShortKernelNameWithHash(kernel);
         str += "( ";
@@ -14248,7 +16286,7 @@ void CLIntercept::ittRegisterCommandQueue(
     cl_command_queue queue,
     bool supportsPerfCounters )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> timingLock(m_TimingMutex);
 
     cl_int  errorCode = CL_SUCCESS;
 
@@ -14294,6 +16332,7 @@ void CLIntercept::ittRegisterCommandQueue(
         queueInfo.itt_track = NULL;
         queueInfo.itt_clock_domain = NULL;
         queueInfo.CLReferenceTime = 0;
+        queueInfo.UseProfilingDelta = false;
 
 #if 0
         std::string trackName = "OpenCL";
@@ -14358,7 +16397,7 @@ void CLIntercept::ittRegisterCommandQueue(
 void CLIntercept::ittReleaseCommandQueue(
     cl_command_queue queue )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> timingLock(m_TimingMutex);
 
     if( m_ITTQueueInfoMap.find(queue) != m_ITTQueueInfoMap.end() )
     {
@@ -14389,6 +16428,8 @@ void ITTAPI CLIntercept::ittClockInfoCallback(
 void CLIntercept::ittTraceEvent(
     const std::string& name,
     cl_event event,
+    bool useProfilingDelta,
+    int64_t profilingDeltaNS,
     clock::time_point queuedTime,
     cl_ulong commandQueued,
     cl_ulong commandSubmit,
@@ -14421,11 +16462,19 @@ void CLIntercept::ittTraceEvent(
         {
             SITTQueueInfo&  queueInfo = m_ITTQueueInfoMap[ queue ];
 
+            using ns = std::chrono::nanoseconds;
+
             __itt_clock_domain* clockDomain = queueInfo.itt_clock_domain;
             if( clockDomain == NULL )
             {
+                // If the device has a clock model then the clock domain is
+                // the Intercept Layer's timer, otherwise the clock domain is
+                // the device timer, aligned to the first queued time.
+                queueInfo.UseProfilingDelta = useProfilingDelta;
                 queueInfo.CPUReferenceTime = queuedTime;
-                queueInfo.CLReferenceTime = commandQueued;
+                queueInfo.CLReferenceTime = useProfilingDelta ?
+                    std::chrono::duration_cast<ns>(queuedTime.time_since_epoch()).count() :
+                    commandQueued;
 
                 clockDomain = __itt_clock_domain_create(
                     ittClockInfoCallback,
@@ -14441,9 +16490,15 @@ void CLIntercept::ittTraceEvent(
             __itt_track*    track = queueInfo.itt_track;
             uint64_t        clockOffset = 0;
 
-            if( commandQueued == 0 )
+            if( queueInfo.UseProfilingDelta )
+            {
+                clockOffset = useProfilingDelta ?
+                    profilingDeltaNS :
+                    std::chrono::duration_cast<ns>(
+                        queuedTime.time_since_epoch()).count() - commandQueued;
+            }
+            else if( commandQueued == 0 )
             {
-                using ns = std::chrono::nanoseconds;
                 clockOffset = std::chrono::duration_cast<ns>(
                     queuedTime - queueInfo.CPUReferenceTime).count();
             }
@@ -14507,12 +16562,16 @@ void CLIntercept::chromeCallLoggingExit(
     clock::time_point tickStart,
     clock::time_point tickEnd )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    CSelfOverheadScope  selfOverheadScope(
+        selfOverhead(),
+        CSelfOverhead::cStage_ChromeCallLogging );
 
-    uint64_t    threadId = OS().GetThreadID();
+    // This does not take the log mutex, so Chrome call logging does not
+    // serialize application threads.  Registering the thread takes its own
+    // lock, and the Chrome tracer is thread safe.
 
     // This will name the thread if it is not named already.
-    getThreadNumber( threadId );
+    const uint64_t  threadId = getThreadInfo().ThreadId;
 
     using ns = std::chrono::nanoseconds;
     uint64_t    nsStart =
@@ -14543,6 +16602,33 @@ void CLIntercept::chromeCallLoggingExit(
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::chromeSelfOverheadCounters()
+{
+    // Each counter is the time spent in the stage since the previous sample,
+    // so the counter track shows where the instrumentation time is going
+    // rather than how much has accumulated.
+    const char* names[CSelfOverhead::cNumStages];
+    uint64_t    intervalNS[CSelfOverhead::cNumStages];
+    for( uint32_t stage = 0; stage < CSelfOverhead::cNumStages; stage++ )
+    {
+        names[stage] = CSelfOverhead::stageName( (CSelfOverhead::EStage)stage );
+    }
+    m_SelfOverhead.sampleIntervalNS( intervalNS );
+
+    using ns = std::chrono::nanoseconds;
+    uint64_t    nsTime =
+        std::chrono::duration_cast<ns>(clock::now() - m_StartTime).count();
+
+    m_ChromeTrace.addCounters(
+        "Self Overhead (ns)",
+        nsTime,
+        CSelfOverhead::cNumStages,
+        names,
+        intervalNS );
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 void CLIntercept::chromeRegisterCommandQueue(
@@ -14550,6 +16636,19 @@ void CLIntercept::chromeRegisterCommandQueue(
 {
     std::lock_guard<std::mutex> lock(m_Mutex);
 
+    unsigned int    queueNumber = 0;
+    {
+        std::lock_guard<std::mutex> queueInfoLock(m_QueueInfoMutex);
+
+        CQueueInfoMap::const_iterator iter = m_QueueInfoMap.find( queue );
+        if( iter != m_QueueInfoMap.end() )
+        {
+            queueNumber = iter->second.Number;
+        }
+    }
+
+    std::lock_guard<std::recursive_mutex> logLock(m_LogMutex);
+
     cl_int  errorCode = CL_SUCCESS;
 
     cl_device_id                device = NULL;
@@ -14577,8 +16676,6 @@ void CLIntercept::chromeRegisterCommandQueue(
 
     if( errorCode == CL_SUCCESS )
     {
-        unsigned int    queueNumber = m_QueueNumberMap[ queue ];
-
         std::string trackName;
 
         if( properties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE )
@@ -14640,17 +16737,11 @@ void CLIntercept::chromeRegisterCommandQueue(
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-void CLIntercept::chromeTraceEvent(
-    const std::string& name,
+uint64_t CLIntercept::getNormalizedQueuedTimeNS(
     bool useProfilingDelta,
     int64_t profilingDeltaNS,
-    uint64_t enqueueCounter,
-    unsigned int queueNumber,
     clock::time_point queuedTime,
-    cl_ulong commandQueued,
-    cl_ulong commandSubmit,
-    cl_ulong commandStart,
-    cl_ulong commandEnd )
+    cl_ulong commandQueued ) const
 {
     using ns = std::chrono::nanoseconds;
     const uint64_t  startTimeNS =
@@ -14664,12 +16755,33 @@ void CLIntercept::chromeTraceEvent(
     // valid and if it is within a threshold of the measured queued time.
     // The threshold is to work around buggy device and host timers.
     const uint64_t  threshold = 1000000000;   // 1s
-    const uint64_t  normalizedQueuedTimeNS =
+    return
         useProfilingDelta &&
         profilingQueuedTimeNS >= estimatedQueuedTimeNS &&
         profilingQueuedTimeNS - estimatedQueuedTimeNS < threshold ?
         profilingQueuedTimeNS - startTimeNS :
         estimatedQueuedTimeNS - startTimeNS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+void CLIntercept::chromeTraceEvent(
+    CStringInterner::Id nameId,
+    bool useProfilingDelta,
+    int64_t profilingDeltaNS,
+    uint64_t enqueueCounter,
+    unsigned int queueNumber,
+    clock::time_point queuedTime,
+    cl_ulong commandQueued,
+    cl_ulong commandSubmit,
+    cl_ulong commandStart,
+    cl_ulong commandEnd )
+{
+    const uint64_t  normalizedQueuedTimeNS = getNormalizedQueuedTimeNS(
+        useProfilingDelta,
+        profilingDeltaNS,
+        queuedTime,
+        commandQueued );
 
     //if( useProfilingDelta )
     //{
@@ -14681,7 +16793,7 @@ void CLIntercept::chromeTraceEvent(
     //        "\tprofilingQueuedTimeNS is %llu ns (%.2f us)\n"
     //        "\testimated time is %s than profiling time\n"
     //        "\tdeltaNS is %llu ns (%.2f us)\n",
-    //        name.c_str(),
+    //        m_StringInterner.name(nameId).c_str(),
     //        commandQueued, commandQueued / 1000.0,
     //        estimatedQueuedTimeNS, estimatedQueuedTimeNS / 1000.0,
     //        profilingQueuedTimeNS, profilingQueuedTimeNS / 1000.0,
@@ -14702,7 +16814,7 @@ void CLIntercept::chromeTraceEvent(
         if( m_Config.ChromePerformanceTimingPerKernel )
         {
             m_ChromeTrace.addDeviceTiming(
-                name,
+                nameId,
                 nsQueued,
                 nsSubmit,
                 nsStart,
@@ -14712,7 +16824,7 @@ void CLIntercept::chromeTraceEvent(
         else
         {
             m_ChromeTrace.addDeviceTiming(
-                name,
+                nameId,
                 m_EventsChromeTraced,
                 queueNumber,
                 nsQueued,
@@ -14727,11 +16839,11 @@ void CLIntercept::chromeTraceEvent(
     {
         if( m_Config.ChromePerformanceTimingPerKernel )
         {
-            m_ChromeTrace.addDeviceTiming( name, nsStart, nsEnd, enqueueCounter );
+            m_ChromeTrace.addDeviceTiming( nameId, nsStart, nsEnd, enqueueCounter );
         }
         else
         {
-            m_ChromeTrace.addDeviceTiming( name, queueNumber, nsStart, nsEnd, enqueueCounter );
+            m_ChromeTrace.addDeviceTiming( nameId, queueNumber, nsStart, nsEnd, enqueueCounter );
         }
     }
 }
@@ -14740,7 +16852,8 @@ void CLIntercept::chromeTraceEvent(
 //
 bool CLIntercept::checkCaptureReplayKernelSkips( const cl_kernel kernel )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+    std::lock_guard<std::mutex> captureLock(m_CaptureMutex);
 
     bool    skip = false;
     if( m_CaptureReplayKernelEnqueueSkipCounter < m_Config.CaptureReplayNumKernelEnqueuesSkip )
@@ -14817,7 +16930,8 @@ bool CLIntercept::checkAubCaptureKernelSignature(
     const size_t* gws,
     const size_t* lws )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+    std::lock_guard<std::mutex> captureLock(m_CaptureMutex);
 
     bool    match = true;
 
@@ -15052,7 +17166,7 @@ void* CLIntercept::emulatedHostMemAlloc(
     cl_uint alignment,
     cl_int* errcode_ret)
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> usmLock(m_USMEmulationMutex);
 
     if( !validateUSMMemProperties(properties) )
     {
@@ -15119,7 +17233,7 @@ void* CLIntercept::emulatedDeviceMemAlloc(
     cl_uint alignment,
     cl_int* errcode_ret)
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> usmLock(m_USMEmulationMutex);
 
     if( !validateUSMMemProperties(properties) )
     {
@@ -15175,7 +17289,7 @@ void* CLIntercept::emulatedSharedMemAlloc(
     cl_uint alignment,
     cl_int* errcode_ret)
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> usmLock(m_USMEmulationMutex);
 
     if( !validateUSMMemProperties(properties) )
     {
@@ -15239,7 +17353,7 @@ cl_int CLIntercept::emulatedMemFree(
     cl_context context,
     const void* ptr )
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> usmLock(m_USMEmulationMutex);
 
     SUSMContextInfo&    usmContextInfo = m_USMContextInfoMap[context];
 
@@ -15406,7 +17520,7 @@ cl_int CLIntercept::trackUSMKernelExecInfo(
     size_t param_value_size,
     const void* param_value)
 {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> usmLock(m_USMEmulationMutex);
 
     cl_int  retVal = CL_INVALID_VALUE;
 
@@ -15484,6 +17598,9 @@ cl_int CLIntercept::setUSMKernelExecInfo(
     cl_command_queue commandQueue,
     cl_kernel kernel )
 {
+    std::lock_guard<std::mutex> kernelLock(m_KernelMutex);
+    std::lock_guard<std::mutex> usmLock(m_USMEmulationMutex);
+
     const SUSMKernelInfo& usmKernelInfo = m_USMKernelInfoMap[ kernel ];
 
     cl_int  errorCode = CL_SUCCESS;
@@ -15502,8 +17619,6 @@ cl_int CLIntercept::setUSMKernelExecInfo(
 
         const SUSMContextInfo& usmContextInfo = m_USMContextInfoMap[context];
 
-        std::lock_guard<std::mutex> lock(m_Mutex);
-
         bool    hasSVMPtrs =
                     !usmKernelInfo.SVMPtrs.empty();
         bool    hasUSMPtrs =
@@ -7,6 +7,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cinttypes>
 #include <fstream>
 #include <list>
@@ -16,7 +17,9 @@
 #include <queue>
 #include <set>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <stdint.h>
 
@@ -27,6 +30,14 @@
 #include "enummap.h"
 #include "dispatch.h"
 #include "objtracker.h"
+#include "pointermap.h"
+#include "ringbuffer.h"
+#include "clockmodel.h"
+#include "criticalpath.h"
+#include "histogram.h"
+#include "occupancy.h"
+#include "selfoverhead.h"
+#include "stringinterner.h"
 
 #include "instrumentation.h"
 
@@ -58,6 +69,12 @@ public:
     using clock = std::chrono::steady_clock;
 #endif
 
+    // Host and device timing stats include a log-linear histogram of the
+    // times, so percentiles can be reported using a fixed amount of memory
+    // for each key.  Times of 2^40 ns (about 18 minutes) or more are
+    // counted in the last bucket.
+    typedef CLogLinearHistogram< 3, 40 >    CTimingHistogram;
+
     static bool Create( void* pGlobalData, CLIntercept*& pIntercept );
     static void Delete( CLIntercept*& pIntercept );
 
@@ -461,6 +478,12 @@ public:
                 uint64_t enqueueCounter ) const;
     bool    checkDevicePerformanceTimingEnqueueLimits(
                 uint64_t enqueueCounter ) const;
+    bool    checkDevicePerformanceTimingSample(
+                cl_command_queue queue,
+                const char* name );
+    bool    sampleDevicePerformanceTiming(
+                cl_command_queue queue,
+                const char* name );
 
     void    addTimingEvent(
                 const char* functionName,
@@ -468,9 +491,24 @@ public:
                 const clock::time_point queuedTime,
                 const std::string& tag,
                 const cl_command_queue queue,
-                cl_event event );
+                cl_event event,
+                bool retainEvent );
     void    checkTimingEvents();
 
+    void    addCriticalPathDependencies(
+                uint64_t enqueueCounter,
+                cl_uint numEvents,
+                const cl_event* eventList );
+    void    addCriticalPathWaitForEvents(
+                const char* functionName,
+                clock::time_point waitStart,
+                cl_uint numEvents,
+                const cl_event* eventList );
+    void    addCriticalPathFinish(
+                const char* functionName,
+                clock::time_point waitStart,
+                cl_command_queue queue );
+
     cl_command_queue    getCommandBufferCommandQueue(
                 cl_uint numQueues,
                 const cl_command_queue* queues,
@@ -881,11 +919,60 @@ public:
 
     const SConfig&  config() const;
 
+    // These are the features that may apply to an entry point with a
+    // pass-through fast path.  Each feature is enabled by one or more
+    // controls.  Any control that is not set to its default value and is
+    // not associated with a specific feature enables cFeatureOther, which
+    // applies to every entry point, so unrecognized controls always disable
+    // the fast path.
+    enum
+    {
+        cFeatureCallLogging     = 0x01,
+        cFeatureErrorChecking   = 0x02,
+        cFeatureLeakChecking    = 0x04,
+        cFeatureHostTiming      = 0x08,
+        cFeatureDeviceTiming    = 0x10,
+        cFeatureEnqueue         = 0x20,
+        cFeatureKernelEnqueue   = 0x40,
+        cFeatureOther           = 0x80,
+
+        cFeatureMaskCommon =
+            cFeatureCallLogging |
+            cFeatureErrorChecking |
+            cFeatureLeakChecking |
+            cFeatureHostTiming |
+            cFeatureOther,
+        cFeatureMaskKernelArgs =
+            cFeatureMaskCommon |
+            cFeatureKernelEnqueue,
+        cFeatureMaskEnqueue =
+            cFeatureMaskCommon |
+            cFeatureDeviceTiming |
+            cFeatureEnqueue,
+        cFeatureMaskKernelEnqueue =
+            cFeatureMaskEnqueue |
+            cFeatureKernelEnqueue,
+    };
+
+    enum EFastPathEntryPoint
+    {
+#define CLI_FAST_PATH_ENTRY_POINT( _name, _features )   cFastPath_##_name,
+#include "fastpath.h"
+#undef CLI_FAST_PATH_ENTRY_POINT
+        cNumFastPathEntryPoints
+    };
+
+    bool    checkFastPath( EFastPathEntryPoint entryPoint ) const;
+
     uint64_t    getEnqueueCounter() const;
     uint64_t    incrementEnqueueCounter();
 
     CObjectTracker& objectTracker();
 
+    // Returns NULL if self overhead profiling is disabled.
+    CSelfOverhead*  selfOverhead();
+    void    chromeSelfOverheadCounters();
+
     bool    checkDumpBuffersForKernel( const cl_kernel kernel );
     bool    checkDumpImagesForKernel( const cl_kernel kernel );
     bool    checkDumpBufferEnqueueLimits( uint64_t enqueueCounter ) const;
@@ -902,7 +989,16 @@ public:
                 const size_t* gws,
                 const size_t* lws);
 
-    unsigned int    getThreadNumber( uint64_t threadId );
+    // Information about an application thread that is cached in thread-
+    // local storage, so it can be queried without a lock or a system call.
+    struct SThreadInfo
+    {
+        const CLIntercept*  pIntercept;
+        uint64_t        ThreadId;
+        unsigned int    ThreadNumber;
+    };
+
+    const SThreadInfo&  getThreadInfo();
 
     void    saveProgramNumber( const cl_program program );
     unsigned int    getProgramNumber() const;
@@ -933,6 +1029,8 @@ public:
     void    ittTraceEvent(
                 const std::string& name,
                 cl_event event,
+                bool useProfilingDelta,
+                int64_t profilingDeltaNS,
                 clock::time_point queuedTime,
                 cl_ulong commandQueued,
                 cl_ulong commandSubmit,
@@ -950,7 +1048,7 @@ public:
     void    chromeRegisterCommandQueue(
                 cl_command_queue queue );
     void    chromeTraceEvent(
-                const std::string& name,
+                CStringInterner::Id nameId,
                 bool useProfilingDelta,
                 int64_t profilingDeltaNS,
                 uint64_t enqueueCounter,
@@ -1010,8 +1108,11 @@ private:
     static const char* sc_URL;
     static const char* sc_DumpDirectoryName;
     static const char* sc_ReportFileName;
+    static const char* sc_ReportJSONFileName;
     static const char* sc_LogFileName;
     static const char* sc_TraceFileName;
+    static const char* sc_BinaryTraceFileName;
+    static const char* sc_PerfettoTraceFileName;
     static const char* sc_PerfCountersFileNamePrefix;
 
 #if defined(CLINTERCEPT_CMAKE)
@@ -1042,16 +1143,18 @@ private:
 
     void    addShortKernelName(
                 const std::string& kernelName );
-    std::string getShortKernelName(
-                    const cl_kernel kernel );
-    std::string getShortKernelNameWithHash(
-                    const cl_kernel kernel );
+    const std::string&  getShortKernelName(
+                            const cl_kernel kernel ) const;
+    const std::string&  getShortKernelNameWithHash(
+                            const cl_kernel kernel ) const;
 
     void    getCallLoggingPrefix(
                 std::string& str );
 
     void    writeReport(
                 std::ostream& os );
+    void    writeReportJSON(
+                std::ostream& os );
 
     void    dumpCaptureReplayKernelSource(
                 const std::string& dumpDirectory,
@@ -1068,7 +1171,54 @@ private:
                 cl_kernel kernel );
 
     uint64_t        m_ProcessId;
+
+    // Locking is split into domains so that unrelated work, such as call
+    // logging and device timing, does not serialize on a single mutex.
+    //
+    //  m_Mutex:            Everything not covered below: platforms, devices,
+    //                      programs, queues, events, command buffers, etc.
+    //  m_QueueInfoMutex:   The queue info cache and queue numbers.
+    //  m_KernelMutex:      Kernel info, long kernel names, and kernel args.
+    //  m_MemObjMutex:      Buffers, images, SVM and USM allocations, samplers,
+    //                      and mapped pointers.
+    //  m_USMEmulationMutex: Emulated USM context and kernel info.
+    //  m_CaptureMutex:     Capture replay and aubcapture state.
+    //  m_TimingMutex:      Host and device timing stats, device timing
+    //                      sample state, the pending event list, ITT queue
+    //                      info, and MDAPI counters.
+    //  m_LogMutex:         The log file, the shared string buffer, and
+    //                      thread registration.  This is recursive so that
+    //                      log() and logf() can lock it, and so a sequence
+    //                      of log calls may be kept together.
+    //
+    // When more than one domain lock is needed they must be acquired in
+    // the order listed above.  m_LogMutex is always the innermost lock,
+    // and no other domain lock may be acquired while it is held.
     std::mutex      m_Mutex;
+    std::mutex      m_QueueInfoMutex;
+    std::mutex      m_KernelMutex;
+    std::mutex      m_MemObjMutex;
+    std::mutex      m_USMEmulationMutex;
+    std::mutex      m_CaptureMutex;
+    std::mutex      m_TimingMutex;
+    std::recursive_mutex    m_LogMutex;
+
+    // Interval reports are written by a background reporter thread, so an
+    // application thread never waits for a report to be written.  The
+    // reporter thread wakes up when the wall-clock report interval expires
+    // or when the enqueue counter reaches the report interval.  The
+    // reporter mutex only protects the reporter state and is never held
+    // while acquiring any other lock.
+    std::thread     m_ReporterThread;
+    std::mutex      m_ReporterMutex;
+    std::condition_variable m_ReporterCondition;
+    bool            m_ReporterExit;
+    bool            m_ReportRequested;
+
+    void    startReporterThread();
+    void    stopReporterThread();
+    void    requestReport();
+    void    reporterThread();
 
     typedef std::map< cl_platform_id, CLdispatchX > CLdispatchXMap;
 
@@ -1077,6 +1227,16 @@ private:
     CLdispatchXMap  m_DispatchX;
     CEnumNameMap    m_EnumNameMap;
     CObjectTracker  m_ObjectTracker;
+    CSelfOverhead   m_SelfOverhead;
+
+    // The number of enqueues between each sample of the self overhead
+    // counters that are added to the Chrome trace.
+    static const uint64_t   cSelfOverheadCounterInterval = 256;
+
+    // Interned names for timing stats, pending events, and trace records.
+    // This is declared before the Chrome tracer because the tracer resolves
+    // interned names when it flushes during destruction.
+    CStringInterner m_StringInterner;
 
     void*       m_OpenCLLibraryHandle;
 
@@ -1089,10 +1249,18 @@ private:
 
     std::atomic<uint64_t>   m_EnqueueCounter;
 
+    // For each entry point with a fast path, the enabled features that
+    // apply to the entry point.  These are computed once during init.
+    uint32_t    m_FastPathFeatures[cNumFastPathEntryPoints];
+
+    void    initFastPath();
+
     clock::time_point   m_StartTime;
 
-    typedef std::map< uint64_t, unsigned int>   CThreadNumberMap;
-    CThreadNumberMap    m_ThreadNumberMap;
+    unsigned int    m_ThreadCount;
+
+    void    registerThread(
+                SThreadInfo& threadInfo );
 
     typedef std::map< cl_device_id, std::vector<cl_device_id> > CSubDeviceCacheMap;
     CSubDeviceCacheMap  m_SubDeviceCacheMap;
@@ -1134,11 +1302,36 @@ private:
         uint64_t    MinNS = ULLONG_MAX;
         uint64_t    MaxNS = 0;
         uint64_t    TotalNS = 0;
+
+        CTimingHistogram    Histogram;
     };
 
     typedef std::unordered_map< std::string, SHostTimingStats > CHostTimingStatsMap;
     CHostTimingStatsMap  m_HostTimingStatsMap;
 
+    // Host timing stats are accumulated into per-thread tables so the common
+    // case needs neither the timing lock nor a heap-allocated key.  The tables
+    // are keyed by the function name pointer, which is a string literal, and
+    // then by the interned tag ID.  Each table has its own mutex, which is
+    // only contended when the tables are merged into a single map for the
+    // report.
+
+    typedef std::unordered_map< CStringInterner::Id, SHostTimingStats > CHostTimingTagStatsMap;
+    typedef std::unordered_map< const char*, CHostTimingTagStatsMap >   CHostTimingFunctionStatsMap;
+
+    struct SHostTimingThreadStats
+    {
+        std::mutex  Mutex;
+        CHostTimingFunctionStatsMap FunctionStatsMap;
+    };
+
+    typedef std::vector< SHostTimingThreadStats* >  CHostTimingThreadStatsList;
+    CHostTimingThreadStatsList  m_HostTimingThreadStatsList;
+
+    SHostTimingThreadStats& getHostTimingThreadStats();
+    void    getHostTimingStats(
+                CHostTimingStatsMap& hostTimingStatsMap );
+
     // These structures define a mapping between a platform or device ID handle and
     // properties of a platform or device, for easier querying.
 
@@ -1169,7 +1362,12 @@ private:
         cl_uint     MaxClockFrequency;
 
         bool        HasDeviceAndHostTimer;
-        int64_t     DeviceHostTimeDeltaNS;
+
+        // The time of the most recent sample of the device timer, which is
+        // used to decide when to sample the device timer again.  These are
+        // guarded by the timing mutex.
+        bool                HasClockSample;
+        clock::time_point   ClockSampleTime;
 
         bool        Supports_cl_khr_create_command_queue;
         bool        Supports_cl_khr_subgroups;
@@ -1179,12 +1377,13 @@ private:
     CDeviceInfoMap  m_DeviceInfoMap;
 
     // These structures define a mapping between a key and a device
-    // timing record.  The key consists of a device ID and a string
-    // identifier.  The string identifier usually consists of the
+    // timing record.  The key consists of a device ID and an interned
+    // string identifier.  The string identifier usually consists of the
     // kernel name and possibly some extra information such as the
     // local and global work size, The kernel name could be the "real"
     // kernel name, or a kernel name ID, or is the OpenCL API name for
-    // non-kernel device timing stats.
+    // non-kernel device timing stats.  The identifier is only resolved
+    // to a string when the report is written.
 
     struct SDeviceTimingStats
     {
@@ -1192,30 +1391,138 @@ private:
         cl_ulong    MinNS = CL_ULONG_MAX;
         cl_ulong    MaxNS = 0;
         cl_ulong    TotalNS = 0;
+
+        // The running mean and sum of squared differences from the mean,
+        // used to compute the variance for sampled device timing.
+        double      MeanNS = 0.0;
+        double      M2NS = 0.0;
+
+        CTimingHistogram    Histogram;
     };
 
-    typedef std::unordered_map< std::string, SDeviceTimingStats >   CDeviceTimingStatsMap;
+    typedef std::unordered_map< CStringInterner::Id, SDeviceTimingStats >   CDeviceTimingStatsMap;
     typedef std::map< cl_device_id, CDeviceTimingStatsMap > CDeviceDeviceTimingStatsMap;
     CDeviceDeviceTimingStatsMap m_DeviceTimingStatsMap;
 
-    // These structures define a mapping between a device ID and histogram
-    // bins for kernel execution on that device.
+    // When device timing is sampled, this tracks the number of enqueues and
+    // the number of sampled enqueues for each device and device timing key,
+    // so the device timing stats for each device can be extrapolated.
+
+    struct SDeviceTimingSampleState
+    {
+        uint64_t            Enqueues = 0;
+        uint64_t            Sampled = 0;
+        clock::time_point   PeriodStart;
+        uint32_t            PeriodSamples = 0;
+    };
+
+    typedef std::unordered_map< CStringInterner::Id, SDeviceTimingSampleState > CDeviceTimingSampleMap;
+    typedef std::map< cl_device_id, CDeviceTimingSampleMap > CDeviceDeviceTimingSampleMap;
+    CDeviceDeviceTimingSampleMap    m_DeviceTimingSampleMap;
+
+    void    writeDeviceTimingSampleReport(
+                std::ostream& os,
+                cl_device_id device,
+                const CDeviceTimingStatsMap& dtsm,
+                const std::vector<CStringInterner::Id>& keys,
+                size_t longestName );
+
+    void    writeDeviceTimingHistogramReport(
+                std::ostream& os,
+                const CDeviceTimingStatsMap& dtsm,
+                const std::vector<CStringInterner::Id>& keys );
 
-    struct SDeviceTimingHistogram
+    // These structures track the time commands spend in the queued ->
+    // submit and submit -> start stages, for each device timing key and for
+    // each command queue.
+
+    struct SStageTimingStats
     {
-        constexpr static uint32_t cNumBins = 30;
-        uint32_t    Bins[cNumBins] = { 0 };
+        uint64_t    NumberOfCalls = 0;
+        uint64_t    MinNS = ULLONG_MAX;
+        uint64_t    MaxNS = 0;
+        uint64_t    TotalNS = 0;
+
+        CTimingHistogram    Histogram;
+
+        void    add( uint64_t ns )
+        {
+            NumberOfCalls++;
+            TotalNS += ns;
+            MinNS = std::min<uint64_t>( MinNS, ns );
+            MaxNS = std::max<uint64_t>( MaxNS, ns );
+            Histogram.add( ns );
+        }
+    };
+
+    struct SDeviceStageTimingStats
+    {
+        SStageTimingStats   QueuedToSubmit;
+        SStageTimingStats   SubmitToStart;
     };
 
-    typedef std::map< cl_device_id, SDeviceTimingHistogram > CDeviceTimingHistogramMap;
-    CDeviceTimingHistogramMap   m_DeviceTimingHistogramMap;
+    typedef std::unordered_map< CStringInterner::Id, SDeviceStageTimingStats >  CDeviceStageTimingStatsMap;
+    typedef std::map< cl_device_id, CDeviceStageTimingStatsMap >    CDeviceDeviceStageTimingStatsMap;
+    CDeviceDeviceStageTimingStatsMap    m_DeviceStageTimingStatsMap;
+
+    typedef std::map< unsigned int, SDeviceStageTimingStats >   CQueueStageTimingStatsMap;
+    typedef std::map< cl_device_id, CQueueStageTimingStatsMap > CDeviceQueueStageTimingStatsMap;
+    CDeviceQueueStageTimingStatsMap     m_QueueStageTimingStatsMap;
+
+    void    writeDeviceStageTimingReport(
+                std::ostream& os,
+                cl_device_id device,
+                const std::vector<CStringInterner::Id>& keys,
+                size_t longestName );
+
+    // These define the busy intervals and idle gaps for each device and for
+    // each command queue, in device time.  The tag for each interval is the
+    // device timing key of the command.
+
+    typedef std::map< cl_device_id, COccupancyTracker > CDeviceOccupancyMap;
+    CDeviceOccupancyMap m_DeviceOccupancyMap;
+
+    typedef std::map< unsigned int, COccupancyTracker > CQueueOccupancyMap;
+    typedef std::map< cl_device_id, CQueueOccupancyMap >    CDeviceQueueOccupancyMap;
+    CDeviceQueueOccupancyMap    m_QueueOccupancyMap;
+
+    void    writeDeviceOccupancyReport(
+                std::ostream& os,
+                cl_device_id device );
+
+    // This defines a mapping between a device ID and the clock model used
+    // to convert device timestamps to host time for that device.  The clock
+    // models are updated and used with the timing mutex held.
+
+    typedef std::map< cl_device_id, CClockModel > CClockModelMap;
+    CClockModelMap  m_ClockModelMap;
+
+    uint64_t    getNormalizedQueuedTimeNS(
+                    bool useProfilingDelta,
+                    int64_t profilingDeltaNS,
+                    clock::time_point queuedTime,
+                    cl_ulong commandQueued ) const;
+
+    // This is the dependency graph of commands and host waits used for
+    // critical path analysis.  It is updated with the timing mutex held.
+    // Times in the graph are host times relative to the start time.
+
+    CCriticalPath   m_CriticalPath;
+
+    void    writeCriticalPathReport(
+                std::ostream& os );
 
     // This defines a mapping between the kernel handle and information
-    // about the kernel.
+    // about the kernel.  The short kernel name and the short kernel name
+    // with hash depend only on the kernel name, program, and controls, so
+    // they are computed once when the kernel info is added rather than for
+    // each enqueue.
 
     struct SKernelInfo
     {
         std::string     KernelName;
+        std::string     ShortKernelName;
+        std::string     ShortKernelNameWithHash;
 
         uint64_t        ProgramHash;
         uint64_t        OptionsHash;
@@ -1224,9 +1531,12 @@ private:
         unsigned int    CompileCount;
     };
 
-    typedef std::map< cl_kernel, SKernelInfo >  CKernelInfoMap;
+    typedef CPointerMap< cl_kernel, SKernelInfo >  CKernelInfoMap;
     CKernelInfoMap  m_KernelInfoMap;
 
+    void    initKernelInfoNames(
+                SKernelInfo& kernelInfo );
+
     // This defines a mapping between the "real" kernel name and a kernel
     // name ID.  Only kernels with names larger than a control variable
     // will be added to this map.
@@ -1236,23 +1546,91 @@ private:
     typedef std::unordered_map< std::string, std::string >  CLongKernelNameMap;
     CLongKernelNameMap  m_LongKernelNameMap;
 
-    // This is a list of pending events that haven't been added to the
-    // device timing stats map yet.
+    // These are the pending events that haven't been added to the device
+    // timing stats map yet, stored in a ring for each command queue.
 
     struct SEventListNode
     {
         cl_device_id        Device;
         unsigned int        QueueNumber;
-        std::string         Name;
+        CStringInterner::Id NameId;
         uint64_t            EnqueueCounter;
         clock::time_point   QueuedTime;
         bool                UseProfilingDelta;
-        int64_t             ProfilingDeltaNS;
         cl_event            Event;
     };
 
-    typedef std::list< SEventListNode > CEventList;
-    CEventList  m_EventList;
+    // The events for a queue are removed from the map when the queue has
+    // been released and its events have been processed, so checking timing
+    // events does not visit queues that no longer exist.
+    struct SQueueTimingEvents
+    {
+        bool    InOrder = true;
+        bool    Released = false;
+        CRingBuffer< SEventListNode >   Events;
+    };
+
+    typedef std::unordered_map< cl_command_queue, SQueueTimingEvents > CQueueTimingEventsMap;
+    CQueueTimingEventsMap   m_QueueTimingEventsMap;
+
+    // When DevicePerformanceTimingEventCallbacks is enabled, each pending
+    // event has a completion callback instead of being added to the event
+    // list.  The callback pushes the event onto a lock-free list of
+    // completed events, so checking timing events only needs to process
+    // the events that have completed, without querying any pending events.
+
+    struct STimingEventCallbackInfo
+    {
+        CLIntercept*                pIntercept;
+        STimingEventCallbackInfo*   pNext;
+        cl_int                      Status;
+        SEventListNode              Node;
+    };
+
+    std::atomic<STimingEventCallbackInfo*>  m_CompletedTimingEvents;
+
+    // The callback info for every event with a registered completion
+    // callback that has not been processed yet, so it can be freed when the
+    // Intercept Layer is destroyed.  This is guarded by the timing mutex.
+    std::unordered_set<STimingEventCallbackInfo*>   m_TimingEventCallbacks;
+
+    // Completion callbacks may still be called after the Intercept Layer is
+    // destroyed, so they are static and check whether callbacks are still
+    // enabled before touching the callback info.  The destructor disables
+    // callbacks and waits for any active callbacks to return.
+    static std::atomic<bool>        s_TimingEventCallbacksEnabled;
+    static std::atomic<uint32_t>    s_ActiveTimingEventCallbacks;
+
+    // The number of pending events, including events with completion
+    // callbacks, is tracked so it can be limited by
+    // DevicePerformanceTimingMaxPendingEvents.  The counters are updated
+    // without the timing mutex, so the limit may be exceeded by one event for
+    // each thread adding a timing event concurrently.
+
+    enum EPendingEventPolicy
+    {
+        cPendingEventPolicyHarvest = 0,
+        cPendingEventPolicyDrop = 1,
+        cPendingEventPolicyDownsample = 2,
+    };
+
+    std::atomic<uint64_t>   m_NumPendingTimingEvents;
+    std::atomic<uint64_t>   m_PeakPendingTimingEvents;
+    std::atomic<uint64_t>   m_PendingTimingEventHarvests;
+    std::atomic<uint64_t>   m_DroppedTimingEvents;
+    std::atomic<uint64_t>   m_DownsampledTimingEvents;
+
+    bool    reservePendingTimingEvent();
+    void    downsampleTimingEvents();
+
+    static void CL_CALLBACK timingEventCallbackCaller(
+                                cl_event,
+                                cl_int,
+                                void* );
+    bool    checkTimingEvent(
+                const SEventListNode& node );
+    void    processTimingEvent(
+                const SEventListNode& node );
 
 #if defined(USE_MDAPI)
     MetricsDiscovery::MDHelper* m_pMDHelper;
@@ -1270,25 +1648,54 @@ private:
 
     unsigned int    m_QueueNumber;
 
-    typedef std::map< cl_command_queue, unsigned int >  CQueueNumberMap;
-    CQueueNumberMap m_QueueNumberMap;
+    // Queue information is cached when the queue is created, or when it is
+    // first needed, so it does not need to be queried for each command.
+    // The cache has its own lock so that threads enqueuing to different
+    // queues do not serialize on the intercept mutex.  getQueueInfo()
+    // returns a copy, since the cache may be modified once the lock is
+    // released, and it may acquire the intercept mutex to cache the device
+    // info, so it must be called without holding any domain lock.
+    struct SQueueInfo
+    {
+        unsigned int    Number = 0;
+        cl_device_id    Device = NULL;
+        cl_platform_id  Platform = NULL;
+        cl_context      Context = NULL;
+        SDeviceInfo*    pDeviceInfo = NULL;
+        bool            InOrder = true;
+        bool            Cached = false;
+    };
+
+    typedef CPointerMap< cl_command_queue, SQueueInfo > CQueueInfoMap;
+    CQueueInfoMap   m_QueueInfoMap;
+
+    SQueueInfo  getQueueInfo(
+                    cl_command_queue queue );
+    void    sampleDeviceClock(
+                cl_device_id device,
+                SDeviceInfo& deviceInfo,
+                clock::time_point queuedTime );
+    bool    getProfilingDelta(
+                cl_device_id device,
+                cl_ulong commandQueued,
+                int64_t& profilingDeltaNS ) const;
 
     typedef std::list< cl_command_queue >   CQueueList;
     typedef std::map< cl_context, CQueueList >  CContextQueuesMap;
     CContextQueuesMap   m_ContextQueuesMap;
 
-    typedef std::map< cl_event, uint64_t >  CEventIdMap;
+    typedef CPointerMap< cl_event, uint64_t >  CEventIdMap;
     CEventIdMap m_EventIdMap;
 
     unsigned int    m_MemAllocNumber;
 
-    typedef std::map< const void*, unsigned int >   CMemAllocNumberMap;
+    typedef CPointerMap< const void*, unsigned int >   CMemAllocNumberMap;
     CMemAllocNumberMap  m_MemAllocNumberMap;
 
     typedef std::map< cl_sampler, std::string > CSamplerDataMap;
     CSamplerDataMap m_SamplerDataMap;
 
-    typedef std::map< cl_mem, size_t >  CBufferInfoMap;
+    typedef CPointerMap< cl_mem, size_t >  CBufferInfoMap;
     CBufferInfoMap      m_BufferInfoMap;
 
     typedef std::map< const void*, size_t > CSVMAllocInfoMap;
@@ -1307,7 +1714,7 @@ private:
         cl_mem_object_type ImageType;
     };
 
-    typedef std::map< cl_mem, SImageInfo >  CImageInfoMap;
+    typedef CPointerMap< cl_mem, SImageInfo >  CImageInfoMap;
     CImageInfoMap   m_ImageInfoMap;
 
     struct SMemInfo
@@ -1318,19 +1725,19 @@ private:
     };
 
     typedef std::map< cl_uint, SMemInfo >   CArgMemMap;
-    typedef std::map< cl_kernel, CArgMemMap >   CKernelArgMemMap;
+    typedef CPointerMap< cl_kernel, CArgMemMap >   CKernelArgMemMap;
     CKernelArgMemMap    m_KernelArgMemMap;
 
     typedef std::map< cl_uint, std::string >    CArgSamplerMap;
-    typedef std::map< cl_kernel, CArgSamplerMap >   CKernelArgSamplerMap;
+    typedef CPointerMap< cl_kernel, CArgSamplerMap >   CKernelArgSamplerMap;
     CKernelArgSamplerMap    m_KernelArgSamplerMap;
 
     typedef std::map< cl_uint, std::vector<uint8_t> >   CArgDataMap;
-    typedef std::map< cl_kernel, CArgDataMap >  CKernelArgDataMap;
+    typedef CPointerMap< cl_kernel, CArgDataMap >  CKernelArgDataMap;
     CKernelArgDataMap   m_KernelArgDataMap;
 
     typedef std::map< cl_uint, size_t > CArgLocalSizeMap;
-    typedef std::map< cl_kernel, CArgLocalSizeMap > CKernelArgLocalSizeMap;
+    typedef CPointerMap< cl_kernel, CArgLocalSizeMap > CKernelArgLocalSizeMap;
     CKernelArgLocalSizeMap  m_KernelArgLocalSizeMap;
 
     typedef std::map<cl_program, std::string> CSourceStringMap;
@@ -1446,6 +1853,10 @@ private:
         __itt_clock_domain* itt_clock_domain;
         clock::time_point   CPUReferenceTime;
         cl_ulong            CLReferenceTime;
+
+        // If set, timestamps in the clock domain are converted to the
+        // Intercept Layer's timer using the device clock model.
+        bool                UseProfilingDelta;
     };
 
     typedef std::map< cl_command_queue, SITTQueueInfo > CITTQueueInfoMap;
@@ -1490,7 +1901,7 @@ private:
         std::vector<void*>  USMPtrs;
     };
 
-    typedef std::map< cl_kernel, SUSMKernelInfo >   CUSMKernelInfoMap;
+    typedef CPointerMap< cl_kernel, SUSMKernelInfo >   CUSMKernelInfoMap;
     CUSMKernelInfoMap   m_USMKernelInfoMap;
 };
 
@@ -2004,13 +2415,10 @@ inline uint64_t CLIntercept::incrementEnqueueCounter()
         uint64_t enqueueCounter = m_EnqueueCounter.load();
         if( enqueueCounter >= m_Config.ExitOnEnqueueCount )
         {
-            // Note: we need to release the mutex before calling exit:
-            {
-                std::lock_guard<std::mutex> lock(m_Mutex);
-                logf("Exit enqueue counter reached (%" PRIu64 " >= %" PRIu64 "): exiting the application.\n",
-                    enqueueCounter,
-                    m_Config.ExitOnEnqueueCount);
-            }
+            // Note: logf() releases the log mutex before we call exit:
+            logf("Exit enqueue counter reached (%" PRIu64 " >= %" PRIu64 "): exiting the application.\n",
+                enqueueCounter,
+                m_Config.ExitOnEnqueueCount);
             exit(0);
         }
     }
@@ -2021,12 +2429,43 @@ inline uint64_t CLIntercept::incrementEnqueueCounter()
         uint64_t enqueueCounter = m_EnqueueCounter.load();
         if( enqueueCounter != 0 && enqueueCounter % reportInterval == 0 )
         {
-            report();
+            requestReport();
+        }
+    }
+
+    if( m_Config.SelfOverheadProfiling &&
+        ( m_Config.ChromeCallLogging || m_Config.ChromePerformanceTiming ) )
+    {
+        uint64_t enqueueCounter = m_EnqueueCounter.load();
+        if( enqueueCounter != 0 && enqueueCounter % cSelfOverheadCounterInterval == 0 )
+        {
+            chromeSelfOverheadCounters();
         }
     }
     return m_EnqueueCounter.fetch_add(1, std::memory_order_relaxed);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+inline bool CLIntercept::checkFastPath(
+    EFastPathEntryPoint entryPoint ) const
+{
+    return m_FastPathFeatures[ entryPoint ] == 0;
+}
+
+#define FAST_PATH_PASS_THROUGH( _func, ... )                                \
+    if( pIntercept->checkFastPath( CLIntercept::cFastPath_##_func ) )       \
+    {                                                                       \
+        return pIntercept->dispatch()._func( __VA_ARGS__ );                 \
+    }
+
+#define FAST_PATH_PASS_THROUGH_ENQUEUE( _func, ... )                        \
+    if( pIntercept->checkFastPath( CLIntercept::cFastPath_##_func ) )       \
+    {                                                                       \
+        pIntercept->incrementEnqueueCounter();                              \
+        return pIntercept->dispatch()._func( __VA_ARGS__ );                 \
+    }
+
 #define GET_ENQUEUE_COUNTER()                                               \
     uint64_t enqueueCounter = pIntercept->getEnqueueCounter();
 
@@ -2040,9 +2479,22 @@ inline CObjectTracker& CLIntercept::objectTracker()
     return m_ObjectTracker;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+inline CSelfOverhead* CLIntercept::selfOverhead()
+{
+    return m_Config.SelfOverheadProfiling ? &m_SelfOverhead : NULL;
+}
+
+#define SELF_OVERHEAD_SCOPE( _stage )                                       \
+    CSelfOverheadScope  selfOverheadScope(                                  \
+        pIntercept->selfOverhead(),                                         \
+        CSelfOverhead::cStage_##_stage );
+
 #define ADD_OBJECT_ALLOCATION( _obj )                                       \
     if( pIntercept->config().LeakChecking )                                 \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( ObjectTracking );                              \
         pIntercept->objectTracker().AddAllocation(_obj);                    \
     }
 
@@ -2050,18 +2502,21 @@ inline CObjectTracker& CLIntercept::objectTracker()
     if( pIntercept->config().LeakChecking &&                                \
         ( _errorCode == CL_SUCCESS ) && _pEvent )                           \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( ObjectTracking );                              \
         pIntercept->objectTracker().AddAllocation(_pEvent[0]);              \
     }
 
 #define ADD_OBJECT_RETAIN( _obj )                                           \
     if( pIntercept->config().LeakChecking )                                 \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( ObjectTracking );                              \
         pIntercept->objectTracker().AddRetain(_obj);                        \
     }
 
 #define ADD_OBJECT_RELEASE( _obj )                                          \
     if( pIntercept->config().LeakChecking )                                 \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( ObjectTracking );                              \
         pIntercept->objectTracker().AddRelease(_obj);                       \
     }
 
@@ -2122,6 +2577,7 @@ inline CObjectTracker& CLIntercept::objectTracker()
 #define CALL_LOGGING_ENTER(...)                                             \
     if( pIntercept->config().CallLogging )                                  \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( CallLoggingEnter );                            \
         pIntercept->callLoggingEnter(                                       \
             __FUNCTION__, enqueueCounter, NULL, ##__VA_ARGS__ );            \
     }                                                                       \
@@ -2130,6 +2586,7 @@ inline CObjectTracker& CLIntercept::objectTracker()
 #define CALL_LOGGING_ENTER_KERNEL(kernel, ...)                              \
     if( pIntercept->config().CallLogging )                                  \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( CallLoggingEnter );                            \
         pIntercept->callLoggingEnter(                                       \
             __FUNCTION__, enqueueCounter, kernel, ##__VA_ARGS__ );          \
     }                                                                       \
@@ -2144,6 +2601,7 @@ inline CObjectTracker& CLIntercept::objectTracker()
 #define CALL_LOGGING_EXIT(errorCode, ...)                                   \
     if( pIntercept->config().CallLogging )                                  \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( CallLoggingExit );                             \
         pIntercept->callLoggingExit(                                        \
             __FUNCTION__,                                                   \
             errorCode,                                                      \
@@ -2166,6 +2624,7 @@ inline CObjectTracker& CLIntercept::objectTracker()
 #define CALL_LOGGING_EXIT_EVENT(errorCode, event, ...)                      \
     if( pIntercept->config().CallLogging )                                  \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( CallLoggingExit );                             \
         pIntercept->callLoggingExit(                                        \
             __FUNCTION__,                                                   \
             errorCode,                                                      \
@@ -2188,6 +2647,7 @@ inline CObjectTracker& CLIntercept::objectTracker()
 #define CALL_LOGGING_EXIT_EVENT_WITH_TAG(errorCode, _event, ...)            \
     if( pIntercept->config().CallLogging )                                  \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( CallLoggingExit );                             \
         pIntercept->callLoggingExit(                                        \
             __FUNCTION__,                                                   \
             errorCode,                                                      \
@@ -2210,6 +2670,7 @@ inline CObjectTracker& CLIntercept::objectTracker()
 #define CALL_LOGGING_EXIT_SYNC_POINT(errorCode, sync_point, ...)            \
     if( pIntercept->config().CallLogging )                                  \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( CallLoggingExit );                             \
         pIntercept->callLoggingExit(                                        \
             __FUNCTION__,                                                   \
             errorCode,                                                      \
@@ -2248,6 +2709,7 @@ inline CObjectTracker& CLIntercept::objectTracker()
           pIntercept->config().NoErrors ) &&                                \
         ( errorCode != CL_SUCCESS ) )                                       \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( ErrorChecking );                               \
         if( pIntercept->config().ErrorLogging )                             \
         {                                                                   \
             pIntercept->logError( __FUNCTION__, errorCode );                \
@@ -2323,6 +2785,7 @@ inline CObjectTracker& CLIntercept::objectTracker()
     if( pIntercept->config().FinishAfterEnqueue )                           \
     {                                                                       \
         {                                                                   \
+            SELF_OVERHEAD_SCOPE( FinishOrFlushAfterEnqueue );               \
             TOOL_OVERHEAD_TIMING_START();                                   \
             pIntercept->logFlushOrFinishAfterEnqueueStart(                  \
                 "clFinish",                                                 \
@@ -2342,6 +2805,7 @@ inline CObjectTracker& CLIntercept::objectTracker()
     }                                                                       \
     else if( pIntercept->config().FlushAfterEnqueue )                       \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( FinishOrFlushAfterEnqueue );                   \
         /*pIntercept->logFlushOrFinishAfterEnqueueStart(*/                  \
         /*    "clFlush",                                */                  \
         /*    __FUNCTION__ );                           */                  \
@@ -2428,7 +2892,10 @@ inline bool CLIntercept::checkDumpImageEnqueueLimits(
 
 #define ADD_QUEUE( _context, _queue )                                       \
     if( _queue &&                                                           \
-        ( pIntercept->config().ChromePerformanceTiming ||                   \
+        ( pIntercept->config().DevicePerformanceTiming ||                   \
+          pIntercept->config().ITTPerformanceTiming ||                      \
+          pIntercept->config().ChromePerformanceTiming ||                   \
+          pIntercept->config().DevicePerfCounterEventBasedSampling ||       \
           pIntercept->config().Emulate_cl_intel_unified_shared_memory ) )   \
     {                                                                       \
         pIntercept->addQueue(                                               \
@@ -2442,7 +2909,10 @@ inline bool CLIntercept::checkDumpImageEnqueueLimits(
 
 #define REMOVE_QUEUE( _queue )                                              \
     if( _queue &&                                                           \
-        ( pIntercept->config().ChromePerformanceTiming ||                   \
+        ( pIntercept->config().DevicePerformanceTiming ||                   \
+          pIntercept->config().ITTPerformanceTiming ||                      \
+          pIntercept->config().ChromePerformanceTiming ||                   \
+          pIntercept->config().DevicePerfCounterEventBasedSampling ||       \
           pIntercept->config().Emulate_cl_intel_unified_shared_memory ) )   \
     {                                                                       \
         pIntercept->checkRemoveQueue( _queue );                             \
@@ -2451,16 +2921,20 @@ inline bool CLIntercept::checkDumpImageEnqueueLimits(
 #define ADD_EVENT( _event )                                                 \
     if( ( _event ) &&                                                       \
         ( pIntercept->config().ChromeCallLogging ||                         \
-          pIntercept->config().ChromePerformanceTiming ) )                  \
+          pIntercept->config().ChromePerformanceTiming ||                   \
+          pIntercept->config().DevicePerformanceTimingCriticalPath ) )      \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( EventTracking );                               \
         pIntercept->addEvent( _event, enqueueCounter );                     \
     }
 
 #define REMOVE_EVENT( _event )                                              \
     if( ( _event ) &&                                                       \
         ( pIntercept->config().ChromeCallLogging ||                         \
-          pIntercept->config().ChromePerformanceTiming ) )                  \
+          pIntercept->config().ChromePerformanceTiming ||                   \
+          pIntercept->config().DevicePerformanceTimingCriticalPath ) )      \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( EventTracking );                               \
         pIntercept->checkRemoveEvent( _event );                             \
     }
 
@@ -2580,6 +3054,7 @@ inline bool CLIntercept::checkDumpImageEnqueueLimits(
         enqueueCounter >= pIntercept->config().DumpArgumentsOnSetMinEnqueue && \
         enqueueCounter <= pIntercept->config().DumpArgumentsOnSetMaxEnqueue ) \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( DumpArgumentsOnSet );                          \
         pIntercept->dumpArgument(                                           \
             enqueueCounter, kernel, arg_index, arg_size, arg_value );       \
     }                                                                       \
@@ -2591,6 +3066,7 @@ inline bool CLIntercept::checkDumpImageEnqueueLimits(
         pIntercept->config().InjectImages ||                                \
         pIntercept->config().CaptureReplay )                                \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( SetKernelArg );                                \
         pIntercept->setKernelArg( kernel, arg_index, arg_value, arg_size ); \
     }
 
@@ -2601,6 +3077,7 @@ inline bool CLIntercept::checkDumpImageEnqueueLimits(
         pIntercept->config().InjectImages ||                                \
         pIntercept->config().CaptureReplay )                                \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( SetKernelArg );                                \
         pIntercept->setKernelArgSVMPointer( kernel, arg_index, arg_value ); \
     }
 
@@ -2611,6 +3088,7 @@ inline bool CLIntercept::checkDumpImageEnqueueLimits(
         pIntercept->config().InjectImages ||                                \
         pIntercept->config().CaptureReplay )                                \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( SetKernelArg );                                \
         pIntercept->setKernelArgUSMPointer( kernel, arg_index, arg_value ); \
     }
 
@@ -2681,6 +3159,7 @@ inline bool CLIntercept::checkDumpImageEnqueueLimits(
         pIntercept->checkDumpBuffersForKernel( kernel );                    \
     if( captureReplay || dumpBuffersBeforeEnqueue )                         \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( DumpBuffersBeforeEnqueue );                    \
         pIntercept->dumpBuffersForKernel(                                   \
             "Pre", captureReplay, dumpBuffersBeforeEnqueue,                 \
             enqueueCounter, kernel, command_queue );                        \
@@ -2693,6 +3172,7 @@ inline bool CLIntercept::checkDumpImageEnqueueLimits(
         pIntercept->checkDumpBuffersForKernel( kernel );                    \
     if( captureReplay || dumpBuffersAfterEnqueue )                          \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( DumpBuffersAfterEnqueue );                     \
         pIntercept->dumpBuffersForKernel(                                   \
             "Post", captureReplay, dumpBuffersAfterEnqueue,                 \
             enqueueCounter, kernel, command_queue );                        \
@@ -2705,6 +3185,7 @@ inline bool CLIntercept::checkDumpImageEnqueueLimits(
         pIntercept->checkDumpImagesForKernel( kernel );                     \
     if( captureReplay || dumpImagesBeforeEnqueue )                          \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( DumpImagesBeforeEnqueue );                     \
         pIntercept->dumpImagesForKernel(                                    \
             "Pre", captureReplay, dumpImagesBeforeEnqueue,                  \
             enqueueCounter, kernel, command_queue );                        \
@@ -2717,6 +3198,7 @@ inline bool CLIntercept::checkDumpImageEnqueueLimits(
         pIntercept->checkDumpImagesForKernel( kernel );                     \
     if( captureReplay || dumpImagesAfterEnqueue )                           \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( DumpImagesAfterEnqueue );                      \
         pIntercept->dumpImagesForKernel(                                    \
             "Post", captureReplay, dumpImagesAfterEnqueue,                  \
             enqueueCounter, kernel, command_queue );                        \
@@ -3167,6 +3649,7 @@ inline bool CLIntercept::checkGetTimingTags(
     std::string hostTag, deviceTag;                                         \
     if( pIntercept->checkGetTimingTags( enqueueCounter ) )                  \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( GetTimingTags );                               \
         pIntercept->getTimingTagBlocking(                                   \
             __FUNCTION__,                                                   \
             _blocking,                                                      \
@@ -3179,6 +3662,7 @@ inline bool CLIntercept::checkGetTimingTags(
     std::string hostTag, deviceTag;                                         \
     if( pIntercept->checkGetTimingTags( enqueueCounter ) )                  \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( GetTimingTags );                               \
         pIntercept->getTimingTagsMap(                                       \
             __FUNCTION__,                                                   \
             _map_flags,                                                     \
@@ -3192,6 +3676,7 @@ inline bool CLIntercept::checkGetTimingTags(
     std::string hostTag, deviceTag;                                         \
     if( pIntercept->checkGetTimingTags( enqueueCounter ) )                  \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( GetTimingTags );                               \
         pIntercept->getTimingTagsUnmap(                                     \
             __FUNCTION__,                                                   \
             _ptr,                                                           \
@@ -3203,6 +3688,7 @@ inline bool CLIntercept::checkGetTimingTags(
     std::string hostTag, deviceTag;                                         \
     if( pIntercept->checkGetTimingTags( enqueueCounter ) )                  \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( GetTimingTags );                               \
         pIntercept->getTimingTagsMemfill(                                   \
             __FUNCTION__,                                                   \
             _queue,                                                         \
@@ -3216,6 +3702,7 @@ inline bool CLIntercept::checkGetTimingTags(
     std::string hostTag, deviceTag;                                         \
     if( pIntercept->checkGetTimingTags( enqueueCounter ) )                  \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( GetTimingTags );                               \
         pIntercept->getTimingTagsMemcpy(                                    \
             __FUNCTION__,                                                   \
             _queue,                                                         \
@@ -3231,6 +3718,7 @@ inline bool CLIntercept::checkGetTimingTags(
     std::string hostTag, deviceTag;                                         \
     if( pIntercept->checkGetTimingTags( enqueueCounter ) )                  \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( GetTimingTagsKernel );                         \
         pIntercept->getTimingTagsKernel(                                    \
             _queue,                                                         \
             _kernel,                                                        \
@@ -3396,7 +3884,24 @@ inline bool CLIntercept::checkDevicePerformanceTimingEnqueueLimits(
         pIntercept->dummyCommandQueue( _context, _device );                 \
     }
 
-#define DEVICE_PERFORMANCE_TIMING_START( pEvent )                           \
+///////////////////////////////////////////////////////////////////////////////
+//
+inline bool CLIntercept::checkDevicePerformanceTimingSample(
+    cl_command_queue queue,
+    const char* name )
+{
+    if( m_Config.DevicePerformanceTimingSampleInterval <= 1 &&
+        m_Config.DevicePerformanceTimingSamplesPerSecond == 0 )
+    {
+        return true;
+    }
+    return sampleDevicePerformanceTiming( queue, name );
+}
+
+// Device performance timing is started with the API name, or with the device
+// timing tag when the enqueue has one, since this is the key used to sample
+// device performance timing.
+#define DEVICE_PERFORMANCE_TIMING_START_COMMON( queue, pEvent, _name )      \
     CLIntercept::clock::time_point   queuedTime;                            \
     cl_event    local_event = NULL;                                         \
     bool        isLocalEvent = false;                                       \
@@ -3406,7 +3911,8 @@ inline bool CLIntercept::checkDevicePerformanceTimingEnqueueLimits(
           pIntercept->config().ChromePerformanceTiming ||                   \
           pIntercept->config().DevicePerfCounterEventBasedSampling ) &&     \
         pIntercept->checkDevicePerformanceTimingEnqueueLimits( enqueueCounter ) &&\
-        pIntercept->checkConditionalTiming();                               \
+        pIntercept->checkConditionalTiming() &&                             \
+        pIntercept->checkDevicePerformanceTimingSample( queue, _name );     \
     if( doDevicePerformanceTiming )                                         \
     {                                                                       \
         queuedTime = CLIntercept::clock::now();                             \
@@ -3417,6 +3923,18 @@ inline bool CLIntercept::checkDevicePerformanceTimingEnqueueLimits(
         }                                                                   \
     }
 
+#define DEVICE_PERFORMANCE_TIMING_START( queue, pEvent )                    \
+    DEVICE_PERFORMANCE_TIMING_START_COMMON(                                 \
+        queue,                                                              \
+        pEvent,                                                             \
+        __FUNCTION__ )
+
+#define DEVICE_PERFORMANCE_TIMING_START_WITH_TAG( queue, pEvent )           \
+    DEVICE_PERFORMANCE_TIMING_START_COMMON(                                 \
+        queue,                                                              \
+        pEvent,                                                             \
+        deviceTag.empty() ? __FUNCTION__ : deviceTag.c_str() )
+
 #define DEVICE_PERFORMANCE_TIMING_END( queue, errorCode, pEvent )           \
     if( doDevicePerformanceTiming &&                                        \
         ( errorCode == CL_SUCCESS ) && ( pEvent != NULL ) )                 \
@@ -3432,12 +3950,16 @@ inline bool CLIntercept::checkDevicePerformanceTimingEnqueueLimits(
                 queuedTime,                                                 \
                 "",                                                         \
                 queue,                                                      \
-                pEvent[0] );                                                \
+                pEvent[0],                                                  \
+                !isLocalEvent );                                            \
             /*TOOL_OVERHEAD_TIMING_END( "(timing event overhead)" );*/      \
         }                                                                   \
-        if( isLocalEvent )                                                  \
+        else if( isLocalEvent )                                             \
         {                                                                   \
             pIntercept->dispatch().clReleaseEvent( pEvent[0] );             \
+        }                                                                   \
+        if( isLocalEvent )                                                  \
+        {                                                                   \
             pEvent = NULL;                                                  \
         }                                                                   \
     }
@@ -3457,12 +3979,16 @@ inline bool CLIntercept::checkDevicePerformanceTimingEnqueueLimits(
                 queuedTime,                                                 \
                 deviceTag,                                                  \
                 queue,                                                      \
-                pEvent[0] );                                                \
+                pEvent[0],                                                  \
+                !isLocalEvent );                                            \
             /*TOOL_OVERHEAD_TIMING_END( "(timing event overhead)" );*/      \
         }                                                                   \
-        if( isLocalEvent )                                                  \
+        else if( isLocalEvent )                                             \
         {                                                                   \
             pIntercept->dispatch().clReleaseEvent( pEvent[0] );             \
+        }                                                                   \
+        if( isLocalEvent )                                                  \
+        {                                                                   \
             pEvent = NULL;                                                  \
         }                                                                   \
     }
@@ -3478,11 +4004,11 @@ inline bool CLIntercept::checkDevicePerformanceTimingEnqueueLimits(
             queuedTime,                                                     \
             deviceTag,                                                      \
             queue,                                                          \
-            pEvent[0] );                                                    \
+            pEvent[0],                                                      \
+            !isLocalEvent );                                                \
         /*TOOL_OVERHEAD_TIMING_END( "(timing event overhead)" );*/          \
         if( isLocalEvent )                                                  \
         {                                                                   \
-            pIntercept->dispatch().clReleaseEvent( pEvent[0] );             \
             pEvent = NULL;                                                  \
         }                                                                   \
     }
@@ -3516,7 +4042,11 @@ inline bool CLIntercept::checkDevicePerformanceTimingEnqueueLimits(
 //
 inline void CLIntercept::flushChromeTraceBuffering()
 {
-    m_ChromeTrace.flush();
+    CSelfOverheadScope  selfOverheadScope(
+        selfOverhead(),
+        CSelfOverhead::cStage_ChromeTraceFlush );
+
+    m_ChromeTrace.requestFlush();
 }
 
 #define FLUSH_CHROME_TRACE_BUFFERING()                                      \
@@ -3611,6 +4141,7 @@ inline void CLIntercept::flushChromeTraceBuffering()
 #define CHECK_EVENT_LIST( _numEvents, _eventList, _event )                  \
     if( pIntercept->config().EventChecking )                                \
     {                                                                       \
+        SELF_OVERHEAD_SCOPE( EventChecking );                               \
         pIntercept->checkEventList(                                         \
             __FUNCTION__,                                                   \
             _numEvents,                                                     \
@@ -3618,6 +4149,49 @@ inline void CLIntercept::flushChromeTraceBuffering()
             _event );                                                       \
     }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// The dependencies are added after the device performance timing end, which
+// adds the command to the critical path graph.
+#define CRITICAL_PATH_ADD_DEPENDENCIES( _numEvents, _eventList )            \
+    if( pIntercept->config().DevicePerformanceTimingCriticalPath &&         \
+        ( _numEvents ) != 0 )                                               \
+    {                                                                       \
+        SELF_OVERHEAD_SCOPE( EventTracking );                               \
+        pIntercept->addCriticalPathDependencies(                            \
+            enqueueCounter,                                                 \
+            _numEvents,                                                     \
+            _eventList );                                                   \
+    }
+
+#define CRITICAL_PATH_HOST_WAIT_START()                                     \
+    CLIntercept::clock::time_point  criticalPathWaitStart;                  \
+    if( pIntercept->config().DevicePerformanceTimingCriticalPath )          \
+    {                                                                       \
+        criticalPathWaitStart = CLIntercept::clock::now();                  \
+    }
+
+#define CRITICAL_PATH_WAIT_FOR_EVENTS( _numEvents, _eventList )             \
+    if( pIntercept->config().DevicePerformanceTimingCriticalPath )          \
+    {                                                                       \
+        SELF_OVERHEAD_SCOPE( EventTracking );                               \
+        pIntercept->addCriticalPathWaitForEvents(                           \
+            __FUNCTION__,                                                   \
+            criticalPathWaitStart,                                          \
+            _numEvents,                                                     \
+            _eventList );                                                   \
+    }
+
+#define CRITICAL_PATH_FINISH( _queue )                                      \
+    if( pIntercept->config().DevicePerformanceTimingCriticalPath )          \
+    {                                                                       \
+        SELF_OVERHEAD_SCOPE( EventTracking );                               \
+        pIntercept->addCriticalPathFinish(                                  \
+            __FUNCTION__,                                                   \
+            criticalPathWaitStart,                                          \
+            _queue );                                                       \
+    }
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 #define CHECK_KERNEL_ARG_USM_POINTER( _kernel, _arg )                       \
@@ -3644,80 +4218,46 @@ inline void CLIntercept::flushChromeTraceBuffering()
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-inline std::string CLIntercept::getShortKernelName(
-    const cl_kernel kernel )
+// This function assumes that the kernel lock is held.  The returned
+// reference is only valid while the kernel lock is held.
+inline const std::string& CLIntercept::getShortKernelName(
+    const cl_kernel kernel ) const
 {
-    const std::string& realKernelName = m_KernelInfoMap[ kernel ].KernelName;
+    static const std::string    cEmptyName;
 
-    CLongKernelNameMap::const_iterator i = m_LongKernelNameMap.find( realKernelName );
-
-    const std::string& shortKernelName =
-        ( i != m_LongKernelNameMap.end() ) ?
-        i->second :
-        realKernelName;
-
-    CLI_ASSERT( shortKernelName.length() <= m_Config.LongKernelNameCutoff );
-
-    return shortKernelName;
+    CKernelInfoMap::const_iterator  iter = m_KernelInfoMap.find( kernel );
+    return ( iter != m_KernelInfoMap.end() ) ?
+        iter->second.ShortKernelName :
+        cEmptyName;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-inline std::string CLIntercept::getShortKernelNameWithHash(
-    const cl_kernel kernel )
+// This function assumes that the kernel lock is held.  The returned
+// reference is only valid while the kernel lock is held.
+inline const std::string& CLIntercept::getShortKernelNameWithHash(
+    const cl_kernel kernel ) const
 {
-    std::string name = getShortKernelName( kernel );
-
-    if( config().KernelNameHashTracking )
-    {
-        const SKernelInfo& kernelInfo = m_KernelInfoMap[ kernel ];
-
-        char    hashString[256] = "";
-        if( config().OmitProgramNumber )
-        {
-            CLI_SPRINTF( hashString, 256, "$%08X_%04u_%08X",
-                (unsigned int)kernelInfo.ProgramHash,
-                kernelInfo.CompileCount,
-                (unsigned int)kernelInfo.OptionsHash );
-        }
-        else
-        {
-            CLI_SPRINTF( hashString, 256, "$%04u_%08X_%04u_%08X",
-                kernelInfo.ProgramNumber,
-                (unsigned int)kernelInfo.ProgramHash,
-                kernelInfo.CompileCount,
-                (unsigned int)kernelInfo.OptionsHash );
-        }
-
-        name += hashString;
-    }
+    static const std::string    cEmptyName;
 
-    return name;
+    CKernelInfoMap::const_iterator  iter = m_KernelInfoMap.find( kernel );
+    return ( iter != m_KernelInfoMap.end() ) ?
+        iter->second.ShortKernelNameWithHash :
+        cEmptyName;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-inline unsigned int CLIntercept::getThreadNumber( uint64_t threadId )
+inline const CLIntercept::SThreadInfo& CLIntercept::getThreadInfo()
 {
-    CThreadNumberMap::const_iterator iter = m_ThreadNumberMap.find( threadId );
-    unsigned int    threadNumber = 0;
+    static thread_local SThreadInfo tlsThreadInfo = { NULL, 0, 0 };
 
-    if( iter != m_ThreadNumberMap.end() )
+    if( tlsThreadInfo.pIntercept != this )
     {
-        threadNumber = iter->second;
-    }
-    else
-    {
-        threadNumber = (unsigned int)m_ThreadNumberMap.size();
-        m_ThreadNumberMap[ threadId ] = threadNumber;
-
-        if( m_Config.ChromeCallLogging )
-        {
-            m_ChromeTrace.addThreadMetadata( threadId, threadNumber );
-        }
+        registerThread( tlsThreadInfo );
     }
 
-    return threadNumber;
+    return tlsThreadInfo;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
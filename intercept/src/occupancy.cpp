@@ -0,0 +1,124 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#include <algorithm>
+
+#include "occupancy.h"
+
+COccupancyTracker::COccupancyTracker()
+{
+    m_Pending.reserve( cMaxPending );
+}
+
+void COccupancyTracker::add( uint64_t startNS, uint64_t endNS, uint32_t tag )
+{
+    m_State.Results.Commands++;
+
+    SInterval   interval = { startNS, std::max( startNS, endNS ), tag };
+    m_Pending.push_back( interval );
+
+    // When the reorder window is full, merge the older half, and keep the
+    // newer half so intervals that complete slightly out of order are still
+    // merged in order.
+    if( m_Pending.size() >= cMaxPending )
+    {
+        sortIntervals( m_Pending );
+
+        const size_t    numToMerge = m_Pending.size() / 2;
+        for( size_t i = 0; i < numToMerge; i++ )
+        {
+            merge( m_State, m_Pending[i] );
+        }
+        m_Pending.erase( m_Pending.begin(), m_Pending.begin() + numToMerge );
+    }
+}
+
+void COccupancyTracker::getResults( SResults& results ) const
+{
+    SState  state = m_State;
+
+    std::vector<SInterval>  pending = m_Pending;
+    sortIntervals( pending );
+    for( const auto& interval : pending )
+    {
+        merge( state, interval );
+    }
+
+    results = state.Results;
+}
+
+void COccupancyTracker::sortIntervals( std::vector<SInterval>& intervals )
+{
+    std::sort( intervals.begin(), intervals.end(),
+        []( const SInterval& a, const SInterval& b )
+        {
+            return a.StartNS < b.StartNS;
+        });
+}
+
+void COccupancyTracker::merge( SState& state, const SInterval& interval )
+{
+    SResults&   results = state.Results;
+
+    if( !state.HaveRun )
+    {
+        results.FirstStartNS = interval.StartNS;
+        results.BusyNS += interval.EndNS - interval.StartNS;
+
+        state.HaveRun = true;
+        state.RunEndNS = interval.EndNS;
+        state.RunEndTag = interval.Tag;
+    }
+    else if( interval.StartNS <= state.RunEndNS )
+    {
+        if( interval.EndNS > state.RunEndNS )
+        {
+            results.BusyNS += interval.EndNS - state.RunEndNS;
+
+            state.RunEndNS = interval.EndNS;
+            state.RunEndTag = interval.Tag;
+        }
+    }
+    else
+    {
+        const uint64_t  gapNS = interval.StartNS - state.RunEndNS;
+
+        results.NumGaps++;
+        results.TotalGapNS += gapNS;
+        results.MinGapNS = std::min( results.MinGapNS, gapNS );
+        results.MaxGapNS = std::max( results.MaxGapNS, gapNS );
+        results.GapHistogram.add( gapNS );
+
+        // Insert the gap into the sorted list of largest gaps.
+        size_t  index = results.NumLargestGaps;
+        while( index > 0 && results.LargestGaps[index - 1].GapNS < gapNS )
+        {
+            if( index < cMaxLargestGaps )
+            {
+                results.LargestGaps[index] = results.LargestGaps[index - 1];
+            }
+            index--;
+        }
+        if( index < cMaxLargestGaps )
+        {
+            SGap&   gap = results.LargestGaps[index];
+            gap.GapNS = gapNS;
+            gap.StartNS = state.RunEndNS;
+            gap.PrecedingTag = state.RunEndTag;
+
+            results.NumLargestGaps = std::min(
+                results.NumLargestGaps + 1,
+                cMaxLargestGaps );
+        }
+
+        results.BusyNS += interval.EndNS - interval.StartNS;
+
+        state.RunEndNS = interval.EndNS;
+        state.RunEndTag = interval.Tag;
+    }
+
+    results.LastEndNS = state.RunEndNS;
+}
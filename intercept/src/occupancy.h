@@ -0,0 +1,93 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "histogram.h"
+
+// This class computes the union of the busy intervals of a device or a
+// command queue, and the idle gaps between them.  Intervals may be added out
+// of order, so recent intervals are kept in a reorder window and are merged
+// once the window is full.  An interval that arrives after intervals that
+// start later than it has already been merged is only counted where it
+// extends past the merged intervals, so a gap that it would have filled may
+// still be reported.  This class is not thread safe.
+class COccupancyTracker
+{
+public:
+    typedef CLogLinearHistogram< 3, 40 >    CGapHistogram;
+
+    static const size_t cMaxLargestGaps = 5;
+
+    struct SGap
+    {
+        uint64_t    GapNS;
+        uint64_t    StartNS;
+        uint32_t    PrecedingTag;
+    };
+
+    struct SResults
+    {
+        uint64_t    Commands = 0;
+        uint64_t    FirstStartNS = 0;
+        uint64_t    LastEndNS = 0;
+        uint64_t    BusyNS = 0;
+
+        uint64_t    NumGaps = 0;
+        uint64_t    TotalGapNS = 0;
+        uint64_t    MinGapNS = UINT64_MAX;
+        uint64_t    MaxGapNS = 0;
+        CGapHistogram   GapHistogram;
+
+        // The largest gaps, largest first, and the tag of the interval
+        // that ended when each gap started.
+        size_t      NumLargestGaps = 0;
+        SGap        LargestGaps[cMaxLargestGaps];
+
+        uint64_t    elapsedNS() const
+        {
+            return LastEndNS - FirstStartNS;
+        }
+    };
+
+    COccupancyTracker();
+
+    void    add( uint64_t startNS, uint64_t endNS, uint32_t tag );
+
+    // Gets the results for all intervals that have been added, including
+    // the intervals in the reorder window.
+    void    getResults( SResults& results ) const;
+
+private:
+    static const size_t cMaxPending = 1024;
+
+    struct SInterval
+    {
+        uint64_t    StartNS;
+        uint64_t    EndNS;
+        uint32_t    Tag;
+    };
+
+    struct SState
+    {
+        SResults    Results;
+
+        bool        HaveRun = false;
+        uint64_t    RunEndNS = 0;
+        uint32_t    RunEndTag = 0;
+    };
+
+    std::vector<SInterval>  m_Pending;
+    SState  m_State;
+
+    static void sortIntervals( std::vector<SInterval>& intervals );
+    static void merge( SState& state, const SInterval& interval );
+};
@@ -0,0 +1,696 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#include <algorithm>
+
+#include "perfettowriter.h"
+
+// Field numbers from the Perfetto trace protos.  Only the fields that are
+// written are listed here.
+enum
+{
+    cWireType_Varint = 0,
+    cWireType_Fixed64 = 1,
+    cWireType_LengthDelimited = 2,
+};
+
+enum
+{
+    cTrace_Packet = 1,
+};
+
+enum
+{
+    cTracePacket_Timestamp = 8,
+    cTracePacket_TrustedPacketSequenceId = 10,
+    cTracePacket_TrackEvent = 11,
+    cTracePacket_InternedData = 12,
+    cTracePacket_SequenceFlags = 13,
+    cTracePacket_TrackDescriptor = 60,
+    cTracePacket_FirstPacketOnSequence = 87,
+
+    cSequenceFlags_IncrementalStateCleared = 1,
+    cSequenceFlags_NeedsIncrementalState = 2,
+};
+
+enum
+{
+    cInternedData_EventCategories = 1,
+    cInternedData_EventNames = 2,
+    cInternedData_DebugAnnotationNames = 3,
+
+    // EventCategory, EventName, and DebugAnnotationName.
+    cInternedString_Iid = 1,
+    cInternedString_Name = 2,
+};
+
+enum
+{
+    cTrackDescriptor_Uuid = 1,
+    cTrackDescriptor_Name = 2,
+    cTrackDescriptor_Process = 3,
+    cTrackDescriptor_Thread = 4,
+    cTrackDescriptor_ParentUuid = 5,
+    cTrackDescriptor_Counter = 8,
+    cTrackDescriptor_ChildOrdering = 11,
+    cTrackDescriptor_SiblingOrderRank = 12,
+
+    cChildOrdering_Explicit = 3,
+
+    cProcessDescriptor_Pid = 1,
+    cProcessDescriptor_ProcessName = 6,
+
+    cThreadDescriptor_Pid = 1,
+    cThreadDescriptor_Tid = 2,
+    cThreadDescriptor_ThreadName = 5,
+};
+
+enum
+{
+    cTrackEvent_CategoryIids = 3,
+    cTrackEvent_DebugAnnotations = 4,
+    cTrackEvent_Type = 9,
+    cTrackEvent_NameIid = 10,
+    cTrackEvent_TrackUuid = 11,
+    cTrackEvent_CounterValue = 30,
+    cTrackEvent_FlowIds = 47,
+    cTrackEvent_TerminatingFlowIds = 48,
+
+    cTrackEventType_SliceBegin = 1,
+    cTrackEventType_SliceEnd = 2,
+    cTrackEventType_Counter = 4,
+
+    cDebugAnnotation_NameIid = 1,
+    cDebugAnnotation_UintValue = 3,
+};
+
+// Interned categories and debug annotation names, which are written in the
+// first packet of the sequence.
+enum
+{
+    cCategoryIid_Calls = 1,
+    cCategoryIid_Commands = 2,
+
+    cDebugAnnotationIid_Id = 1,
+};
+
+// Nested messages are written with a length that is padded to four bytes,
+// which is valid protobuf, so the length can be patched in place once the
+// message is complete.  This limits the size of a message to 256MB.
+static const size_t cPaddedLengthSize = 4;
+
+static constexpr size_t cNumStages = 3;
+static constexpr const char* cStageSuffixes[cNumStages] = {
+    "(Queued)",
+    "(Submitted)",
+    "(Execution)"
+};
+
+CPerfettoWriter::CPerfettoWriter() :
+    m_pBuffer( NULL ),
+    m_pStringInterner( NULL ),
+    m_ProcessId( 0 ),
+    m_SequenceId( 1 ),
+    m_AddFlowEvents( false ),
+    m_StartTimeNS( 0 ),
+    m_LastNameIid( 0 ) {}
+
+void CPerfettoWriter::init(
+    std::string* pBuffer,
+    uint64_t processId,
+    bool addFlowEvents,
+    CStringInterner* pStringInterner )
+{
+    m_pBuffer = pBuffer;
+    m_ProcessId = processId;
+    m_AddFlowEvents = addFlowEvents;
+    m_pStringInterner = pStringInterner;
+
+    // Packet sequences from different processes must not collide if traces
+    // from multiple processes are concatenated, and zero is not valid.
+    m_SequenceId = (uint32_t)processId != 0 ? (uint32_t)processId : 1;
+
+    size_t  packet = beginPacket();
+    putUInt( cTracePacket_SequenceFlags, cSequenceFlags_IncrementalStateCleared );
+    putUInt( cTracePacket_FirstPacketOnSequence, 1 );
+
+    size_t  internedData = beginMessage( cTracePacket_InternedData );
+    {
+        size_t  category = beginMessage( cInternedData_EventCategories );
+        putUInt( cInternedString_Iid, cCategoryIid_Calls );
+        putString( cInternedString_Name, "Calls" );
+        endMessage( category );
+    }
+    {
+        size_t  category = beginMessage( cInternedData_EventCategories );
+        putUInt( cInternedString_Iid, cCategoryIid_Commands );
+        putString( cInternedString_Name, "Commands" );
+        endMessage( category );
+    }
+    {
+        size_t  annotationName = beginMessage( cInternedData_DebugAnnotationNames );
+        putUInt( cInternedString_Iid, cDebugAnnotationIid_Id );
+        putString( cInternedString_Name, "id" );
+        endMessage( annotationName );
+    }
+    endMessage( internedData );
+
+    endMessage( packet );
+}
+
+void CPerfettoWriter::addProcess(
+    const std::string& processName )
+{
+    size_t  packet = beginPacket();
+    size_t  descriptor = beginMessage( cTracePacket_TrackDescriptor );
+    putUInt( cTrackDescriptor_Uuid, makeId( cIdKind_ProcessTrack, 0 ) );
+    {
+        size_t  process = beginMessage( cTrackDescriptor_Process );
+        putInt32( cProcessDescriptor_Pid, (int32_t)m_ProcessId );
+        putString( cProcessDescriptor_ProcessName, processName );
+        endMessage( process );
+    }
+    putUInt( cTrackDescriptor_ChildOrdering, cChildOrdering_Explicit );
+    endMessage( descriptor );
+    endMessage( packet );
+}
+
+void CPerfettoWriter::addThread(
+    uint64_t threadId,
+    uint32_t threadNumber )
+{
+    m_Threads.insert( threadId );
+    writeThreadDescriptor( threadId, threadNumber, true );
+}
+
+void CPerfettoWriter::setStartTime(
+    uint64_t usStartTime )
+{
+    // Timestamps are relative to the start time, like the JSON trace, but
+    // Perfetto has no equivalent of the start time metadata, so the start
+    // time is added to every timestamp instead.  This keeps traces from
+    // multiple processes aligned when they are merged.
+    m_StartTimeNS = usStartTime * 1000;
+}
+
+void CPerfettoWriter::addQueue(
+    uint32_t queueNumber,
+    const std::string& queueName )
+{
+    STrackLanes&    lanes = m_QueueTracks[ queueNumber ];
+    lanes.Name = queueName;
+    lanes.HasRank = true;
+    lanes.Rank = (int32_t)queueNumber;
+
+    // Rewrite the descriptors for any lanes that were already described
+    // with a different name.
+    lanes.DescribedLanes = 0;
+    writeLaneDescriptors(
+        cIdKind_QueueTrack,
+        queueNumber,
+        lanes,
+        std::max< size_t >( lanes.LaneEndNS.size(), 1 ) );
+}
+
+void CPerfettoWriter::addCounters(
+    const char* name,
+    uint64_t time,
+    size_t numCounters,
+    const char* const* counterNames,
+    const uint64_t* counterValues )
+{
+    const CStringInterner::Id   nameId = m_pStringInterner->intern( name );
+    for( size_t i = 0; i < numCounters; i++ )
+    {
+        const CStringInterner::Id   counterNameId =
+            m_pStringInterner->intern( counterNames[i] );
+        const uint64_t  uuid = makeId(
+            cIdKind_CounterTrack,
+            ( (uint64_t)counterNameId << 32 ) | nameId );
+        if( m_CounterTracks.insert( uuid ).second )
+        {
+            std::string trackName = name;
+            trackName += ": ";
+            trackName += counterNames[i];
+            writeTrackDescriptor( uuid, trackName, false, 0, true );
+        }
+
+        size_t  packet = beginEventPacket( time );
+        size_t  event = beginMessage( cTracePacket_TrackEvent );
+        putUInt( cTrackEvent_Type, cTrackEventType_Counter );
+        putUInt( cTrackEvent_TrackUuid, uuid );
+        putUInt( cTrackEvent_CounterValue, counterValues[i] );
+        endMessage( event );
+        endMessage( packet );
+    }
+}
+
+void CPerfettoWriter::addCallLogging(
+    CStringInterner::Id name,
+    CStringInterner::Id tag,
+    bool hasTag,
+    uint64_t threadId,
+    uint64_t startTime,
+    uint64_t delta,
+    bool hasId,
+    uint64_t id )
+{
+    if( m_Threads.insert( threadId ).second )
+    {
+        writeThreadDescriptor( threadId, 0, false );
+    }
+
+    const uint64_t  nameIid = hasTag ?
+        getTaggedNameIid( name, tag ) :
+        getNameIid( name );
+    const bool  hasFlow = hasId && m_AddFlowEvents;
+
+    writeSlice(
+        makeId( cIdKind_ThreadTrack, threadId ),
+        nameIid,
+        cCategoryIid_Calls,
+        startTime,
+        startTime + delta,
+        hasFlow ? cTrackEvent_FlowIds : 0,
+        makeId( cIdKind_Flow, id ),
+        false,
+        0 );
+}
+
+void CPerfettoWriter::addDeviceTiming(
+    CStringInterner::Id name,
+    bool perKernel,
+    uint32_t queueNumber,
+    uint64_t startTime,
+    uint64_t endTime,
+    uint64_t id )
+{
+    const EIdKind   kind = perKernel ? cIdKind_KernelTrack : cIdKind_QueueTrack;
+    const uint64_t  key = perKernel ? name : queueNumber;
+    STrackLanes&    lanes = perKernel ?
+        getKernelTrack( name ) :
+        getQueueTrack( queueNumber );
+
+    endTime = std::max( startTime, endTime );
+
+    const uint64_t  uuid = allocateLane( kind, key, lanes, startTime, endTime );
+    writeSlice(
+        uuid,
+        getNameIid( name ),
+        cCategoryIid_Commands,
+        startTime,
+        endTime,
+        m_AddFlowEvents ? cTrackEvent_TerminatingFlowIds : 0,
+        makeId( cIdKind_Flow, id ),
+        true,
+        id );
+}
+
+void CPerfettoWriter::addDeviceTimingInStages(
+    CStringInterner::Id name,
+    bool perKernel,
+    uint32_t queueNumber,
+    uint64_t queuedTime,
+    uint64_t submitTime,
+    uint64_t startTime,
+    uint64_t endTime,
+    uint64_t id )
+{
+    const EIdKind   kind = perKernel ? cIdKind_KernelTrack : cIdKind_QueueTrack;
+    const uint64_t  key = perKernel ? name : queueNumber;
+    STrackLanes&    lanes = perKernel ?
+        getKernelTrack( name ) :
+        getQueueTrack( queueNumber );
+
+    // The stages are written as consecutive slices on the same lane, so
+    // they must not go backwards.
+    uint64_t    stageTimes[cNumStages + 1] = {
+        queuedTime,
+        submitTime,
+        startTime,
+        endTime,
+    };
+    for( size_t stage = 1; stage <= cNumStages; stage++ )
+    {
+        stageTimes[stage] = std::max( stageTimes[stage - 1], stageTimes[stage] );
+    }
+
+    const uint64_t  uuid = allocateLane(
+        kind,
+        key,
+        lanes,
+        stageTimes[0],
+        stageTimes[cNumStages] );
+    for( uint32_t stage = 0; stage < cNumStages; stage++ )
+    {
+        writeSlice(
+            uuid,
+            getStageNameIid( name, stage ),
+            cCategoryIid_Commands,
+            stageTimes[stage],
+            stageTimes[stage + 1],
+            0,
+            0,
+            true,
+            id );
+    }
+}
+
+void CPerfettoWriter::putVarint( uint64_t value )
+{
+    while( value >= 0x80 )
+    {
+        m_pBuffer->push_back( (char)( ( value & 0x7F ) | 0x80 ) );
+        value >>= 7;
+    }
+    m_pBuffer->push_back( (char)value );
+}
+
+void CPerfettoWriter::putTag( uint32_t field, uint32_t wireType )
+{
+    putVarint( ( (uint64_t)field << 3 ) | wireType );
+}
+
+void CPerfettoWriter::putUInt( uint32_t field, uint64_t value )
+{
+    putTag( field, cWireType_Varint );
+    putVarint( value );
+}
+
+void CPerfettoWriter::putInt32( uint32_t field, int32_t value )
+{
+    // Negative int32 values are sign extended to 64 bits.
+    putTag( field, cWireType_Varint );
+    putVarint( (uint64_t)(int64_t)value );
+}
+
+void CPerfettoWriter::putFixed64( uint32_t field, uint64_t value )
+{
+    putTag( field, cWireType_Fixed64 );
+    for( int i = 0; i < 8; i++ )
+    {
+        m_pBuffer->push_back( (char)( value >> ( i * 8 ) ) );
+    }
+}
+
+void CPerfettoWriter::putString( uint32_t field, const std::string& str )
+{
+    putTag( field, cWireType_LengthDelimited );
+    putVarint( str.size() );
+    m_pBuffer->append( str );
+}
+
+size_t CPerfettoWriter::beginMessage( uint32_t field )
+{
+    putTag( field, cWireType_LengthDelimited );
+    const size_t    offset = m_pBuffer->size();
+    m_pBuffer->append( cPaddedLengthSize, '\0' );
+    return offset;
+}
+
+void CPerfettoWriter::endMessage( size_t offset )
+{
+    const size_t    size = m_pBuffer->size() - offset - cPaddedLengthSize;
+    char*   pLength = &(*m_pBuffer)[offset];
+    for( size_t i = 0; i < cPaddedLengthSize; i++ )
+    {
+        const bool  last = i == cPaddedLengthSize - 1;
+        pLength[i] = (char)( ( ( size >> ( i * 7 ) ) & 0x7F ) | ( last ? 0 : 0x80 ) );
+    }
+}
+
+size_t CPerfettoWriter::beginPacket()
+{
+    size_t  packet = beginMessage( cTrace_Packet );
+    putUInt( cTracePacket_TrustedPacketSequenceId, m_SequenceId );
+    return packet;
+}
+
+size_t CPerfettoWriter::beginEventPacket( uint64_t timeNS )
+{
+    size_t  packet = beginPacket();
+    putUInt( cTracePacket_Timestamp, m_StartTimeNS + timeNS );
+    putUInt( cTracePacket_SequenceFlags, cSequenceFlags_NeedsIncrementalState );
+
+    if( !m_PendingNames.empty() )
+    {
+        size_t  internedData = beginMessage( cTracePacket_InternedData );
+        for( const auto& pendingName : m_PendingNames )
+        {
+            size_t  eventName = beginMessage( cInternedData_EventNames );
+            putUInt( cInternedString_Iid, pendingName.first );
+            putString( cInternedString_Name, pendingName.second );
+            endMessage( eventName );
+        }
+        endMessage( internedData );
+
+        m_PendingNames.clear();
+    }
+
+    return packet;
+}
+
+uint64_t CPerfettoWriter::makeId( EIdKind kind, uint64_t key ) const
+{
+    // This is the splitmix64 finalizer.
+    uint64_t    x = key ^ ( ( m_ProcessId << 8 | kind ) * 0x9E3779B97F4A7C15ULL );
+    x = ( x ^ ( x >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    x = ( x ^ ( x >> 27 ) ) * 0x94D049BB133111EBULL;
+    return x ^ ( x >> 31 );
+}
+
+uint64_t CPerfettoWriter::getNameIid( CStringInterner::Id name )
+{
+    if( name >= m_NameIids.size() )
+    {
+        m_NameIids.resize( name + 1, 0 );
+    }
+
+    uint64_t&   iid = m_NameIids[name];
+    if( iid == 0 )
+    {
+        iid = ++m_LastNameIid;
+        m_PendingNames.emplace_back( iid, m_pStringInterner->name( name ) );
+    }
+    return iid;
+}
+
+uint64_t CPerfettoWriter::getTaggedNameIid(
+    CStringInterner::Id name,
+    CStringInterner::Id tag )
+{
+    const uint64_t  key = ( (uint64_t)name << 32 ) | tag;
+
+    auto iter = m_TaggedNameIids.find( key );
+    if( iter != m_TaggedNameIids.end() )
+    {
+        return iter->second;
+    }
+
+    const uint64_t  iid = ++m_LastNameIid;
+    m_TaggedNameIids[ key ] = iid;
+    m_PendingNames.emplace_back(
+        iid,
+        m_pStringInterner->name( name ) + "( " + m_pStringInterner->name( tag ) + " )" );
+    return iid;
+}
+
+uint64_t CPerfettoWriter::getStageNameIid(
+    CStringInterner::Id name,
+    uint32_t stage )
+{
+    const uint64_t  key = (uint64_t)name * cNumStages + stage;
+
+    auto iter = m_StageNameIids.find( key );
+    if( iter != m_StageNameIids.end() )
+    {
+        return iter->second;
+    }
+
+    const uint64_t  iid = ++m_LastNameIid;
+    m_StageNameIids[ key ] = iid;
+    m_PendingNames.emplace_back(
+        iid,
+        m_pStringInterner->name( name ) + " " + cStageSuffixes[stage] );
+    return iid;
+}
+
+void CPerfettoWriter::writeTrackDescriptor(
+    uint64_t uuid,
+    const std::string& name,
+    bool hasRank,
+    int32_t rank,
+    bool counter )
+{
+    size_t  packet = beginPacket();
+    size_t  descriptor = beginMessage( cTracePacket_TrackDescriptor );
+    putUInt( cTrackDescriptor_Uuid, uuid );
+    putUInt( cTrackDescriptor_ParentUuid, makeId( cIdKind_ProcessTrack, 0 ) );
+    putString( cTrackDescriptor_Name, name );
+    if( counter )
+    {
+        endMessage( beginMessage( cTrackDescriptor_Counter ) );
+    }
+    if( hasRank )
+    {
+        putInt32( cTrackDescriptor_SiblingOrderRank, rank );
+    }
+    endMessage( descriptor );
+    endMessage( packet );
+}
+
+void CPerfettoWriter::writeThreadDescriptor(
+    uint64_t threadId,
+    uint32_t threadNumber,
+    bool hasThreadNumber )
+{
+    size_t  packet = beginPacket();
+    size_t  descriptor = beginMessage( cTracePacket_TrackDescriptor );
+    putUInt( cTrackDescriptor_Uuid, makeId( cIdKind_ThreadTrack, threadId ) );
+    putUInt( cTrackDescriptor_ParentUuid, makeId( cIdKind_ProcessTrack, 0 ) );
+    {
+        size_t  thread = beginMessage( cTrackDescriptor_Thread );
+        putInt32( cThreadDescriptor_Pid, (int32_t)m_ProcessId );
+        putInt32( cThreadDescriptor_Tid, (int32_t)threadId );
+        putString( cThreadDescriptor_ThreadName,
+            "Host Thread " + std::to_string( threadId ) );
+        endMessage( thread );
+    }
+    if( hasThreadNumber )
+    {
+        // Host threads are sorted after the command queues, as they are in
+        // the JSON trace.
+        putInt32( cTrackDescriptor_SiblingOrderRank, (int32_t)( threadNumber + 10000 ) );
+    }
+    endMessage( descriptor );
+    endMessage( packet );
+}
+
+void CPerfettoWriter::writeLaneDescriptors(
+    EIdKind kind,
+    uint64_t key,
+    STrackLanes& lanes,
+    size_t numLanes )
+{
+    for( size_t lane = lanes.DescribedLanes; lane < numLanes; lane++ )
+    {
+        writeTrackDescriptor(
+            makeId( kind, key | ( (uint64_t)lane << 32 ) ),
+            lanes.Name,
+            lanes.HasRank,
+            lanes.Rank,
+            false );
+    }
+    lanes.DescribedLanes = std::max( lanes.DescribedLanes, numLanes );
+}
+
+CPerfettoWriter::STrackLanes& CPerfettoWriter::getQueueTrack(
+    uint32_t queueNumber )
+{
+    auto iter = m_QueueTracks.find( queueNumber );
+    if( iter != m_QueueTracks.end() )
+    {
+        return iter->second;
+    }
+
+    // Queues should always be described before commands are traced, but
+    // just in case, give the queue a name.
+    STrackLanes&    lanes = m_QueueTracks[ queueNumber ];
+    lanes.Name = "Queue " + std::to_string( queueNumber );
+    lanes.HasRank = true;
+    lanes.Rank = (int32_t)queueNumber;
+    return lanes;
+}
+
+CPerfettoWriter::STrackLanes& CPerfettoWriter::getKernelTrack(
+    CStringInterner::Id name )
+{
+    auto iter = m_KernelTracks.find( name );
+    if( iter != m_KernelTracks.end() )
+    {
+        return iter->second;
+    }
+
+    STrackLanes&    lanes = m_KernelTracks[ name ];
+    lanes.Name = m_pStringInterner->name( name );
+    return lanes;
+}
+
+uint64_t CPerfettoWriter::allocateLane(
+    EIdKind kind,
+    uint64_t key,
+    STrackLanes& lanes,
+    uint64_t startNS,
+    uint64_t endNS )
+{
+    std::vector<uint64_t>&  laneEndNS = lanes.LaneEndNS;
+
+    size_t  lane = 0;
+    while( lane < laneEndNS.size() && laneEndNS[lane] > startNS )
+    {
+        lane++;
+    }
+    if( lane == laneEndNS.size() )
+    {
+        if( laneEndNS.size() < cMaxLanes )
+        {
+            laneEndNS.push_back( 0 );
+        }
+        else
+        {
+            // Too many overlapping slices, so reuse the lane that ends
+            // first, even though the slices on it will not nest.
+            lane = std::min_element( laneEndNS.begin(), laneEndNS.end() ) -
+                laneEndNS.begin();
+        }
+    }
+    laneEndNS[lane] = std::max( laneEndNS[lane], endNS );
+
+    writeLaneDescriptors( kind, key, lanes, lane + 1 );
+    return makeId( kind, key | ( (uint64_t)lane << 32 ) );
+}
+
+void CPerfettoWriter::writeSlice(
+    uint64_t trackUuid,
+    uint64_t nameIid,
+    uint64_t categoryIid,
+    uint64_t startNS,
+    uint64_t endNS,
+    uint32_t flowField,
+    uint64_t flowId,
+    bool hasId,
+    uint64_t id )
+{
+    {
+        size_t  packet = beginEventPacket( startNS );
+        size_t  event = beginMessage( cTracePacket_TrackEvent );
+        putUInt( cTrackEvent_Type, cTrackEventType_SliceBegin );
+        putUInt( cTrackEvent_TrackUuid, trackUuid );
+        putUInt( cTrackEvent_CategoryIids, categoryIid );
+        putUInt( cTrackEvent_NameIid, nameIid );
+        if( hasId )
+        {
+            size_t  annotation = beginMessage( cTrackEvent_DebugAnnotations );
+            putUInt( cDebugAnnotation_NameIid, cDebugAnnotationIid_Id );
+            putUInt( cDebugAnnotation_UintValue, id );
+            endMessage( annotation );
+        }
+        if( flowField != 0 )
+        {
+            putFixed64( flowField, flowId );
+        }
+        endMessage( event );
+        endMessage( packet );
+    }
+    {
+        size_t  packet = beginEventPacket( endNS );
+        size_t  event = beginMessage( cTracePacket_TrackEvent );
+        putUInt( cTrackEvent_Type, cTrackEventType_SliceEnd );
+        putUInt( cTrackEvent_TrackUuid, trackUuid );
+        endMessage( event );
+        endMessage( packet );
+    }
+}
@@ -0,0 +1,194 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "stringinterner.h"
+
+// This class encodes Chrome Tracing records as Perfetto TracePackets
+// containing TrackEvents, so large traces can be loaded into the Perfetto UI
+// and trace_processor.  The protobuf encoding is written by hand, so there
+// is no dependency on the Perfetto SDK or on protobuf.  The packets are
+// appended to a buffer owned by the caller, which writes the buffer to the
+// trace file.  Every packet uses the same sequence, and event names are
+// interned on the sequence so each name is only written once.
+//
+// There is a track for the process, a track for each host thread, and a
+// track for each command queue, or for each kernel name when commands are
+// traced per kernel.  Slices on a Perfetto track must nest, so a command
+// that overlaps a previous command on the same track, for example in an
+// out-of-order queue or when commands are traced in stages, is put on an
+// additional lane: a sibling track with the same name.
+// This class is not thread safe.
+class CPerfettoWriter
+{
+public:
+    CPerfettoWriter();
+
+    void    init(
+                std::string* pBuffer,
+                uint64_t processId,
+                bool addFlowEvents,
+                CStringInterner* pStringInterner );
+
+    void    addProcess(
+                const std::string& processName );
+    void    addThread(
+                uint64_t threadId,
+                uint32_t threadNumber );
+    void    setStartTime(
+                uint64_t usStartTime );
+    void    addQueue(
+                uint32_t queueNumber,
+                const std::string& queueName );
+    void    addCounters(
+                const char* name,
+                uint64_t time,
+                size_t numCounters,
+                const char* const* counterNames,
+                const uint64_t* counterValues );
+
+    void    addCallLogging(
+                CStringInterner::Id name,
+                CStringInterner::Id tag,
+                bool hasTag,
+                uint64_t threadId,
+                uint64_t startTime,
+                uint64_t delta,
+                bool hasId,
+                uint64_t id );
+
+    void    addDeviceTiming(
+                CStringInterner::Id name,
+                bool perKernel,
+                uint32_t queueNumber,
+                uint64_t startTime,
+                uint64_t endTime,
+                uint64_t id );
+    void    addDeviceTimingInStages(
+                CStringInterner::Id name,
+                bool perKernel,
+                uint32_t queueNumber,
+                uint64_t queuedTime,
+                uint64_t submitTime,
+                uint64_t startTime,
+                uint64_t endTime,
+                uint64_t id );
+
+private:
+    static const size_t cMaxLanes = 64;
+
+    // Track UUIDs and flow IDs must be unique across traces that are
+    // merged, so they are derived from the process ID, a kind, and a key.
+    enum EIdKind
+    {
+        cIdKind_ProcessTrack,
+        cIdKind_ThreadTrack,
+        cIdKind_QueueTrack,
+        cIdKind_KernelTrack,
+        cIdKind_CounterTrack,
+        cIdKind_Flow,
+    };
+
+    struct STrackLanes
+    {
+        std::string Name;
+        bool        HasRank = false;
+        int32_t     Rank = 0;
+
+        // The end time of the last slice on each lane, and the number of
+        // lanes whose track descriptors have been written.
+        std::vector<uint64_t>   LaneEndNS;
+        size_t      DescribedLanes = 0;
+    };
+
+    std::string*    m_pBuffer;
+    CStringInterner*    m_pStringInterner;
+
+    uint64_t    m_ProcessId;
+    uint32_t    m_SequenceId;
+    bool        m_AddFlowEvents;
+    uint64_t    m_StartTimeNS;
+
+    // Event name iids for plain names, indexed by string ID, and for names
+    // composed from a name and a tag or a stage.
+    uint64_t    m_LastNameIid;
+    std::vector<uint64_t>   m_NameIids;
+    std::unordered_map<uint64_t, uint64_t>  m_TaggedNameIids;
+    std::unordered_map<uint64_t, uint64_t>  m_StageNameIids;
+
+    // Names that have been assigned iids but have not been written to the
+    // trace yet.  They are written with the next event.
+    std::vector< std::pair<uint64_t, std::string> > m_PendingNames;
+
+    std::unordered_set<uint64_t>    m_Threads;
+    std::unordered_map<uint32_t, STrackLanes>   m_QueueTracks;
+    std::unordered_map<CStringInterner::Id, STrackLanes>    m_KernelTracks;
+    std::unordered_set<uint64_t>    m_CounterTracks;
+
+    // Protobuf encoding.
+    void    putVarint( uint64_t value );
+    void    putTag( uint32_t field, uint32_t wireType );
+    void    putUInt( uint32_t field, uint64_t value );
+    void    putInt32( uint32_t field, int32_t value );
+    void    putFixed64( uint32_t field, uint64_t value );
+    void    putString( uint32_t field, const std::string& str );
+    size_t  beginMessage( uint32_t field );
+    void    endMessage( size_t offset );
+
+    size_t  beginPacket();
+    size_t  beginEventPacket( uint64_t timeNS );
+
+    uint64_t    makeId( EIdKind kind, uint64_t key ) const;
+    uint64_t    getNameIid( CStringInterner::Id name );
+    uint64_t    getTaggedNameIid( CStringInterner::Id name, CStringInterner::Id tag );
+    uint64_t    getStageNameIid( CStringInterner::Id name, uint32_t stage );
+
+    void    writeTrackDescriptor(
+                uint64_t uuid,
+                const std::string& name,
+                bool hasRank,
+                int32_t rank,
+                bool counter );
+    void    writeThreadDescriptor(
+                uint64_t threadId,
+                uint32_t threadNumber,
+                bool hasThreadNumber );
+    void    writeLaneDescriptors(
+                EIdKind kind,
+                uint64_t key,
+                STrackLanes& lanes,
+                size_t numLanes );
+
+    STrackLanes&    getQueueTrack( uint32_t queueNumber );
+    STrackLanes&    getKernelTrack( CStringInterner::Id name );
+    uint64_t    allocateLane(
+                    EIdKind kind,
+                    uint64_t key,
+                    STrackLanes& lanes,
+                    uint64_t startNS,
+                    uint64_t endNS );
+
+    void    writeSlice(
+                uint64_t trackUuid,
+                uint64_t nameIid,
+                uint64_t categoryIid,
+                uint64_t startNS,
+                uint64_t endNS,
+                uint32_t flowField,
+                uint64_t flowId,
+                bool hasId,
+                uint64_t id );
+};
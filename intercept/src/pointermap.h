@@ -0,0 +1,267 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+// This is a hash map keyed by pointers or OpenCL handles.  It is used in
+// place of std::map for the tracking tables that are queried on every
+// enqueue, since a lookup usually touches a single cache line rather than
+// walking a tree.
+//
+// The map uses open addressing with linear probing and a power-of-two
+// number of slots.  Erasing an entry shifts the following entries in the
+// same probe sequence back into the hole, so no tombstones are needed and
+// lookups never get slower as entries are added and removed.  An empty slot
+// is marked with a key that has all bits set, which is never a valid handle
+// or allocation pointer.  A NULL key is valid.
+//
+// Inserting into the map may move entries, so references and iterators are
+// only valid until the next insertion or erasure, unlike std::map.  This is
+// sufficient for the tracking tables, which are always accessed under a
+// lock and never hold references across an insertion into the same map.
+template< class K, class V >
+class CPointerMap
+{
+public:
+    typedef K                   key_type;
+    typedef V                   mapped_type;
+    typedef std::pair<K, V>     value_type;
+
+    template< class M, class P >
+    class iterator_base
+    {
+    public:
+        iterator_base() : m_pMap(NULL), m_Index(0) {}
+        iterator_base( M* pMap, size_t index ) : m_pMap(pMap), m_Index(index)
+        {
+            skipEmpty();
+        }
+
+        // Allow conversion from iterator to const_iterator.
+        template< class M2, class P2 >
+        iterator_base( const iterator_base<M2, P2>& other ) :
+            m_pMap(other.m_pMap), m_Index(other.m_Index) {}
+
+        P& operator*() const { return m_pMap->m_Slots[m_Index]; }
+        P* operator->() const { return &m_pMap->m_Slots[m_Index]; }
+
+        iterator_base& operator++()
+        {
+            m_Index++;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==( const iterator_base& other ) const
+        {
+            return m_Index == other.m_Index;
+        }
+        bool operator!=( const iterator_base& other ) const
+        {
+            return m_Index != other.m_Index;
+        }
+
+    private:
+        template< class, class > friend class iterator_base;
+        friend class CPointerMap;
+
+        M*      m_pMap;
+        size_t  m_Index;
+
+        void skipEmpty()
+        {
+            while( m_Index < m_pMap->m_Slots.size() &&
+                   m_pMap->isEmpty( m_Index ) )
+            {
+                m_Index++;
+            }
+        }
+    };
+
+    typedef iterator_base< CPointerMap, value_type >                iterator;
+    typedef iterator_base< const CPointerMap, const value_type >    const_iterator;
+
+    CPointerMap() : m_Size(0), m_Shift(64) {}
+
+    iterator        begin()         { return iterator( this, 0 ); }
+    iterator        end()           { return iterator( this, m_Slots.size() ); }
+    const_iterator  begin() const   { return const_iterator( this, 0 ); }
+    const_iterator  end() const     { return const_iterator( this, m_Slots.size() ); }
+
+    size_t  size() const    { return m_Size; }
+    bool    empty() const   { return m_Size == 0; }
+
+    void clear()
+    {
+        m_Slots.clear();
+        m_Size = 0;
+        m_Shift = 64;
+    }
+
+    iterator find( K key )
+    {
+        return iterator( this, findIndex( key ) );
+    }
+    const_iterator find( K key ) const
+    {
+        return const_iterator( this, findIndex( key ) );
+    }
+
+    size_t count( K key ) const
+    {
+        return findIndex( key ) != m_Slots.size() ? 1 : 0;
+    }
+
+    V& operator[]( K key )
+    {
+        size_t  index = findIndex( key );
+        if( index == m_Slots.size() )
+        {
+            // Grow when the map would be more than 3/4 full.
+            if( ( m_Size + 1 ) * 4 > m_Slots.size() * 3 )
+            {
+                rehash( m_Slots.empty() ? cMinSlots : m_Slots.size() * 2 );
+            }
+
+            index = insertIndex( key );
+            m_Slots[index].first = key;
+            m_Size++;
+        }
+        return m_Slots[index].second;
+    }
+
+    size_t erase( K key )
+    {
+        const size_t    index = findIndex( key );
+        if( index == m_Slots.size() )
+        {
+            return 0;
+        }
+        eraseIndex( index );
+        return 1;
+    }
+
+    void erase( const_iterator it )
+    {
+        eraseIndex( it.m_Index );
+    }
+
+private:
+    static const size_t cMinSlots = 16;
+
+    std::vector<value_type> m_Slots;
+    size_t      m_Size;
+    unsigned    m_Shift;
+
+    static K emptyKey()
+    {
+        return reinterpret_cast<K>( ~(uintptr_t)0 );
+    }
+
+    bool isEmpty( size_t index ) const
+    {
+        return m_Slots[index].first == emptyKey();
+    }
+
+    size_t mask() const
+    {
+        return m_Slots.size() - 1;
+    }
+
+    size_t hash( K key ) const
+    {
+        // Fibonacci hashing: the multiply mixes the low bits of the pointer,
+        // which are usually zero due to alignment, into the high bits, which
+        // are used as the index.
+        const uint64_t  h =
+            (uint64_t)reinterpret_cast<uintptr_t>( key ) * 0x9E3779B97F4A7C15ULL;
+        return (size_t)( h >> m_Shift );
+    }
+
+    size_t findIndex( K key ) const
+    {
+        if( m_Size != 0 )
+        {
+            for( size_t i = hash( key ); ; i = ( i + 1 ) & mask() )
+            {
+                if( m_Slots[i].first == key )
+                {
+                    return i;
+                }
+                if( isEmpty( i ) )
+                {
+                    break;
+                }
+            }
+        }
+        return m_Slots.size();
+    }
+
+    // Returns the first empty slot in the probe sequence for this key.
+    size_t insertIndex( K key ) const
+    {
+        size_t  i = hash( key );
+        while( !isEmpty( i ) )
+        {
+            i = ( i + 1 ) & mask();
+        }
+        return i;
+    }
+
+    void eraseIndex( size_t hole )
+    {
+        // Backward shift deletion: move any following entries whose home
+        // slot is at or before the hole into the hole, until an empty slot
+        // is found.
+        size_t  i = hole;
+        for( ;; )
+        {
+            i = ( i + 1 ) & mask();
+            if( isEmpty( i ) )
+            {
+                break;
+            }
+
+            const size_t    home = hash( m_Slots[i].first );
+            if( ( ( i - home ) & mask() ) >= ( ( i - hole ) & mask() ) )
+            {
+                m_Slots[hole] = std::move( m_Slots[i] );
+                hole = i;
+            }
+        }
+
+        m_Slots[hole].first = emptyKey();
+        m_Slots[hole].second = V();
+        m_Size--;
+    }
+
+    void rehash( size_t numSlots )
+    {
+        std::vector<value_type> oldSlots( numSlots, value_type( emptyKey(), V() ) );
+        oldSlots.swap( m_Slots );
+
+        m_Shift = 64;
+        for( size_t n = numSlots; n > 1; n >>= 1 )
+        {
+            m_Shift--;
+        }
+
+        for( auto& slot : oldSlots )
+        {
+            if( slot.first != emptyKey() )
+            {
+                const size_t    index = insertIndex( slot.first );
+                m_Slots[index] = std::move( slot );
+            }
+        }
+    }
+};
@@ -0,0 +1,206 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+// This is a growable first-in, first-out ring buffer.  Elements are stored
+// in a single power-of-two sized array that is reused as elements are added
+// and removed, so adding an element does not allocate memory unless the
+// ring is full.  This class is not thread safe.
+template<class T>
+class CRingBuffer
+{
+public:
+    CRingBuffer() :
+        m_Head( 0 ),
+        m_Size( 0 ) {}
+
+    bool    empty() const
+    {
+        return m_Size == 0;
+    }
+
+    size_t  size() const
+    {
+        return m_Size;
+    }
+
+    T&  front()
+    {
+        return m_Storage[ m_Head ];
+    }
+
+    void    push_back( const T& value )
+    {
+        if( m_Size == m_Storage.size() )
+        {
+            grow();
+        }
+        m_Storage[ index( m_Size ) ] = value;
+        m_Size++;
+    }
+
+    void    pop_front()
+    {
+        m_Head = index( 1 );
+        m_Size--;
+    }
+
+    // Removes the elements for which the predicate returns true, keeping
+    // the remaining elements in order.
+    template<class Pred>
+    void    remove_if( Pred pred )
+    {
+        size_t  kept = 0;
+        for( size_t i = 0; i < m_Size; i++ )
+        {
+            T&  value = m_Storage[ index( i ) ];
+            if( !pred( value ) )
+            {
+                if( kept != i )
+                {
+                    m_Storage[ index( kept ) ] = value;
+                }
+                kept++;
+            }
+        }
+        m_Size = kept;
+    }
+
+private:
+    std::vector<T>  m_Storage;
+    size_t  m_Head;
+    size_t  m_Size;
+
+    size_t  index( size_t offset ) const
+    {
+        return ( m_Head + offset ) & ( m_Storage.size() - 1 );
+    }
+
+    void    grow()
+    {
+        std::vector<T>  storage( m_Storage.empty() ? 16 : m_Storage.size() * 2 );
+        for( size_t i = 0; i < m_Size; i++ )
+        {
+            storage[i] = m_Storage[ index( i ) ];
+        }
+        m_Storage.swap( storage );
+        m_Head = 0;
+    }
+};
+
+// This is a single-producer, single-consumer ring buffer.  One thread may
+// add elements while one other thread removes them, and neither thread takes
+// a lock.  The capacity is rounded up to a power of two.  Adding an element
+// to a full ring fails rather than blocking or growing, so the producer
+// decides how to wait for the consumer, or when to grow the ring.
+template<class T>
+class CSPSCRingBuffer
+{
+public:
+    explicit CSPSCRingBuffer( size_t capacity ) :
+        m_Storage( roundUpToPowerOfTwo( capacity ) ),
+        m_Head( 0 ),
+        m_Tail( 0 ) {}
+
+    CSPSCRingBuffer( const CSPSCRingBuffer& ) = delete;
+    CSPSCRingBuffer& operator=( const CSPSCRingBuffer& ) = delete;
+
+    size_t  capacity() const
+    {
+        return m_Storage.size();
+    }
+
+    // This is exact when called by the producer or by the consumer while
+    // the other thread is idle, and is otherwise a snapshot.
+    size_t  size() const
+    {
+        return m_Tail.load( std::memory_order_acquire ) -
+            m_Head.load( std::memory_order_acquire );
+    }
+
+    // Called by the producer.
+    bool    push_back( const T& value )
+    {
+        const size_t    tail = m_Tail.load( std::memory_order_relaxed );
+        if( tail - m_Head.load( std::memory_order_acquire ) == m_Storage.size() )
+        {
+            return false;
+        }
+        m_Storage[ tail & ( m_Storage.size() - 1 ) ] = value;
+        m_Tail.store( tail + 1, std::memory_order_release );
+        return true;
+    }
+
+    // Called by the consumer.  Calls the function for each element in the
+    // ring, oldest first, up to the maximum number of elements, then removes
+    // the elements.  Returns the number of elements that were removed.
+    template<class Func>
+    size_t  consume( Func func, size_t maxCount = SIZE_MAX )
+    {
+        const size_t    head = m_Head.load( std::memory_order_relaxed );
+        size_t          tail = m_Tail.load( std::memory_order_acquire );
+        if( tail - head > maxCount )
+        {
+            tail = head + maxCount;
+        }
+        for( size_t i = head; i != tail; i++ )
+        {
+            func( m_Storage[ i & ( m_Storage.size() - 1 ) ] );
+        }
+        m_Head.store( tail, std::memory_order_release );
+        return tail - head;
+    }
+
+    // Grows the ring, keeping its elements.  This may only be called by the
+    // producer while the consumer is excluded, for example by a lock.
+    void    grow( size_t capacity )
+    {
+        const size_t    head = m_Head.load( std::memory_order_acquire );
+        const size_t    tail = m_Tail.load( std::memory_order_relaxed );
+
+        std::vector<T>  storage( roundUpToPowerOfTwo( capacity ) );
+        if( storage.size() < tail - head )
+        {
+            return;
+        }
+        for( size_t i = head; i != tail; i++ )
+        {
+            storage[ i - head ] = m_Storage[ i & ( m_Storage.size() - 1 ) ];
+        }
+        m_Storage.swap( storage );
+        m_Head.store( 0, std::memory_order_relaxed );
+        m_Tail.store( tail - head, std::memory_order_release );
+    }
+
+private:
+    static const size_t cCacheLineSize = 64;
+
+    std::vector<T>  m_Storage;
+
+    // The head is written by the consumer and the tail is written by the
+    // producer, so they are kept on separate cache lines.
+    char    m_Padding0[ cCacheLineSize ];
+    std::atomic<size_t> m_Head;
+    char    m_Padding1[ cCacheLineSize - sizeof(std::atomic<size_t>) ];
+    std::atomic<size_t> m_Tail;
+
+    static size_t   roundUpToPowerOfTwo( size_t value )
+    {
+        size_t  result = 1;
+        while( result < value )
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+};
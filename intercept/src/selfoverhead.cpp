@@ -0,0 +1,138 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#include <iomanip>
+#include <ostream>
+
+#include "selfoverhead.h"
+
+CSelfOverhead::CSelfOverhead()
+{
+    for( auto& s : m_Stages )
+    {
+        s.Count.store( 0, std::memory_order_relaxed );
+        s.TotalTicks.store( 0, std::memory_order_relaxed );
+        for( auto& bucket : s.Buckets )
+        {
+            bucket.store( 0, std::memory_order_relaxed );
+        }
+    }
+    for( auto& ticks : m_SampleTicks )
+    {
+        ticks = 0;
+    }
+
+    m_StartTicks = timestamp();
+    m_StartTime = std::chrono::steady_clock::now();
+}
+
+const char* CSelfOverhead::stageName( EStage stage )
+{
+    switch( stage )
+    {
+#define CLI_SELF_OVERHEAD_STAGE_NAME( _name )   case cStage_##_name: return #_name;
+        CLI_SELF_OVERHEAD_STAGE_LIST( CLI_SELF_OVERHEAD_STAGE_NAME )
+#undef CLI_SELF_OVERHEAD_STAGE_NAME
+    default:
+        break;
+    }
+    return "Unknown";
+}
+
+double CSelfOverhead::nsPerTick() const
+{
+#if defined(CLI_SELF_OVERHEAD_USE_TSC)
+    // Calibrate the time stamp counter against the steady clock over the
+    // lifetime of the profiler.  Until enough time has elapsed for the
+    // calibration to be meaningful, assume one tick per nanosecond.
+    const uint64_t  ticks = timestamp() - m_StartTicks;
+    const uint64_t  ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_StartTime ).count();
+    if( ticks != 0 && ns >= 1000000 )
+    {
+        return (double)ns / ticks;
+    }
+#endif
+    return 1.0;
+}
+
+void CSelfOverhead::sampleIntervalNS( uint64_t intervalNS[cNumStages] )
+{
+    const double    scale = nsPerTick();
+
+    std::lock_guard<std::mutex> lock(m_SampleMutex);
+    for( uint32_t stage = 0; stage < cNumStages; stage++ )
+    {
+        const uint64_t  ticks =
+            m_Stages[stage].TotalTicks.load( std::memory_order_relaxed );
+        intervalNS[stage] = (uint64_t)( ( ticks - m_SampleTicks[stage] ) * scale );
+        m_SampleTicks[stage] = ticks;
+    }
+}
+
+void CSelfOverhead::writeReport( std::ostream& os )
+{
+    const double    scale = nsPerTick();
+
+    uint64_t    totalTotalNS = 0;
+    for( const auto& s : m_Stages )
+    {
+        totalTotalNS += (uint64_t)( s.TotalTicks.load( std::memory_order_relaxed ) * scale );
+    }
+
+#if defined(CLI_SELF_OVERHEAD_USE_TSC)
+    os << std::endl << "Timestamp Source: Time Stamp Counter ("
+        << std::fixed << std::setprecision(3) << 1.0 / scale << " ticks/ns)" << std::endl;
+#else
+    os << std::endl << "Timestamp Source: Steady Clock" << std::endl;
+#endif
+    os << std::endl << "Total Time (ns): " << totalTotalNS << std::endl;
+
+    os << std::endl
+        << std::right << std::setw(26) << "Stage" << ", "
+        << std::right << std::setw(10) << "Calls" << ", "
+        << std::right << std::setw(13) << "Time (ns)" << ", "
+        << std::right << std::setw( 8) << "Time (%)" << ", "
+        << std::right << std::setw(13) << "Average (ns)" << ", "
+        << std::right << std::setw(13) << "p99 (ns)" << std::endl;
+
+    for( uint32_t stage = 0; stage < cNumStages; stage++ )
+    {
+        const SStage&   s = m_Stages[stage];
+
+        const uint64_t  count = s.Count.load( std::memory_order_relaxed );
+        if( count == 0 )
+        {
+            continue;
+        }
+
+        const uint64_t  totalNS =
+            (uint64_t)( s.TotalTicks.load( std::memory_order_relaxed ) * scale );
+
+        // The stages are updated without a lock, so the bucket counts may
+        // not add up to the total count exactly.
+        const uint64_t  target = count - count / 100;
+        uint64_t    seen = 0;
+        uint32_t    index = 0;
+        for( ; index < cNumBuckets - 1; index++ )
+        {
+            seen += s.Buckets[index].load( std::memory_order_relaxed );
+            if( seen >= target )
+            {
+                break;
+            }
+        }
+        const uint64_t  p99NS = (uint64_t)( CBucketLayout::bucketUpperBound( index ) * scale );
+
+        os << std::right << std::setw(26) << stageName( (EStage)stage ) << ", "
+            << std::right << std::setw(10) << count << ", "
+            << std::right << std::setw(13) << totalNS << ", "
+            << std::right << std::setw( 7) << std::fixed << std::setprecision(2)
+                << ( totalTotalNS ? totalNS * 100.0 / totalTotalNS : 0.0 ) << "%, "
+            << std::right << std::setw(13) << totalNS / count << ", "
+            << std::right << std::setw(13) << p99NS << std::endl;
+    }
+}
@@ -0,0 +1,157 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+
+#include <stdint.h>
+
+#include "histogram.h"
+
+#if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+#include <intrin.h>
+#define CLI_SELF_OVERHEAD_USE_TSC
+#elif ( defined(__GNUC__) || defined(__clang__) ) && ( defined(__x86_64__) || defined(__i386__) )
+#include <x86intrin.h>
+#define CLI_SELF_OVERHEAD_USE_TSC
+#endif
+
+// The instrumentation stages that are attributed separately when
+// SelfOverheadProfiling is enabled.  Most stages correspond to one
+// instrumentation macro, or to one family of similar macros.
+#define CLI_SELF_OVERHEAD_STAGE_LIST( X )   \
+    X( CallLoggingEnter )                   \
+    X( CallLoggingExit )                    \
+    X( ChromeCallLogging )                  \
+    X( ErrorChecking )                      \
+    X( ObjectTracking )                     \
+    X( EventChecking )                      \
+    X( EventTracking )                      \
+    X( SetKernelArg )                       \
+    X( DumpArgumentsOnSet )                 \
+    X( GetTimingTags )                      \
+    X( GetTimingTagsKernel )                \
+    X( HostTiming )                         \
+    X( AddTimingEvent )                     \
+    X( CheckTimingEvents )                  \
+    X( DumpBuffersBeforeEnqueue )           \
+    X( DumpBuffersAfterEnqueue )            \
+    X( DumpImagesBeforeEnqueue )            \
+    X( DumpImagesAfterEnqueue )             \
+    X( FinishOrFlushAfterEnqueue )          \
+    X( ChromeTraceFlush )
+
+// This class attributes the cost of the Intercept Layer's own
+// instrumentation to each instrumentation stage.  Each stage counts the
+// number of times it ran, the total time it took, and a log-linear histogram
+// of the time each run took, so a percentile can be estimated without
+// storing every sample.  Times are measured with the cheapest timestamp
+// available, which is the time stamp counter on x86, and are converted to
+// nanoseconds only when they are reported.
+class CSelfOverhead
+{
+public:
+    enum EStage
+    {
+#define CLI_SELF_OVERHEAD_STAGE_ENUM( _name )   cStage_##_name,
+        CLI_SELF_OVERHEAD_STAGE_LIST( CLI_SELF_OVERHEAD_STAGE_ENUM )
+#undef CLI_SELF_OVERHEAD_STAGE_ENUM
+        cNumStages
+    };
+
+    CSelfOverhead();
+
+    CSelfOverhead( const CSelfOverhead& ) = delete;
+    CSelfOverhead& operator=( const CSelfOverhead& ) = delete;
+
+    static const char*  stageName( EStage stage );
+
+    static uint64_t timestamp()
+    {
+#if defined(CLI_SELF_OVERHEAD_USE_TSC)
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch() ).count();
+#endif
+    }
+
+    void    record( EStage stage, uint64_t ticks )
+    {
+        SStage& s = m_Stages[stage];
+        s.Count.fetch_add( 1, std::memory_order_relaxed );
+        s.TotalTicks.fetch_add( ticks, std::memory_order_relaxed );
+        s.Buckets[ CBucketLayout::bucketIndex(ticks) ].fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    // Gets the time spent in each stage since the previous call, in
+    // nanoseconds.
+    void    sampleIntervalNS( uint64_t intervalNS[cNumStages] );
+
+    void    writeReport( std::ostream& os );
+
+private:
+    // Each power of two is split into four linear buckets, so an estimated
+    // percentile is within 25% of the actual value.  The buckets are atomic
+    // so stages can be recorded without a lock, hence only the bucket layout
+    // is shared with CLogLinearHistogram.
+    typedef CLogLinearHistogram< 2, 64 >    CBucketLayout;
+    static const uint32_t   cNumBuckets = CBucketLayout::cNumBuckets;
+
+    struct SStage
+    {
+        std::atomic<uint64_t>   Count;
+        std::atomic<uint64_t>   TotalTicks;
+        std::atomic<uint64_t>   Buckets[cNumBuckets];
+    };
+
+    SStage  m_Stages[cNumStages];
+
+    // Used to convert timestamps to nanoseconds.
+    uint64_t    m_StartTicks;
+    std::chrono::steady_clock::time_point   m_StartTime;
+
+    std::mutex  m_SampleMutex;
+    uint64_t    m_SampleTicks[cNumStages];
+
+    double  nsPerTick() const;
+};
+
+// Records the time from construction to destruction for a stage.  This does
+// nothing if the self overhead profiler is NULL, so the profiler costs only
+// a branch when it is disabled.
+class CSelfOverheadScope
+{
+public:
+    CSelfOverheadScope(
+        CSelfOverhead* pSelfOverhead,
+        CSelfOverhead::EStage stage ) :
+        m_pSelfOverhead( pSelfOverhead ),
+        m_Stage( stage ),
+        m_StartTicks( pSelfOverhead ? CSelfOverhead::timestamp() : 0 ) {}
+
+    ~CSelfOverheadScope()
+    {
+        if( m_pSelfOverhead )
+        {
+            m_pSelfOverhead->record(
+                m_Stage,
+                CSelfOverhead::timestamp() - m_StartTicks );
+        }
+    }
+
+    CSelfOverheadScope( const CSelfOverheadScope& ) = delete;
+    CSelfOverheadScope& operator=( const CSelfOverheadScope& ) = delete;
+
+private:
+    CSelfOverhead*          m_pSelfOverhead;
+    CSelfOverhead::EStage   m_Stage;
+    uint64_t                m_StartTicks;
+};
@@ -0,0 +1,124 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#include "stringinterner.h"
+
+CStringInterner::CStringInterner()
+{
+    for( uint32_t c = 0; c < cMaxChunks; c++ )
+    {
+        m_Chunks[c].store( NULL, std::memory_order_relaxed );
+    }
+    m_Count.store( 0, std::memory_order_relaxed );
+
+    m_Table.store( createTable( cInitialTableSize ), std::memory_order_release );
+
+    intern( "", 0 );
+}
+
+CStringInterner::~CStringInterner()
+{
+    for( auto pTable : m_Tables )
+    {
+        delete [] pTable->Slots;
+        delete pTable;
+    }
+
+    for( uint32_t c = 0; c < cMaxChunks; c++ )
+    {
+        delete [] m_Chunks[c].load( std::memory_order_relaxed );
+    }
+}
+
+CStringInterner::STable* CStringInterner::createTable(
+    uint32_t size )
+{
+    STable* pTable = new STable;
+    pTable->Mask = size - 1;
+    pTable->Slots = new std::atomic<uint64_t>[ size ];
+    for( uint32_t i = 0; i < size; i++ )
+    {
+        pTable->Slots[i].store( 0, std::memory_order_relaxed );
+    }
+
+    m_Tables.push_back( pTable );
+    return pTable;
+}
+
+// This function assumes that the interner mutex is held.
+void CStringInterner::insert(
+    STable* pTable,
+    Id id,
+    uint32_t h )
+{
+    uint32_t    i = h & pTable->Mask;
+    while( pTable->Slots[i].load( std::memory_order_relaxed ) != 0 )
+    {
+        i = ( i + 1 ) & pTable->Mask;
+    }
+
+    const uint64_t  slot = ( (uint64_t)h << 32 ) | ( id + 1 );
+    pTable->Slots[i].store( slot, std::memory_order_release );
+}
+
+CStringInterner::Id CStringInterner::add(
+    const char* str,
+    size_t length,
+    uint32_t h )
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // Check again, since another thread may have added this string after
+    // the lock-free lookup, or the table may have grown.
+    STable* pTable = m_Table.load( std::memory_order_relaxed );
+
+    Id  id = cEmptyId;
+    if( find( pTable, str, length, h, id ) )
+    {
+        return id;
+    }
+
+    id = m_Count.load( std::memory_order_relaxed );
+
+    const uint32_t  chunk = id / cChunkSize;
+    if( chunk >= cMaxChunks )
+    {
+        // Out of IDs.  This should never happen in practice, but if it
+        // does, all subsequent new strings will resolve to the empty
+        // string.
+        return cEmptyId;
+    }
+
+    std::string*    pChunk = m_Chunks[chunk].load( std::memory_order_relaxed );
+    if( pChunk == NULL )
+    {
+        pChunk = new std::string[ cChunkSize ];
+        m_Chunks[chunk].store( pChunk, std::memory_order_release );
+    }
+
+    pChunk[ id % cChunkSize ].assign( str, length );
+    m_Count.store( id + 1, std::memory_order_release );
+
+    const uint32_t  tableSize = pTable->Mask + 1;
+    if( ( id + 1 ) * 2 > tableSize )
+    {
+        // Build the new table completely before publishing it, so lock-free
+        // readers always see either the old table or a complete new table.
+        STable* pNewTable = createTable( tableSize * 2 );
+        for( Id i = 0; i <= id; i++ )
+        {
+            const std::string&  s = name( i );
+            insert( pNewTable, i, hash( s.c_str(), s.length() ) );
+        }
+        m_Table.store( pNewTable, std::memory_order_release );
+    }
+    else
+    {
+        insert( pTable, id, h );
+    }
+
+    return id;
+}
@@ -0,0 +1,156 @@
+/*
+// Copyright (c) 2026 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+#include <string.h>
+
+// This class maps strings to small integer IDs that are stable for the
+// lifetime of the process.  Looking up the ID for a string that has already
+// been interned, and looking up the string for an ID, do not take a lock, so
+// IDs may be stored in hot data structures in place of strings and resolved
+// to text only when a report or trace is written.  Interned strings are
+// never removed.
+class CStringInterner
+{
+public:
+    typedef uint32_t    Id;
+
+    // The empty string is always interned and always has this ID.
+    static const Id cEmptyId = 0;
+
+    CStringInterner();
+    ~CStringInterner();
+
+    CStringInterner( const CStringInterner& ) = delete;
+    CStringInterner& operator=( const CStringInterner& ) = delete;
+
+    Id  intern( const char* str, size_t length );
+    Id  intern( const char* str )
+    {
+        return intern( str, strlen(str) );
+    }
+    Id  intern( const std::string& str )
+    {
+        return intern( str.c_str(), str.length() );
+    }
+
+    const std::string& name( Id id ) const
+    {
+        const std::string* pChunk =
+            m_Chunks[ id / cChunkSize ].load( std::memory_order_acquire );
+        return pChunk[ id % cChunkSize ];
+    }
+
+    uint32_t size() const
+    {
+        return m_Count.load( std::memory_order_acquire );
+    }
+
+private:
+    static const uint32_t   cChunkSize = 4096;
+    static const uint32_t   cMaxChunks = 4096;
+    static const uint32_t   cInitialTableSize = 1024;
+
+    // The lookup table uses open addressing with linear probing.  Each slot
+    // holds the 32-bit hash of the string in the upper bits and the ID plus
+    // one in the lower bits, so an empty slot is zero.  The table is never
+    // more than half full.  When it grows, the old table is kept until the
+    // interner is destroyed, since a lock-free reader may still be using it.
+    struct STable
+    {
+        uint32_t                Mask;
+        std::atomic<uint64_t>*  Slots;
+    };
+
+    std::mutex  m_Mutex;
+
+    std::atomic<STable*>    m_Table;
+    std::vector<STable*>    m_Tables;
+
+    // Strings are stored in fixed-size chunks so that they never move once
+    // they are interned.
+    std::atomic<std::string*>   m_Chunks[cMaxChunks];
+    std::atomic<uint32_t>       m_Count;
+
+    static uint32_t hash( const char* str, size_t length )
+    {
+        // 32-bit FNV-1a.
+        uint32_t    h = 2166136261U;
+        for( size_t i = 0; i < length; i++ )
+        {
+            h ^= (uint8_t)str[i];
+            h *= 16777619U;
+        }
+        return h;
+    }
+
+    bool    find(
+                const STable* pTable,
+                const char* str,
+                size_t length,
+                uint32_t h,
+                Id& id ) const;
+    void    insert(
+                STable* pTable,
+                Id id,
+                uint32_t h );
+    STable* createTable(
+                uint32_t size );
+    Id      add(
+                const char* str,
+                size_t length,
+                uint32_t h );
+};
+
+inline bool CStringInterner::find(
+    const STable* pTable,
+    const char* str,
+    size_t length,
+    uint32_t h,
+    Id& id ) const
+{
+    for( uint32_t i = h & pTable->Mask; ; i = ( i + 1 ) & pTable->Mask )
+    {
+        const uint64_t  slot = pTable->Slots[i].load( std::memory_order_acquire );
+        if( slot == 0 )
+        {
+            return false;
+        }
+        if( (uint32_t)( slot >> 32 ) == h )
+        {
+            const Id    candidate = (Id)( slot & 0xFFFFFFFF ) - 1;
+            const std::string&  s = name( candidate );
+            if( s.length() == length &&
+                memcmp( s.data(), str, length ) == 0 )
+            {
+                id = candidate;
+                return true;
+            }
+        }
+    }
+}
+
+inline CStringInterner::Id CStringInterner::intern(
+    const char* str,
+    size_t length )
+{
+    const uint32_t  h = hash( str, length );
+
+    Id  id = cEmptyId;
+    if( find( m_Table.load( std::memory_order_acquire ), str, length, h, id ) )
+    {
+        return id;
+    }
+
+    return add( str, length, h );
+}